@@ -17,6 +17,8 @@ import numpy
 import math
 import os
 import pandas
+import re
+import scipy.stats
 import sys
 import yamale
 import yaml
@@ -27,6 +29,15 @@ YML_SCHEMA: str = os.path.join('benchmark', '_schema.yml')
 BENCHMARK_SYSTEMS: list[str] = ['mutable', 'PostgreSQL', 'DuckDB', 'HyPer'
 ]     # List of systems
 
+REGRESSION_PHASES: dict[str, str] = {                                           # Phases measured by `--phases`
+    'Compile': '^Compile SQL to machine code:.*',
+    'Execute machine code': '^Execute machine code:.*',
+}
+
+PERF_COUNTERS: list[str] = [                                                    # Counters recorded by `--perf-counters`
+    'cycles', 'instructions', 'LLC misses', 'branch misses', 'dTLB misses'
+]
+
 
 class BenchmarkError(Exception):
     pass
@@ -253,19 +264,70 @@ BEGIN
 
 
 #=======================================================================================================================
-# Perform the experiment specified in `yml` and `info` on the connector `conn` and add the measurements to `results`
+# Collect the experiment files in the given paths, or all experiment files if no path is given
 #=======================================================================================================================
 @typechecked
-def perform_experiment(
+def get_benchmark_files(paths: list[str]) -> list[str]:
+    benchmark_files: list[str]
+    if not paths:
+        benchmark_files = sorted(glob.glob(os.path.join('benchmark', '**', '[!_]*.yml'), recursive=True))
+    else:
+        benchmark_files = []
+        for path in sorted(set(paths)):
+            if os.path.isfile(path):  # path is an experiment file
+                benchmark_files.append(path)
+            else:  # path is a directory containing multiple experiment files
+                benchmark_files.extend(glob.glob(os.path.join(path, '**', '[!_]*.yml'), recursive=True))
+
+    return sorted(list(set(benchmark_files)))
+
+
+#=======================================================================================================================
+# Get information about the experiment in `path_to_file` or `None` if a table file of the experiment is missing
+#=======================================================================================================================
+@typechecked
+def get_experiment_info(
+    path_to_file: str,
     yml: dict[str, Any],
-    conn: connector.Connector,
-    system: str,
-    info: SimpleNamespace,
-    results: Result,
-    output_csv_file: str | None,
-    num_runs: int
-) -> None:
-    # Experiment parameters
+    date: str,
+    commit: git.objects.commit.Commit
+) -> SimpleNamespace | None:
+    info: SimpleNamespace = SimpleNamespace()
+    info.path_to_file = path_to_file
+    info.date = date
+    info.commit = commit
+    info.version = yml.get('version', 1)
+    info.suite_name = yml.get('suite')
+    info.benchmark_name = yml.get('benchmark')
+    info.experiment_name = yml.get('name', path_to_file)
+
+    # Count the lines in each table file and add it to the table entry
+    info.experiment_data = yml.get('data')
+    if info.experiment_data:
+        table_access_error: bool = False
+        for table_name, table in info.experiment_data.items():
+            if 'file' not in table:
+                continue  # Skip counting files when table does not have a file with data
+            p: str = os.path.join(table['file'])  # Path to file
+            if not os.path.isfile(p):
+                tqdm_print(f'Table file \'{p}\' not found.  Skipping benchmark.\n')
+                table_access_error = True
+            else:
+                if 'lines_in_file' in yml:  # use `if` for lazy evaluation
+                    info.experiment_data[table_name]['lines_in_file'] = yml['lines_in_file']
+                else:
+                    info.experiment_data[table_name]['lines_in_file'] = int(os.popen(f"wc -l < {p}").read())
+        if table_access_error:
+            return None
+
+    return info
+
+
+#=======================================================================================================================
+# Get the parameters passed to the connector of `system` to perform the experiment specified in `yml` and `info`
+#=======================================================================================================================
+@typechecked
+def get_experiment_params(yml: dict[str, Any], system: str, info: SimpleNamespace) -> dict[str, Any]:
     systems: dict[str, Any] = yml.get('systems', dict())
     params: dict[str, Any] = dict(systems[system])
     params['description']  = yml.get('description')
@@ -276,6 +338,48 @@ def perform_experiment(
     params['chart']        = yml.get('chart')
     params['data']         = info.experiment_data
     params['path_to_file'] = info.path_to_file
+    return params
+
+
+#=======================================================================================================================
+# Make mutable record hardware performance counters and measure them alongside the timings
+#
+# For every pattern of the form `^<name>:.*`, adds one pattern `^<name> [<counter>]:.*` per counter, labelled
+# `<label> [<counter>]`.  Other patterns are left as is.
+#=======================================================================================================================
+@typechecked
+def add_perf_counter_patterns(params: dict[str, Any]) -> None:
+    params['binargs'] = ' '.join(filter(None, [params.get('binargs'), '--perf-counters']))
+    for config_name, config in params['configurations'].items():
+        pattern: str | dict[str, str] = config['pattern']
+        patterns: dict[str, str] = { 'Execution Time': pattern } if isinstance(pattern, str) else dict(pattern)
+        for label, regex in list(patterns.items()):
+            match: re.Match | None = re.fullmatch(r'\^(.*):\.\*', regex)
+            if match is None:
+                continue
+            for counter in PERF_COUNTERS:
+                patterns[f'{label} [{counter}]'] = f'^{match.group(1)} \\[{re.escape(counter)}\\]:.*'
+        params['configurations'][config_name] = dict(config, pattern=patterns)
+
+
+#=======================================================================================================================
+# Perform the experiment specified in `yml` and `info` on the connector `conn` and add the measurements to `results`
+#=======================================================================================================================
+@typechecked
+def perform_experiment(
+    yml: dict[str, Any],
+    conn: connector.Connector,
+    system: str,
+    info: SimpleNamespace,
+    results: Result,
+    output_csv_file: str | None,
+    num_runs: int,
+    perf_counters: bool = False
+) -> None:
+    # Experiment parameters
+    params: dict[str, Any] = get_experiment_params(yml, system, info)
+    if perf_counters and system == 'mutable':
+        add_perf_counter_patterns(params)
 
     # Perform benchmark
     try:
@@ -324,18 +428,7 @@ def run_benchmarks(args: argparse.Namespace) -> None:
     is_interactive: bool = True if os.environ.get('TERM', False) else False
 
     # Get benchmark files
-    benchmark_files: list[str]
-    if not args.path:
-        benchmark_files = sorted(glob.glob(os.path.join('benchmark', '**', '[!_]*.yml'), recursive=True))
-    else:
-        benchmark_files = []
-        for path in sorted(set(args.path)):
-            if os.path.isfile(path):  # path is an experiment file
-                benchmark_files.append(path)
-            else:  # path is a directory containing multiple experiment files
-                benchmark_files.extend(glob.glob(os.path.join(path, '**', '[!_]*.yml'), recursive=True))
-
-    benchmark_files: list[str] = sorted(list(set(benchmark_files)))
+    benchmark_files: list[str] = get_benchmark_files(args.path)
 
     # Set up counters
     num_experiments_total: int = 0
@@ -396,33 +489,9 @@ def run_benchmarks(args: argparse.Namespace) -> None:
             yml: dict[str, Any] = yaml.safe_load(yml_file)
 
             # Get information about experiment
-            info: SimpleNamespace = SimpleNamespace()
-            info.path_to_file = path_to_file
-            info.date = date
-            info.commit = commit
-            info.version = yml.get('version', 1)
-            info.suite_name = yml.get('suite')
-            info.benchmark_name = yml.get('benchmark')
-            info.experiment_name = yml.get('name', path_to_file)
-
-            # Count the lines in each table file and add it to the table entry
-            info.experiment_data = yml.get('data')
-            if info.experiment_data:
-                table_access_error: bool = False
-                for table_name, table in info.experiment_data.items():
-                    if 'file' not in table:
-                        continue  # Skip counting files when table does not have a file with data
-                    p: str = os.path.join(table['file'])  # Path to file
-                    if not os.path.isfile(p):
-                        tqdm_print(f'Table file \'{p}\' not found.  Skipping benchmark.\n')
-                        table_access_error = True
-                    else:
-                        if 'lines_in_file' in yml:  # use `if` for lazy evaluation
-                            info.experiment_data[table_name]['lines_in_file'] = yml['lines_in_file']
-                        else:
-                            info.experiment_data[table_name]['lines_in_file'] = int(os.popen(f"wc -l < {p}").read())
-                if table_access_error:
-                    continue  # At least one table file could not be opened.  Skip benchmark.
+            info: SimpleNamespace | None = get_experiment_info(path_to_file, yml, date, commit)
+            if info is None:
+                continue  # At least one table file could not be opened.  Skip benchmark.
 
             tqdm_print('\n\n==========================================================')
             tqdm_print(f'Perform benchmarks in \'{path_to_file}\'.')
@@ -470,7 +539,8 @@ def run_benchmarks(args: argparse.Namespace) -> None:
                     if system == 'mutable':
                         num_experiments_total += 1
                     try:
-                        perform_experiment(yml, conn, system, info, results, output_csv_file, args.num_runs)
+                        perform_experiment(yml, conn, system, info, results, output_csv_file, args.num_runs,
+                                           args.perf_counters)
                     except BenchmarkError:
                         pass  # nothing to be done
                     else:
@@ -490,6 +560,153 @@ def run_benchmarks(args: argparse.Namespace) -> None:
     exit(num_experiments_passed != num_experiments_total)
 
 
+#=======================================================================================================================
+# Statistically compare the measurements of a baseline and a candidate of a single case
+#
+# Uses a two-sided Mann-Whitney U test to decide whether the measurements differ and a bootstrap confidence interval
+# of the ratio of the medians (candidate / baseline) to quantify the difference.  A case is a regression (improvement)
+# iff the test is significant at level `alpha` and the entire confidence interval lies above (below) the ratio
+# 1 + `threshold` (1 - `threshold`).
+#=======================================================================================================================
+@typechecked
+def compare_measurements(
+    baseline: list[float],
+    candidate: list[float],
+    alpha: float,
+    threshold: float,
+    num_resamples: int = 10000,
+    seed: int = 42
+) -> SimpleNamespace:
+    b: numpy.ndarray = numpy.asarray(baseline, dtype=float)
+    c: numpy.ndarray = numpy.asarray(candidate, dtype=float)
+    eps: float = 1e-9  # avoid division by zero for vanishing durations
+
+    comparison: SimpleNamespace = SimpleNamespace()
+    comparison.median_baseline = float(numpy.median(b))
+    comparison.median_candidate = float(numpy.median(c))
+    comparison.ratio = (comparison.median_candidate + eps) / (comparison.median_baseline + eps)
+
+    # Mann-Whitney U test; identical samples yield NaN
+    p_value: float = float(scipy.stats.mannwhitneyu(c, b, alternative='two-sided').pvalue)
+    comparison.p_value = 1. if math.isnan(p_value) else p_value
+
+    # Percentile bootstrap of the ratio of medians, resampling both samples independently
+    rng: numpy.random.Generator = numpy.random.default_rng(seed)
+    resampled_b: numpy.ndarray = numpy.median(b[rng.integers(0, len(b), (num_resamples, len(b)))], axis=1)
+    resampled_c: numpy.ndarray = numpy.median(c[rng.integers(0, len(c), (num_resamples, len(c)))], axis=1)
+    ratios: numpy.ndarray = (resampled_c + eps) / (resampled_b + eps)
+    comparison.ci_low, comparison.ci_high = (float(q) for q in numpy.quantile(ratios, [alpha / 2, 1 - alpha / 2]))
+
+    significant: bool = comparison.p_value < alpha
+    if significant and comparison.ci_low > 1 + threshold:
+        comparison.verdict = 'regression'
+    elif significant and comparison.ci_high < 1 - threshold:
+        comparison.verdict = 'improvement'
+    else:
+        comparison.verdict = 'unchanged'
+    return comparison
+
+
+#=======================================================================================================================
+# Runs all mutable experiments on a baseline and a candidate build and reports regressions of the candidate
+#=======================================================================================================================
+@typechecked
+def run_regression_check(args: argparse.Namespace) -> None:
+    benchmark_files: list[str] = get_benchmark_files(args.path)
+    date: str = datetime.date.today().isoformat()
+    repo = Repo('.')
+    commit: git.objects.commit.Commit = repo.head.commit
+    repo.__del__()
+
+    builds: dict[str, connector.Connector] = {
+        'baseline':  mutable.Mutable(dict(path_to_binary=os.path.join(args.baseline, 'bin', 'shell'),
+                                          verbose=args.verbose)),
+        'candidate': mutable.Mutable(dict(path_to_binary=os.path.join(args.builddir, 'bin', 'shell'),
+                                          verbose=args.verbose)),
+    }
+
+    columns: list[str] = ['suite', 'benchmark', 'experiment', 'config', 'phase', 'case', 'median_baseline',
+                          'median_candidate', 'ratio', 'ci_low', 'ci_high', 'p_value', 'verdict']
+    report: list[list[Any]] = list()
+    num_errors: int = 0
+
+    for path_to_file in benchmark_files:
+        if not validate_schema(path_to_file, YML_SCHEMA):
+            continue
+        with open(path_to_file, 'r') as yml_file:
+            yml: dict[str, Any] = yaml.safe_load(yml_file)
+        if 'mutable' not in yml.get('systems', dict()):
+            continue
+        info: SimpleNamespace | None = get_experiment_info(path_to_file, yml, date, commit)
+        if info is None:
+            continue
+
+        params: dict[str, Any] = get_experiment_params(yml, 'mutable', info)
+        if args.phases:
+            params['configurations'] = {
+                name: dict(config, pattern=REGRESSION_PHASES) for name, config in params['configurations'].items()
+            }
+        if args.perf_counters:
+            add_perf_counter_patterns(params)
+
+        tqdm_print(f'Comparing baseline and candidate on \'{path_to_file}\'.')
+
+        # Interleave the runs of baseline and candidate and alternate their order to spread drift, e.g. thermal
+        # throttling or background load, evenly across both builds.  The first `args.warmup` rounds are discarded.
+        samples: dict[tuple[str, str, str], dict[str, list[float]]] = dict()
+        try:
+            for run in range(args.warmup + args.num_runs):
+                order: list[str] = ['baseline', 'candidate'] if run % 2 == 0 else ['candidate', 'baseline']
+                for build in order:
+                    connector_result: ConnectorResult = builds[build].execute(1, params)
+                    if run < args.warmup:
+                        continue
+                    for config_name, config_result in connector_result.items():
+                        for label, measurement_result in config_result.items():
+                            for case, times in measurement_result.items():
+                                entry = samples.setdefault((config_name, label, str(case)),
+                                                           { 'baseline': list(), 'candidate': list() })
+                                entry[build].extend(float(t) for t in times)
+        except connector.ConnectorException as ex:
+            tqdm_print(f'An error occurred while executing {path_to_file}: {str(ex)}\n')
+            num_errors += 1
+            continue
+
+        for (config_name, label, case), entry in samples.items():
+            if not entry['baseline'] or not entry['candidate']:
+                continue
+            cmp: SimpleNamespace = compare_measurements(entry['baseline'], entry['candidate'], args.alpha,
+                                                        args.threshold)
+            report.append([info.suite_name, info.benchmark_name, info.experiment_name, config_name, label, case,
+                           cmp.median_baseline, cmp.median_candidate, cmp.ratio, cmp.ci_low, cmp.ci_high, cmp.p_value,
+                           cmp.verdict])
+
+    df: pandas.DataFrame = pandas.DataFrame(report, columns=columns)
+    if args.output:
+        df.to_csv(args.output, index=False)
+        tqdm_print(f'Writing comparison to \'{args.output}\'.')
+
+    # Print report
+    confidence: int = round((1 - args.alpha) * 100)
+    tqdm_print('\n==========================================================')
+    tqdm_print('Regression report (candidate vs. baseline)')
+    tqdm_print('==========================================================')
+    for row in df.itertuples(index=False):
+        status: str = { 'regression': 'FAIL', 'improvement': 'GOOD', 'unchanged': 'PASS' }[row.verdict]
+        if row.verdict == 'unchanged' and not args.verbose:
+            continue
+        tqdm_print(f'{status}  {row.suite}/{row.benchmark}/{row.experiment} [{row.config}] {row.phase}, case {row.case}: '
+                   f'{row.median_baseline:.3f} ms -> {row.median_candidate:.3f} ms ({(row.ratio - 1) * 100:+.1f} %, '
+                   f'{confidence} % CI [{(row.ci_low - 1) * 100:+.1f} %, {(row.ci_high - 1) * 100:+.1f} %], '
+                   f'p = {row.p_value:.3g})')
+
+    num_regressions: int = int((df['verdict'] == 'regression').sum()) if len(df) else 0
+    num_improvements: int = int((df['verdict'] == 'improvement').sum()) if len(df) else 0
+    tqdm_print(f'Compared {len(df)} cases: {num_regressions} regression(s), {num_improvements} improvement(s), '
+               f'{num_errors} failed experiment(s)')
+    exit(num_regressions != 0 or num_errors != 0)
+
+
 #=======================================================================================================================
 # main
 #=======================================================================================================================
@@ -512,5 +729,23 @@ if __name__ == '__main__':
                              'database')
     parser.add_argument('-b', '--builddir', help='path to the build directory (defaults to \'build/release\')',
                         default=os.path.join('build', 'release'), type=str, metavar='PATH')
+    parser.add_argument('--compare-to', dest='baseline', metavar='PATH', default=None, type=str,
+                        help='compare the build in the build directory (candidate) to the build in PATH (baseline) '
+                             'instead of recording measurements; exits with an error on regression')
+    parser.add_argument('--warmup', dest='warmup', metavar='RUNS', default=1, type=int,
+                        help='number of discarded runs per build before measuring (only with --compare-to)')
+    parser.add_argument('--alpha', dest='alpha', default=0.05, type=float,
+                        help='significance level of the comparison (only with --compare-to)')
+    parser.add_argument('--threshold', dest='threshold', default=0.02, type=float,
+                        help='minimal relative slowdown reported as regression (only with --compare-to)')
+    parser.add_argument('--phases', dest='phases', default=False, action='store_true',
+                        help='measure the phases ' + ', '.join(f'"{p}"' for p in REGRESSION_PHASES.keys()) +
+                             ' instead of the patterns of the experiments (only with --compare-to)')
+    parser.add_argument('--perf-counters', dest='perf_counters', default=False, action='store_true',
+                        help='additionally measure hardware performance counters of mutable (requires access to '
+                             '`perf_event_open`, see /proc/sys/kernel/perf_event_paranoid)')
     args = parser.parse_args()
-    run_benchmarks(args)
+    if args.baseline:
+        run_regression_check(args)
+    else:
+        run_benchmarks(args)
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <boost/container/allocator.hpp>
 #include <boost/container/node_allocator.hpp>
 #include <boost/heap/binomial_heap.hpp>
@@ -109,10 +110,18 @@ struct Base : crtp<Actual, Base>
     static unsigned NUM_STATES_CONSTRUCTED() { return state_counters_.num_states_constructed; }
     static unsigned NUM_STATES_DISPOSED() { return state_counters_.num_states_disposed; }
 
-    static void INCREMENT_NUM_STATES_GENERATED() { state_counters_.num_states_generated += 1; }
-    static void INCREMENT_NUM_STATES_EXPANDED() { state_counters_.num_states_expanded += 1; }
-    static void INCREMENT_NUM_STATES_CONSTRUCTED() { state_counters_.num_states_constructed += 1; }
-    static void INCREMENT_NUM_STATES_DISPOSED() { state_counters_.num_states_disposed += 1; }
+    /* States may be created concurrently by a parallel search, hence increment atomically. */
+    static void INCREMENT_NUM_STATES_GENERATED() { increment(state_counters_.num_states_generated); }
+    static void INCREMENT_NUM_STATES_EXPANDED() { increment(state_counters_.num_states_expanded); }
+    static void INCREMENT_NUM_STATES_CONSTRUCTED() { increment(state_counters_.num_states_constructed); }
+    static void INCREMENT_NUM_STATES_DISPOSED() { increment(state_counters_.num_states_disposed); }
+
+    private:
+    static void increment(unsigned &counter) {
+        std::atomic_ref<unsigned>(counter).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    public:
 
     static state_counters_t STATE_COUNTERS() { return state_counters_; }
     static state_counters_t STATE_COUNTERS(state_counters_t new_counters) {
@@ -1294,15 +1303,15 @@ struct BottomUpComplete : BottomUp
 
                     /* Compute total cost. */
                     cnf::CNF condition; // TODO use join condition
-                    if (not PT[joined].model) {
+                    auto &model_joined = PT.model(joined, [&]() {
                         auto &model_left  = *PT[*outer_it].model;
                         auto &model_right = *PT[*inner_it].model;
-                        PT[joined].model = CE.estimate_join(G, model_left, model_right, condition);
-                    }
+                        return CE.estimate_join(G, model_left, model_right, condition);
+                    });
                     /* The cost of the final join is always the size of the result set, and hence the same for all
                      * plans.  We therefore omit this cost, as otherwise goal states might be artificially postponed in
                      * the priority queue.   */
-                    const double action_cost = joined == All ? 0 : CE.predict_cardinality(*PT[joined].model);
+                    const double action_cost = joined == All ? 0 : CE.predict_cardinality(model_joined);
 
                     /* Create new search state. */
                     SubproblemsArray S(
@@ -1649,9 +1658,8 @@ struct TopDownComplete : TopDown
              * */
             double action_cost = 0;
             if ((S1|S2) != All) {
-                if (not PT[S1|S2].model)
-                    PT[S1|S2].model = CE.estimate_join_all(G, PT, S1|S2, condition);
-                action_cost = CE.predict_cardinality(*PT[S1|S2].model);
+                auto &model = PT.model(S1|S2, [&]() { return CE.estimate_join_all(G, PT, S1|S2, condition); });
+                action_cost = CE.predict_cardinality(model);
             }
 
             /* Create new search state. */
@@ -1767,9 +1775,8 @@ struct sum<PlanTable, State, TopDown>
         double distance = 0;
         state.for_each_subproblem([&](const Subproblem S) {
             if (not S.is_singleton()) { // skip base relations
-                if (not PT[S].model)
-                    PT[S].model = CE.estimate_join_all(G, PT, S, condition);
-                distance += CE.predict_cardinality(*PT[S].model);
+                auto &model = PT.model(S, [&]() { return CE.estimate_join_all(G, PT, S, condition); });
+                distance += CE.predict_cardinality(model);
             }
         }, G);
         return distance;
@@ -1801,9 +1808,8 @@ struct sqrt_sum<PlanTable, State, TopDown>
         double distance = 0;
         state.for_each_subproblem([&](const Subproblem S) {
             if (not S.is_singleton()) { // skip base relations
-                if (not PT[S].model)
-                    PT[S].model = CE.estimate_join_all(G, PT, S, condition);
-                distance += 2 * std::sqrt(CE.predict_cardinality(*PT[S].model));
+                auto &model = PT.model(S, [&]() { return CE.estimate_join_all(G, PT, S, condition); });
+                distance += 2 * std::sqrt(CE.predict_cardinality(model));
             }
         }, G);
         return distance;
@@ -1925,15 +1931,15 @@ struct bottomup_lookahead_cheapest
                 M_insist((*outer_it & *inner_it).empty(), "subproblems must not overlap");
                 if (neighbors & *inner_it) { // inner and outer are joinable.
                     const Subproblem joined = *outer_it | *inner_it;
-                    if (not PT[joined].model) {
-                        PT[joined].model = CE.estimate_join(G, *PT[*outer_it].model, *PT[*inner_it].model,
-                                                            /* TODO */ cnf::CNF{});
-                    }
+                    auto &model_joined = PT.model(joined, [&]() {
+                        return CE.estimate_join(G, *PT[*outer_it].model, *PT[*inner_it].model,
+                                                /* TODO */ cnf::CNF{});
+                    });
                     cnf::CNF condition; // TODO use join condition
                     const double total_cost = CF.calculate_join_cost(G, PT, CE, *outer_it, *inner_it, condition);
                     const double action_cost = total_cost - (PT[*outer_it].cost + PT[*inner_it].cost);
                     ///> XXX: Sum of different units: cost and cardinality
-                    const double additional_costs = action_cost + CE.predict_cardinality(*PT[joined].model);
+                    const double additional_costs = action_cost + CE.predict_cardinality(model_joined);
                     if (additional_costs < min_additional_costs) {
                         min_subproblem_left = *outer_it;
                         min_subproblem_right = *inner_it;
@@ -2051,13 +2057,13 @@ struct avg_sel<PlanTable, State, BottomUp>
         }
 
         const Subproblem All = Subproblem::All(G.num_sources());
-        if (not PT[All].model) {
+        auto &model_All = PT.model(All, [&]() {
             static cnf::CNF condition;
-            PT[All].model = CE.estimate_join_all(G, PT, All, condition);
-        }
+            return CE.estimate_join_all(G, PT, All, condition);
+        });
 
         double Cprod = std::reduce(cardinalities, end, 1., std::multiplies<double>{});
-        const double sel_remaining = CE.predict_cardinality(*PT[All].model) / Cprod;
+        const double sel_remaining = CE.predict_cardinality(model_All) / Cprod;
         M_insist(sel_remaining <= 1.1);
 
         const std::size_t num_joins_remaining = state.size() - 1;
@@ -2098,7 +2104,9 @@ struct Fibonacci_heap
     using compare = boost::heap::compare<Cmp>;
 
     template<typename T, typename... Options>
-    using heap_type = boost::heap::fibonacci_heap<T, Options...>;
+    using heap_type = boost::heap::fibonacci_heap<
+        T, Options..., boost::heap::allocator<boost::container::node_allocator<T>>
+    >;
 
     template<typename T>
     using allocator_type = boost::container::node_allocator<T>;
@@ -2183,6 +2191,22 @@ template<typename PlanTable, typename State>
 double goo_path_completion(const State &state, PlanTable &PT, const QueryGraph &G, const AdjacencyMatrix &M,
                            const CardinalityEstimator &CE, const CostFunction &CF, binary_plan_type &plan);
 
+/** Whether states of type `State` can be expanded with `Expand` and evaluated with `Heuristic` in parallel, see
+ * `ai::SearchConfiguration::num_threads`.  This requires that both access plan table entries only through
+ * `PlanTableBase::model()` and that the plan table never moves its entries, i.e. is a `PlanTableSmallOrDense`.  Expansions of all states other than
+ * `SubproblemsArray` update the plan table entries of the joined subproblems and read the costs of their inputs,
+ * and the bottom-up `GOO` heuristic temporarily modifies the costs of its inputs. */
+template<
+    typename PlanTable,
+    typename State,
+    typename Expand,
+    template<typename, typename, typename> typename Heuristic
+>
+constexpr bool supports_parallel_expansion =
+    std::is_same_v<PlanTable, PlanTableSmallOrDense> and
+    std::is_same_v<State, search_states::SubproblemsArray> and
+    not std::is_base_of_v<heuristics::GOO<PlanTable, State, expansions::BottomUp>, Heuristic<PlanTable, State, Expand>>;
+
 template<
     typename PlanTable,
     typename State,
@@ -9,6 +9,7 @@
 #include <mutable/util/macro.hpp>
 #include <functional>
 #include <iostream>
+#include <optional>
 #include <unordered_map>
 #include <utility>
 #include <variant>
@@ -31,6 +32,10 @@ struct M_EXPORT OperatorInformation
 
     ///> the estimated cardinality of the result set of this `Operator`
     double estimated_cardinality;
+
+    ///> the cardinality of the result set of this `Operator` observed during execution, if recorded by the backend;
+    ///> mutable since the backend executes a constant plan
+    mutable std::optional<std::size_t> observed_cardinality;
 };
 
 /** This interface allows for attaching arbitrary data to `Operator` instances. */
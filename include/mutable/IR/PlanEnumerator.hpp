@@ -110,10 +110,11 @@ struct M_EXPORT GOO : PlanEnumeratorCRTP<GOO>
                         M_insist((outer->subproblem & inner->subproblem).empty());
                         M_insist(M.is_connected(outer->subproblem, inner->subproblem));
                         const Subproblem joined = outer->subproblem | inner->subproblem;
-                        if (not PT[joined].model)
-                            PT[joined].model = CE.estimate_join(G, *PT[outer->subproblem].model,
-                                                                *PT[inner->subproblem].model, condition);
-                        const double C_joined = CE.predict_cardinality(*PT[joined].model);
+                        auto &model_joined = PT.model(joined, [&]() {
+                            return CE.estimate_join(G, *PT[outer->subproblem].model, *PT[inner->subproblem].model,
+                                                    condition);
+                        });
+                        const double C_joined = CE.predict_cardinality(model_joined);
                         if (C_joined < least_cardinality) {
                             least_cardinality = C_joined;
                             left = outer;
@@ -177,11 +178,10 @@ struct M_EXPORT TDGOO : PlanEnumeratorCRTP<TDGOO>
             double C_min = std::numeric_limits<decltype(C_min)>::infinity();
             Subproblem min_left, min_right;
             auto enumerate_ccp = [&](Subproblem left, Subproblem right) -> void {
-                if (not PT[left].model)
-                    PT[left].model = CE.estimate_join_all(G, PT, left, cnf::CNF{}); // TODO: use actual condition
-                if (not PT[right].model)
-                    PT[right].model = CE.estimate_join_all(G, PT, right, cnf::CNF{}); // TODO: use actual condition
-                const double C = CE.predict_cardinality(*PT[left].model) + CE.predict_cardinality(*PT[right].model);
+                // TODO: use actual condition
+                auto &model_left = PT.model(left, [&]() { return CE.estimate_join_all(G, PT, left, cnf::CNF{}); });
+                auto &model_right = PT.model(right, [&]() { return CE.estimate_join_all(G, PT, right, cnf::CNF{}); });
+                const double C = CE.predict_cardinality(model_left) + CE.predict_cardinality(model_right);
                 if (C < C_min) {
                     C_min = C;
                     min_left = left;
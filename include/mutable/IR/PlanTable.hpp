@@ -1,10 +1,12 @@
 #pragma once
 
+#include <array>
 #include <cmath>
 #include <cstdint>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <mutable/mutable-config.hpp>
 #include <mutable/catalog/CardinalityEstimator.hpp>
 #include <mutable/catalog/CostFunction.hpp>
@@ -155,9 +157,47 @@ struct M_EXPORT PlanTableBase : crtp<Actual, PlanTableBase>
         }
     }
 
+    /** Returns the data model of `s`.  If `s` has no data model yet, it is computed by `estimate()` first.  Threads
+     * may call this method concurrently, e.g. when expanding search states in parallel, if `concurrent_models(true)`
+     * was set before, as long as the table is not resized and data models are only set lazily through this method.
+     * `estimate()` runs without holding a lock, so concurrent threads may compute the model of `s` more than once;
+     * only the first model is published and all threads return it. */
+    template<typename Estimate>
+    const DataModel & model(Subproblem s, Estimate &&estimate) {
+        auto &entry = operator[](s);
+        if (not concurrent_models_) {
+            if (not entry.model)
+                entry.model = estimate();
+            return *entry.model;
+        }
+
+        auto &mutex = model_mutexes_[SubproblemHash{}(s) % NUM_MODEL_MUTEXES];
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (entry.model)
+                return *entry.model;
+        }
+        std::unique_ptr<DataModel> model = estimate();
+        std::lock_guard<std::mutex> lock(mutex);
+        if (not entry.model)
+            entry.model = std::move(model); // publish, unless another thread was faster
+        return *entry.model;
+    }
+
+    /** Sets whether threads call `model()` concurrently.  Only then, `model()` synchronizes the threads. */
+    void concurrent_models(bool concurrent) { concurrent_models_ = concurrent; }
+
     /** Resets the costs for all entries in the table. */
     void reset_costs() { actual().reset_costs(); }
 
+    private:
+    ///> whether threads call `model()` concurrently, see `concurrent_models()`
+    bool concurrent_models_ = false;
+    ///> number of mutexes guarding the lazy computation of data models, see `model()`
+    static constexpr std::size_t NUM_MODEL_MUTEXES = 64;
+    ///> mutexes guarding the publication of lazily computed data models of this table, striped by subproblem
+    std::array<std::mutex, NUM_MODEL_MUTEXES> model_mutexes_;
+
 M_LCOV_EXCL_START
     public:
     friend std::ostream & M_EXPORT operator<<(std::ostream &out, const PlanTableBase &PT);
@@ -36,6 +36,7 @@ struct M_EXPORT Options
 
     /*----- Additional outputs ---------------------------------------------------------------------------------------*/
     bool times;
+    bool perf_counters;
     bool statistics;
     bool echo;
     bool ast;
@@ -46,6 +47,10 @@ struct M_EXPORT Options
     bool plan;
     bool plandot;
     bool physplan;
+    bool explain_analyze;
+
+    /** If not `nullptr`, record the phases of all queries as spans and write them as Chrome trace to this file. */
+    const char *trace_file;
 
     /** If `true`, do not pass the query to the backend for execution. */
     bool dryrun;
@@ -5,6 +5,7 @@
 #include <mutable/storage/Index.hpp>
 #include <mutable/IR/Operator.hpp>
 #include <mutable/storage/DataLayoutFactory.hpp>
+#include <mutable/storage/Store.hpp>
 #include <mutable/util/macro.hpp>
 #include <mutable/util/memory.hpp>
 #include <unordered_map>
@@ -40,15 +41,17 @@ struct WasmEngine
         std::unique_ptr<const storage::DataLayoutFactory> result_set_factory;
         memory::AddressSpace vm; ///<  WebAssembly module instance's virtual address space aka.\ *linear memory*
         uint32_t heap = 0; ///< beginning of the heap, encoded as offset from the beginning of the virtual address space
+        ///> snapshots of the tables mapped into `vm`, such that the query reads a consistent state of each table
+        std::vector<std::unique_ptr<storage::Snapshot>> snapshots;
         std::vector<std::reference_wrapper<const idx::IndexBase>> indexes; ///< the indexes used in the query
 
         WasmContext(uint32_t id, const MatchBase &plan, config_t configuration, std::size_t size);
 
         bool config(config_t cfg) const { return bool(cfg & config_); }
 
-        /** Maps a table at the current start of `heap` and advances `heap` past the mapped region.  Returns the address
-         * (in linear memory) of the mapped table.  Installs guard pages after each mapping.  Acknowledges
-         * `TRAP_GUARD_PAGES`.  */
+        /** Maps a snapshot of a table at the current start of `heap` and advances `heap` past the mapped region.
+         * Returns the address (in linear memory) of the mapped table.  Installs guard pages after each mapping.
+         * Acknowledges `TRAP_GUARD_PAGES`.  */
         uint32_t map_table(const Table &table);
         /** Maps an index at the current start of `heap` and advances `heap` past the mapped region.  Returns the address
          * (in linear memory) of the mapped index.  Installs guard pages after each mapping.  Acknowledges
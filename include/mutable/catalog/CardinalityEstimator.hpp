@@ -7,6 +7,7 @@
 #include <mutable/util/crtp.hpp>
 #include <mutable/util/Pool.hpp>
 #include <sstream>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -28,6 +29,7 @@ struct PlanTableLargeAndSparse;
 struct PlanTableSmallOrDense;
 struct QueryGraph;
 struct SpnWrapper;
+struct Table;
 
 using Subproblem = SmallBitset;
 
@@ -139,6 +141,29 @@ struct M_EXPORT CardinalityEstimator : estimate_join_all_tag::base_type
 
     virtual double predict_number_distinct_values(const DataModel &data) const;
 
+    /*==================================================================================================================
+     * Feedback from execution
+     *================================================================================================================*/
+
+    /** Returns `true` iff this estimator learns from the cardinalities observed while executing queries.  If so, the
+     * backend records the observed cardinalities in the `OperatorInformation` of the executed plan. */
+    virtual bool requests_feedback() const { return false; }
+
+    /** Updates this estimator with the cardinalities observed while executing the logical plan \p plan. */
+    virtual void feedback(const Operator &plan);
+
+    /*==================================================================================================================
+     * Maintenance under updates
+     *================================================================================================================*/
+
+    /** Informs this estimator that rows were appended to \p table, i.e. the rows from \p first_row to the end of its
+     * store, e.g. by an INSERT or IMPORT statement. */
+    virtual void rows_appended(const Table &table, std::size_t first_row);
+
+    /** Processes all rows of \p table, that were reported by `rows_appended()` but not yet processed.  Must be called
+     * before rows of \p table are moved, e.g. to restore its sort order. */
+    virtual void flush_appended_rows(const Table &table);
+
     /*==================================================================================================================
      * other methods
      *================================================================================================================*/
@@ -247,10 +272,8 @@ struct M_EXPORT InjectionCardinalityEstimator : CardinalityEstimatorCRTP<Injecti
     };
 
     private:
-    ///> buffer used to construct identifiers
-    mutable std::vector<char> buf_;
-    ///> buffer used to construct identifiers
-    mutable std::ostringstream oss_;
+    ///> buffer used to construct identifiers while reading the injected cardinalities
+    std::vector<char> buf_;
 
     std::unordered_map<ThreadSafePooledString, std::size_t> cardinality_table_;
     CartesianProductEstimator fallback_;
@@ -308,8 +331,8 @@ struct M_EXPORT InjectionCardinalityEstimator : CardinalityEstimatorCRTP<Injecti
     private:
     void read_json(Diagnostic &diag, std::istream &in, const ThreadSafePooledString &name_of_database);
     void print(std::ostream &out) const override;
-    void buf_append(const char *s) const { while (*s) buf_.emplace_back(*s++); }
-    void buf_append(const std::string &s) const {
+    void buf_append(const char *s) { while (*s) buf_.emplace_back(*s++); }
+    void buf_append(const std::string &s) {
         buf_.reserve(buf_.size() + s.size());
         buf_append(s.c_str());
     }
@@ -350,6 +373,8 @@ struct M_EXPORT SpnEstimator : CardinalityEstimatorCRTP<SpnEstimator>
     std::unordered_map<ThreadSafePooledString, SpnWrapper*> table_to_spn_;
     ///> the name of the database, the estimator is built on
     ThreadSafePooledString name_of_database_;
+    ///> the first row of every table that was appended but is not yet reflected by the table's Spn
+    std::unordered_map<ThreadSafePooledString, std::size_t> pending_rows_;
 
     public:
     explicit SpnEstimator(ThreadSafePooledString name_of_database) : name_of_database_(std::move(name_of_database)) { }
@@ -416,7 +441,162 @@ struct M_EXPORT SpnEstimator : CardinalityEstimatorCRTP<SpnEstimator>
 
     std::size_t predict_cardinality(const DataModel &data) const override;
 
+
+    /*==================================================================================================================
+     * Maintenance under updates
+     *================================================================================================================*/
+
+    /** Inserts the appended rows into the Spn of \p table once at least `--spn-update-batch-size` rows are pending.
+     * Drifted parts of the Spn are relearned afterwards. */
+    void rows_appended(const Table &table, std::size_t first_row) override;
+    /** Inserts the pending rows of \p table into its Spn, even if they do not yet complete a batch. */
+    void flush_appended_rows(const Table &table) override;
+
+    private:
+    /** Inserts the rows of \p table from \p first_row on into its Spn \p spn and relearns drifted parts of it. */
+    void insert_rows(const Table &table, SpnWrapper *&spn, std::size_t first_row);
+
+    void print(std::ostream &out) const override;
+};
+
+/**
+ * FeedbackCardinalityEstimator that prefers cardinalities observed while executing previous queries over the estimates
+ * of an underlying estimator.
+ * Observed cardinalities are keyed by the tables of a subproblem together with the filters applied to each of them and
+ * the join predicates among them.  Attributes in keys are qualified by the names of their tables rather than by aliases,
+ * such that observations carry over to queries using different aliases.  If nothing was observed for a subproblem, the
+ * estimate of the underlying estimator is scaled by the factors by which the estimates of its inputs were corrected.
+ * Observations are persisted to the file passed by the user via commandline, if any, in batches of
+ * `--cardinality-feedback-batch-size` queries and when the estimator is destroyed.
+ */
+struct M_EXPORT FeedbackCardinalityEstimator : CardinalityEstimatorCRTP<FeedbackCardinalityEstimator>
+{
+    struct FeedbackDataModel : DataModel
+    {
+        friend struct FeedbackCardinalityEstimator;
+
+        private:
+        std::unique_ptr<DataModel> model_; ///< the model of the underlying estimator
+        Subproblem subproblem_; ///< the data sources of the query graph described by this model
+        std::vector<std::string> sources_; ///< sorted signatures, i.e. table names and filters, of the data sources
+        std::size_t size_; ///< the cardinality, observed or corrected estimate
+        double correction_; ///< the factor by which `size_` deviates from the estimate of the underlying estimator
+
+        public:
+        FeedbackDataModel(std::unique_ptr<DataModel> model, Subproblem subproblem, std::vector<std::string> sources,
+                          std::size_t size, double correction)
+            : model_(std::move(model))
+            , subproblem_(subproblem)
+            , sources_(std::move(sources))
+            , size_(size)
+            , correction_(correction)
+        { }
+
+        void assign_to(Subproblem s) override { model_->assign_to(s); }
+    };
+
+    private:
+    ///> the name of the database, the estimator is built on
+    ThreadSafePooledString name_of_database_;
+    ///> the underlying estimator used for subproblems without observed cardinality
+    std::unique_ptr<CardinalityEstimator> estimator_;
+    ///> maps the signature of a subproblem, see `make_key()`, to its observed cardinality
+    std::unordered_map<std::string, std::size_t> observed_;
+    ///> the number of queries whose observed cardinalities were not yet persisted
+    std::size_t num_unpersisted_queries_ = 0;
+
+    public:
+    /** Create a `FeedbackCardinalityEstimator` for the database `name_of_database` on top of the estimator and with the
+     * feedback file that were passed by the user via commandline. */
+    explicit FeedbackCardinalityEstimator(ThreadSafePooledString name_of_database);
+
+    /** Create a `FeedbackCardinalityEstimator` for the database `name_of_database` on top of `estimator` without any
+     * feedback file. */
+    FeedbackCardinalityEstimator(ThreadSafePooledString name_of_database,
+                                 std::unique_ptr<CardinalityEstimator> estimator);
+
+    FeedbackCardinalityEstimator(const FeedbackCardinalityEstimator&) = delete;
+    FeedbackCardinalityEstimator(FeedbackCardinalityEstimator&&) = default;
+
+    /** Persists the observed cardinalities that were not yet persisted. */
+    ~FeedbackCardinalityEstimator();
+
+    /** Records the cardinality \p size observed for the subproblem of data sources with signatures \p sources, joined
+     * by the predicates whose clauses have the signatures \p joins. */
+    void observe(std::vector<std::string> sources, std::size_t size, std::vector<std::string> joins = {});
+
+    /** Returns the number of observed cardinalities. */
+    std::size_t num_observations() const { return observed_.size(); }
+
+
+    /*==================================================================================================================
+     * Model calculation
+     *================================================================================================================*/
+
+    std::unique_ptr<DataModel> empty_model() const override;
+    std::unique_ptr<DataModel> estimate_scan(const QueryGraph &G, Subproblem P) const override;
+    std::unique_ptr<DataModel>
+    estimate_filter(const QueryGraph &G, const DataModel &data, const cnf::CNF &filter) const override;
+    std::unique_ptr<DataModel>
+    estimate_limit(const QueryGraph &G, const DataModel &data, std::size_t limit, std::size_t offset) const override;
+    std::unique_ptr<DataModel>
+    estimate_grouping(const QueryGraph &G, const DataModel &data, const std::vector<group_type> &groups) const override;
+    std::unique_ptr<DataModel>
+    estimate_join(const QueryGraph &G, const DataModel &left, const DataModel &right,
+                  const cnf::CNF &condition) const override;
+
+    template<typename PlanTable>
+    std::unique_ptr<DataModel>
+    operator()(estimate_join_all_tag, PlanTable &&PT, const QueryGraph &G, Subproblem to_join,
+               const cnf::CNF &condition) const;
+
+
+    /*==================================================================================================================
+     * Prediction via model use
+     *================================================================================================================*/
+
+    std::size_t predict_cardinality(const DataModel &data) const override;
+
+
+    /*==================================================================================================================
+     * Feedback from execution
+     *================================================================================================================*/
+
+    bool requests_feedback() const override { return true; }
+    void feedback(const Operator &plan) override;
+
+
+    /*==================================================================================================================
+     * Maintenance under updates
+     *================================================================================================================*/
+
+    void rows_appended(const Table &table, std::size_t first_row) override {
+        estimator_->rows_appended(table, first_row);
+    }
+    void flush_appended_rows(const Table &table) override { estimator_->flush_appended_rows(table); }
+
     private:
+    /** Returns the signature of the filter \p filter as appended to the signature of a data source. */
+    static std::string make_filter_signature(const cnf::CNF &filter);
+    /** Returns the sorted signatures of the clauses of \p cnf, e.g. of a join predicate. */
+    static std::vector<std::string> make_clause_signatures(const cnf::CNF &cnf);
+    /** Returns the sorted signatures of the clauses of all join predicates of \p G among the data sources in \p S.
+     * These are exactly the predicates of the joins in any plan for \p S, see `Optimizer::construct_join_order()`,
+     * independent of the join condition passed by the plan enumerator. */
+    static std::vector<std::string> make_join_signatures(const QueryGraph &G, Subproblem S);
+    /** Returns the key of the subproblem of data sources with the signatures \p sources, joined by the predicates
+     * whose clauses have the signatures \p joins. */
+    static std::string make_key(std::vector<std::string> sources, std::vector<std::string> joins);
+    /** Creates a model for the data sources \p subproblem with signatures \p sources, joined by the predicates whose
+     * clauses have the signatures \p joins, from the model \p model of the underlying estimator.  Prefers the observed cardinality,
+     * if any, and otherwise corrects the estimate by \p correction. */
+    std::unique_ptr<FeedbackDataModel>
+    make_model(std::unique_ptr<DataModel> model, Subproblem subproblem, std::vector<std::string> sources,
+               std::vector<std::string> joins, double correction) const;
+
+    void read_json(Diagnostic &diag, std::istream &in);
+    /** Writes all observed cardinalities to the feedback file, preserving the entries of other databases. */
+    void persist();
     void print(std::ostream &out) const override;
 };
 
@@ -590,6 +590,14 @@ struct M_EXPORT Table
      * attribute with the given `name` exists. */
     virtual void add_primary_key(const ThreadSafePooledString &name) = 0;
 
+    /** Returns the attributes the rows of this table are kept sorted by, in order of significance, each with `true`
+     * iff sorted ascending.  Empty iff the table has no declared sort key. */
+    virtual std::vector<std::pair<std::reference_wrapper<const Attribute>, bool>> sort_key() const = 0;
+
+    /** Appends the attribute with the given `name` to the sort key of this table, sorted ascending iff \p ascending.
+     * Throws `std::out_of_range` if no attribute with the given `name` exists. */
+    virtual void add_sort_key(const ThreadSafePooledString &name, bool ascending) = 0;
+
     /** Adds a new attribute with the given `name` and `type` to the table.  Throws `std::invalid_argument` if the
      * `name` is already in use. */
     virtual void push_back(ThreadSafePooledString name, const PrimitiveType *type) = 0;
@@ -615,6 +623,7 @@ struct M_EXPORT ConcreteTable : Table
     std::unique_ptr<Store> store_; ///< the store backing this table; may be `nullptr`
     storage::DataLayout layout_; ///< the physical data layout for this table
     SmallBitset primary_key_; ///< the primary key of this table, maintained as a `SmallBitset` over attribute id's
+    std::vector<std::pair<std::size_t, bool>> sort_key_; ///< the sort key of this table as attribute id's and orders
 
     public:
     ConcreteTable(ThreadSafePooledString name) : name_(std::move(name)) { }
@@ -719,6 +728,21 @@ struct M_EXPORT ConcreteTable : Table
         primary_key_(attr.id) = true;
     }
 
+    /** Returns the attributes the rows of this table are kept sorted by, in order of significance, each with `true`
+     * iff sorted ascending.  Empty iff the table has no declared sort key. */
+    std::vector<std::pair<std::reference_wrapper<const Attribute>, bool>> sort_key() const override {
+        std::vector<std::pair<std::reference_wrapper<const Attribute>, bool>> res;
+        for (auto [id, ascending] : sort_key_)
+            res.emplace_back(operator[](id), ascending);
+        return res;
+    }
+    /** Appends the attribute with the given `name` to the sort key of this table, sorted ascending iff \p ascending.
+     * Throws `std::out_of_range` if no attribute with the given `name` exists. */
+    void add_sort_key(const ThreadSafePooledString &name, bool ascending) override {
+        auto &attr = at(name);
+        sort_key_.emplace_back(attr.id, ascending);
+    }
+
     /** Adds a new attribute with the given `name` and `type` to the table.  Throws `std::invalid_argument` if the
      * `name` is already in use. */
     void push_back(ThreadSafePooledString name, const PrimitiveType *type) override {
@@ -801,6 +825,9 @@ struct TableDecorator : Table
     virtual std::vector<std::reference_wrapper<const Attribute>> primary_key() const override { return table_->primary_key(); }
     virtual void add_primary_key(const ThreadSafePooledString &name) override { table_->add_primary_key(name); }
 
+    virtual std::vector<std::pair<std::reference_wrapper<const Attribute>, bool>> sort_key() const override { return table_->sort_key(); }
+    virtual void add_sort_key(const ThreadSafePooledString &name, bool ascending) override { table_->add_sort_key(name, ascending); }
+
     virtual void push_back(ThreadSafePooledString name, const PrimitiveType * type) override { table_->push_back(std::move(name), type); }
 
     virtual Schema schema(const ThreadSafePooledOptionalString &alias) const override { return table_->schema(alias); }
@@ -946,6 +973,7 @@ struct M_EXPORT Database
     std::unique_ptr<CardinalityEstimator> cardinality_estimator(std::unique_ptr<CardinalityEstimator> CE) {
         auto old = std::move(cardinality_estimator_); cardinality_estimator_ = std::move(CE); return old;
     }
+    CardinalityEstimator & cardinality_estimator() { return *cardinality_estimator_; }
     const CardinalityEstimator & cardinality_estimator() const { return *cardinality_estimator_; }
 
     /*===== Indexes ==================================================================================================*/
@@ -1051,6 +1079,12 @@ struct M_EXPORT Database
                 entry.is_valid = false;
         }
     }
+
+    /** Maintains everything derived from the rows of `Table` \p table after rows were appended to its store, starting
+     * at row \p first_row: the statistics of the cardinality estimator, the dictionaries, the sort order of the table,
+     * the zone map, and the indexes, which do not contain the appended rows and are invalidated.  Must be called by
+     * every statement that appends rows. */
+    void rows_appended(const Table &table, std::size_t first_row);
 };
 
 }
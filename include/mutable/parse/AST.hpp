@@ -527,12 +527,14 @@ struct M_EXPORT SelectClause : Clause
 
     std::vector<select_type> select;
     Token select_all;
+    Token distinct; ///> the `DISTINCT` keyword, if duplicate rows are to be eliminated
     std::vector<std::unique_ptr<Expr>> expanded_select_all; ///> list of expressions expanded from `SELECT *`
 
-    SelectClause(Token tok, std::vector<select_type> select, Token select_all)
+    SelectClause(Token tok, std::vector<select_type> select, Token select_all, Token distinct)
             : Clause(std::move(tok))
             , select(std::move(select))
             , select_all(std::move(select_all))
+            , distinct(std::move(distinct))
     { }
 
     void accept(ASTClauseVisitor &v) override;
@@ -868,12 +870,18 @@ struct M_EXPORT CreateTableStmt : Stmt
         { }
     };
 
+    /** An attribute of the sort key and whether it is sorted ascending (`true`) or descending (`false`). */
+    using sort_key_field = std::pair<Token, bool>;
+
     Token table_name;
     std::vector<std::unique_ptr<attribute_definition>> attributes;
+    std::vector<sort_key_field> sort_key; ///< the attributes the table is kept sorted by; may be empty
 
-    CreateTableStmt(Token table_name, std::vector<std::unique_ptr<attribute_definition>> attributes)
+    CreateTableStmt(Token table_name, std::vector<std::unique_ptr<attribute_definition>> attributes,
+                    std::vector<sort_key_field> sort_key = {})
             : table_name(std::move(table_name))
             , attributes(std::move(attributes))
+            , sort_key(std::move(sort_key))
     { }
 
     void accept(ASTCommandVisitor &v) override;
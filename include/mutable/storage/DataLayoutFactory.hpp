@@ -60,7 +60,12 @@ struct PAXLayoutFactory : DataLayoutFactory
     static constexpr uint64_t DEFAULT_NUM_TUPLES = 16;
     static constexpr uint64_t DEFAULT_NUM_BYTES = 1UL << 12; ///< 4 KiB
 
-    enum block_size_t { NTuples, NBytes }; ///< indicates whether the block size is given in number of tuples or bytes
+    static constexpr uint64_t CACHE_LINE_SIZE_IN_BITS = 512; ///< 64 bytes
+
+    /** Indicates whether the block size is given in number of tuples or bytes.  With `NBytesAligned`, the block size is
+     * given in bytes and the number of tuples per block is chosen such that every column of a block fills a whole
+     * number of cache lines, i.e. every column starts at a cache line boundary. */
+    enum block_size_t { NTuples, NBytes, NBytesAligned };
 
     private:
     block_size_t option_;
@@ -101,7 +106,7 @@ struct PAXLayoutFactory : DataLayoutFactory
         if (NTuples == option_)
             out << "#tuples=" << num_tuples_;
         else
-            out << "#bytes=" << num_bytes_;
+            out << "#bytes=" << num_bytes_ << (NBytesAligned == option_ ? ", aligned" : "");
         out << ")";
     }
 };
@@ -1,12 +1,16 @@
 #pragma once
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <mutable/mutable-config.hpp>
 #include <mutable/util/macro.hpp>
 #include <mutable/util/memory.hpp>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 
 namespace m {
@@ -17,24 +21,102 @@ struct Schema;
 struct StackMachine;
 struct Table;
 
+struct Store;
+
+namespace storage {
+
+struct Dictionary;
+struct ZoneMap;
+
+/** A consistent, read-only view of the rows of a `Store` at the time the snapshot was taken.  The memory of the store
+ * is mapped *copy-on-write*, hence taking a snapshot copies no data and never blocks writers: appended rows are placed
+ * behind the rows of the snapshot and are simply not part of it, and before a writer modifies rows in place it
+ * detaches all snapshots of the store by `Store::detach_snapshots()`, which makes the affected pages private to each
+ * snapshot.  A snapshot must not outlive its store. */
+struct M_EXPORT Snapshot
+{
+    friend struct m::Store;
+
+    private:
+    const Store &store_; ///< the store this is a snapshot of
+    std::optional<memory::AddressSpace> vm_; ///< the address space owned by this snapshot, if any
+    void *addr_; ///< the address of the snapshot's mapping
+    std::size_t size_; ///< the size of the snapshot's mapping in bytes
+    std::size_t num_rows_; ///< the number of rows of the store when the snapshot was taken
+
+    Snapshot(const Store &store, std::size_t num_rows, std::size_t size, std::optional<memory::AddressSpace> vm,
+             void *addr);
+
+    public:
+    Snapshot(const Snapshot&) = delete;
+    ~Snapshot();
+
+    const Store & store() const { return store_; }
+    /** Returns the address of the rows of this snapshot, laid out as in the store's memory. */
+    void * addr() const { return addr_; }
+    /** Returns the size of the mapping of this snapshot in bytes. */
+    std::size_t size() const { return size_; }
+    /** Returns the number of rows of this snapshot. */
+    std::size_t num_rows() const { return num_rows_; }
+
+    private:
+    /** Makes the pages of the snapshot overlapping the byte range `[offset, offset + size)` of the store's memory
+     * private to this snapshot. */
+    void detach(std::size_t offset, std::size_t size);
+};
+
+}
+
 /** Defines a generic store interface. */
 struct M_EXPORT Store
 {
+    friend struct storage::Snapshot;
+
     private:
     const Table &table_; ///< the table defining this store's schema
+    std::unique_ptr<storage::ZoneMap> zone_map_; ///< the zone map summarizing the rows of this store
+    ///> maps attribute IDs to the dictionaries of the attributes
+    std::unordered_map<std::size_t, std::unique_ptr<storage::Dictionary>> dictionaries_;
+    mutable std::mutex snapshots_mutex_; ///< protects `snapshots_`
+    mutable std::vector<storage::Snapshot*> snapshots_; ///< the live snapshots of this store
+    std::size_t num_sorted_rows_ = 0; ///< the number of leading rows that are sorted by the table's sort key
 
     protected:
-    Store(const Table &table) : table_(table) {}
+    Store(const Table &table);
 
     public:
     Store(const Store &) = delete;
 
     Store(Store &&) = default;
 
-    virtual ~Store() {}
+    virtual ~Store();
 
     const Table &table() const { return table_; }
 
+    /** Returns the zone map summarizing the rows of this store. */
+    storage::ZoneMap & zone_map() const { return *zone_map_; }
+
+    /** Returns the dictionary of the attribute with ID \p attr_id, or `nullptr` if the attribute has none. */
+    const storage::Dictionary * dictionary(std::size_t attr_id) const {
+        if (auto it = dictionaries_.find(attr_id); it != dictionaries_.end())
+            return it->second.get();
+        return nullptr;
+    }
+    /** Installs \p dictionary for the attribute with ID \p attr_id, replacing any previous dictionary, or removes the
+     * dictionary of the attribute if \p dictionary is `nullptr`.  Invalidates the zone map, since it summarizes
+     * attributes with a dictionary by their codes. */
+    void dictionary(std::size_t attr_id, std::unique_ptr<storage::Dictionary> dictionary);
+    /** Extends the dictionary of the attribute with ID \p attr_id by \p values and updates the zone map to the codes
+     * of the extended dictionary.  Requires that the attribute has a dictionary. */
+    void extend_dictionary(std::size_t attr_id, std::vector<std::string> values);
+
+    /** Returns the number of leading rows of this store that are sorted by the sort key of its table.  The remaining
+     * rows are runs appended since, which are merged into the sorted rows lazily (see
+     * `storage::restore_sort_order()`).  The store is sorted iff this equals `num_rows()`. */
+    std::size_t num_sorted_rows() const { return std::min(num_sorted_rows_, num_rows()); }
+    /** Sets the number of leading rows of this store that are sorted by the sort key of its table. */
+    void num_sorted_rows(std::size_t n) { M_insist(n <= num_rows()); num_sorted_rows_ = n; }
+
     /** Returns the memory corresponding to the `Linearization`'s root node. */
     virtual const memory::Memory & memory() const = 0;
 
@@ -44,9 +126,22 @@ struct M_EXPORT Store
     /** Append a row to the store. */
     virtual void append() = 0;
 
-    /** Drop the most recently appended row. */
+    /** Drop the most recently appended row.  The memory of the row is reused by the next `append()`, hence rows
+     * contained in live snapshots must be detached by `detach_snapshots()` before they are dropped. */
     virtual void drop() = 0;
 
+    /** Takes a snapshot of the rows of this store, mapped into a fresh address space owned by the snapshot.  Requires
+     * that the table of this store has a layout. */
+    std::unique_ptr<storage::Snapshot> snapshot() const;
+    /** Takes a snapshot of the rows of this store, mapped into the address space \p vm at offset \p offset.  The
+     * mapping is not removed when the snapshot is destroyed.  Requires that the table of this store has a layout. */
+    std::unique_ptr<storage::Snapshot> snapshot(const memory::AddressSpace &vm, std::size_t offset) const;
+
+    /** Must be called *before* rows are modified in place, i.e. rows already contained in snapshots.  Detaches all
+     * live snapshots of this store from the rows starting at row \p first_row, such that the snapshots are not
+     * affected by the modification.  Appending rows does not require detaching snapshots. */
+    void detach_snapshots(std::size_t first_row) const;
+
     virtual void dump(std::ostream &out) const = 0;
     void dump() const;
 };
@@ -1,16 +1,23 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <bit>
 #include <cmath>
+#include <exception>
 #include <functional>
 #include <iosfwd>
+#include <iterator>
+#include <memory>
 #include <mutable/Options.hpp>
 #include <mutable/util/ADT.hpp>
 #include <mutable/util/exception.hpp>
 #include <mutable/util/macro.hpp>
 #include <mutable/util/OptField.hpp>
+#include <thread>
+#include <tuple>
 #include <type_traits>
-#include <unordered_map>
 #include <vector>
 
 
@@ -88,6 +95,248 @@ concept heuristic_search =
  * Heuristic Search Classes
  *====================================================================================================================*/
 
+/** Maps search states to the information attached to them.  Unlike `std::unordered_map`, the map is tailored to
+ * heuristic search, where states are only ever inserted and looked up, but never erased:
+ *
+ * - Entries are allocated from an arena of chunks that double in size.  Entries never move, such that queues and
+ *   states can refer to an entry by its address.  All entries are freed at once when the map is cleared or destroyed.
+ * - Entries are looked up through an open-addressing hash table with linear probing.  A slot of the table holds only
+ *   32 bits of the hash value and the index of the entry in the arena.  The table is hence compact and keys are only
+ *   compared if their hash values match.
+ *
+ * Iteration visits the entries in the order of insertion. */
+template<
+    typename Key,
+    typename Mapped,
+    typename Hash = std::hash<Key>,
+    typename KeyEqual = std::equal_to<Key>,
+    typename Allocator = std::allocator<std::pair<const Key, Mapped>>
+>
+struct StateMap
+{
+    using key_type = Key;
+    using mapped_type = Mapped;
+    using value_type = std::pair<const Key, Mapped>;
+    using size_type = std::size_t;
+    using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<value_type>;
+
+    private:
+    ///> log2 of the number of entries in the first chunk of the arena
+    static constexpr unsigned LOG2_FIRST_CHUNK_SIZE = 6;
+    ///> log2 of the initial number of slots of the hash table
+    static constexpr unsigned LOG2_INITIAL_CAPACITY = 4;
+
+    ///> a slot of the hash table
+    struct slot
+    {
+        uint32_t tag; ///< 32 bits of the hash value of the entry's key
+        uint32_t index; ///< 1 + the index of the entry in the arena, or 0 if the slot is empty
+    };
+
+    template<bool C>
+    struct the_iterator
+    {
+        friend struct StateMap;
+        friend struct the_iterator<not C>;
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = StateMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<C, const value_type*, value_type*>;
+        using reference = std::conditional_t<C, const value_type&, value_type&>;
+
+        private:
+        using map_pointer = std::conditional_t<C, const StateMap*, StateMap*>;
+
+        map_pointer map_ = nullptr;
+        size_type index_ = 0;
+        pointer entry_ = nullptr;
+        ///> if the iterator is the result of an unsuccessful lookup, the tag and the empty slot where the probe stopped
+        uint32_t tag_ = 0;
+        size_type slot_ = -1UL;
+
+        the_iterator(map_pointer map, size_type index)
+            : map_(map), index_(index), entry_(index < map->size() ? &map->entry(index) : nullptr)
+        { }
+        the_iterator(map_pointer map, uint32_t tag, size_type slot)
+            : map_(map), index_(map->size()), tag_(tag), slot_(slot)
+        { }
+
+        public:
+        the_iterator() = default;
+        the_iterator(const the_iterator&) = default;
+        the_iterator(const the_iterator<false> &other) requires C
+            : map_(other.map_), index_(other.index_), entry_(other.entry_), tag_(other.tag_), slot_(other.slot_)
+        { }
+
+        bool operator==(const the_iterator &other) const { return this->index_ == other.index_; }
+        bool operator!=(const the_iterator &other) const { return not operator==(other); }
+
+        the_iterator & operator++() {
+            ++index_;
+            entry_ = index_ < map_->size() ? &map_->entry(index_) : nullptr;
+            return *this;
+        }
+        the_iterator operator++(int) { the_iterator clone = *this; operator++(); return clone; }
+
+        reference operator*() const { M_notnull(entry_); return *entry_; }
+        pointer operator->() const { M_notnull(entry_); return entry_; }
+    };
+
+    public:
+    using iterator = the_iterator<false>;
+    using const_iterator = the_iterator<true>;
+
+    private:
+    [[no_unique_address]] allocator_type allocator_;
+    [[no_unique_address]] Hash hash_;
+    [[no_unique_address]] KeyEqual equal_;
+    ///> the chunks of the arena; chunk `i` has space for `2^(LOG2_FIRST_CHUNK_SIZE + i)` entries
+    std::vector<value_type*> chunks_;
+    ///> the number of entries
+    size_type size_ = 0;
+    ///> the hash table, with a power of 2 many slots
+    std::vector<slot> table_;
+    ///> log2 of the number of slots of the hash table
+    unsigned log2_capacity_ = 0;
+
+    public:
+    StateMap() = default;
+    StateMap(const StateMap&) = delete;
+    StateMap(StateMap &&other) : StateMap() { swap(*this, other); }
+    ~StateMap() { clear(); }
+
+    StateMap & operator=(StateMap other) { swap(*this, other); return *this; }
+
+    friend void swap(StateMap &first, StateMap &second) {
+        using std::swap;
+        swap(first.allocator_,     second.allocator_);
+        swap(first.hash_,          second.hash_);
+        swap(first.equal_,         second.equal_);
+        swap(first.chunks_,        second.chunks_);
+        swap(first.size_,          second.size_);
+        swap(first.table_,         second.table_);
+        swap(first.log2_capacity_, second.log2_capacity_);
+    }
+
+    size_type size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, size_); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size_); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    /** Returns an iterator to the entry of `key`, or an iterator equal to `end()` if there is no such entry.  The
+     * latter can be passed as hint to `emplace_hint()` to insert `key` without another lookup. */
+    iterator find(const key_type &key) {
+        const uint32_t tag = make_tag(hash_(key));
+        if (table_.empty())
+            return iterator(this, tag, -1UL);
+        const size_type mask = table_.size() - 1;
+        for (size_type pos = home(tag);; pos = (pos + 1) & mask) {
+            const slot &s = table_[pos];
+            if (s.index == 0)
+                return iterator(this, tag, pos);
+            if (s.tag == tag and equal_(entry(s.index - 1).first, key)) [[likely]]
+                return iterator(this, s.index - 1);
+        }
+    }
+    const_iterator find(const key_type &key) const { return const_cast<StateMap*>(this)->find(key); }
+
+    /** Inserts a new entry for `key` that maps to `mapped`.  The `hint` must be the result of an unsuccessful
+     * `find()` of `key` and no entry must have been inserted since.  Returns an iterator to the new entry. */
+    template<typename K, typename M>
+    iterator emplace_hint(const_iterator hint, K &&key, M &&mapped) {
+        M_insist(hint.map_ == this and hint.index_ == size_, "hint must be the result of an unsuccessful lookup");
+        size_type pos = hint.slot_;
+        if ((size_ + 1) * 4 > table_.size() * 3) { // keep load factor at most 3/4
+            grow();
+            pos = probe_empty(hint.tag_);
+        }
+        M_insist(table_[pos].index == 0, "slot must be empty");
+
+        /*----- Allocate and construct the entry in the arena. -----*/
+        const size_type index = size_;
+        if (index == arena_capacity())
+            chunks_.push_back(allocator_.allocate(chunk_size(chunks_.size())));
+        value_type *e = &entry(index);
+        new (e) value_type(std::piecewise_construct,
+                           std::forward_as_tuple(std::forward<K>(key)),
+                           std::forward_as_tuple(std::forward<M>(mapped)));
+        ++size_;
+
+        table_[pos] = slot{ hint.tag_, uint32_t(index + 1) };
+        return iterator(this, index);
+    }
+
+    /** Inserts a new entry for `key` that maps to `mapped`, if there is no entry for `key` yet.  Returns an iterator to
+     * the entry of `key` and whether it was inserted. */
+    template<typename K, typename M>
+    std::pair<iterator, bool> try_emplace(K &&key, M &&mapped) {
+        auto it = find(key);
+        if (it != end())
+            return { it, false };
+        return { emplace_hint(it, std::forward<K>(key), std::forward<M>(mapped)), true };
+    }
+
+    /** Removes all entries and frees the arena. */
+    void clear() {
+        for (size_type i = 0; i != size_; ++i)
+            entry(i).~value_type();
+        for (size_type i = 0; i != chunks_.size(); ++i)
+            allocator_.deallocate(chunks_[i], chunk_size(i));
+        chunks_.clear();
+        size_ = 0;
+        table_.clear();
+        log2_capacity_ = 0;
+    }
+
+    private:
+    static uint32_t make_tag(uint64_t hash) { return hash ^ (hash >> 32); }
+    /** Returns the first slot to probe for `tag`, computed by Fibonacci hashing. */
+    size_type home(uint32_t tag) const { return (tag * 0x9e3779b97f4a7c15UL) >> (64 - log2_capacity_); }
+
+    static size_type chunk_size(size_type chunk) { return 1UL << (LOG2_FIRST_CHUNK_SIZE + chunk); }
+    size_type arena_capacity() const {
+        return ((1UL << chunks_.size()) - 1) << LOG2_FIRST_CHUNK_SIZE;
+    }
+
+    /** Returns the entry at `index` of the arena. */
+    value_type & entry(size_type index) {
+        /* Chunk `i` holds the entries from `(2^i - 1) * 2^LOG2_FIRST_CHUNK_SIZE` on. */
+        const size_type n = (index >> LOG2_FIRST_CHUNK_SIZE) + 1;
+        const unsigned chunk = std::bit_width(n) - 1;
+        const size_type offset = index - (((1UL << chunk) - 1) << LOG2_FIRST_CHUNK_SIZE);
+        M_insist(chunk < chunks_.size() and offset < chunk_size(chunk), "index out of bounds");
+        return chunks_[chunk][offset];
+    }
+    const value_type & entry(size_type index) const { return const_cast<StateMap*>(this)->entry(index); }
+
+    /** Returns the first empty slot on the probe sequence of `tag`. */
+    size_type probe_empty(uint32_t tag) const {
+        const size_type mask = table_.size() - 1;
+        size_type pos = home(tag);
+        while (table_[pos].index != 0)
+            pos = (pos + 1) & mask;
+        return pos;
+    }
+
+    /** Doubles the number of slots of the hash table and reinserts all entries. */
+    void grow() {
+        std::vector<slot> old_table(table_.empty() ? 1UL << LOG2_INITIAL_CAPACITY : 2 * table_.size());
+        swap(old_table, table_);
+        log2_capacity_ = std::countr_zero(table_.size());
+        for (const slot &s : old_table) {
+            if (s.index != 0)
+                table_[probe_empty(s.tag)] = s;
+        }
+    }
+};
+
+
 /** Tracks states and their presence in queues. */
 template<
     heuristic_search_state State,
@@ -163,7 +412,7 @@ struct StateManager
     };
 
     using map_value_type = std::pair<const state_type, StateInfo>;
-    using map_type = std::unordered_map<
+    using map_type = StateMap<
         /* Key=       */ state_type,
         /* Mapped=    */ StateInfo,
         /* Hash=      */ std::hash<state_type>,
@@ -477,6 +726,18 @@ struct StateManager
     bool is_beam_queue_empty() const { return not HasBeamQueue or beam_queue_.empty(); }
     bool queues_empty() const { return is_regular_queue_empty() and is_beam_queue_empty(); }
 
+    /** Returns the state that is returned by the next call to `pop()`, without removing it from its queue. */
+    const state_type & top() const {
+        M_insist(not queues_empty());
+        pointer_type ptr = nullptr;
+        if (HasBeamQueue and not beam_queue_.empty())
+            ptr = beam_queue_.top();
+        else if (HasRegularQueue and not regular_queue_.empty())
+            ptr = regular_queue_.top();
+        M_insist(ptr, "ptr must have been set, the queues must not have been empty");
+        return static_cast<const typename map_type::value_type*>(ptr)->first;
+    }
+
     std::pair<const state_type&, double> pop() {
         M_insist(not queues_empty());
         pointer_type ptr = nullptr;
@@ -602,6 +863,11 @@ struct SearchConfiguration
 
     /** Budget for the maximum number of expansions.  When the budget is exhausted, search stops. */
     OptField<StaticConfig::PerformAnytimeSearch, uint64_t> expansion_budget = std::numeric_limits<uint64_t>::max();
+
+    /** The number of threads to expand states with.  With more than one thread, the search repeatedly removes a batch
+     * of the most promising states from the queues and expands them in parallel.  Expansion, heuristic, and the
+     * `Context` must then be safe to use concurrently. */
+    unsigned num_threads = 1;
 };
 
 template<typename state_type, typename... Context>
@@ -661,7 +927,7 @@ struct genericAStar
 #define DEF_COUNTER(NAME) \
     private: \
     std::size_t num_##NAME##_ = 0; \
-    void inc_##NAME() { ++num_##NAME##_; } \
+    void inc_##NAME() { std::atomic_ref(num_##NAME##_).fetch_add(1, std::memory_order_relaxed); } \
     public: \
     std::size_t num_##NAME() const { return num_##NAME##_; }
 #else
@@ -743,6 +1009,11 @@ struct genericAStar
     }
 
     private:
+    /** Runs the work list algorithm with `num_threads` threads, see `SearchConfiguration::num_threads`. */
+    template<typename Budget>
+    const State & search_in_parallel(Budget &have_budget, heuristic_type &heuristic, expand_type &expand,
+                                     unsigned num_threads, Context&... context);
+
     /*------------------------------------------------------------------------------------------------------------------
      * Helper methods
      *----------------------------------------------------------------------------------------------------------------*/
@@ -880,6 +1151,39 @@ struct genericAStar
         }
     };
 
+    /** Expands the given `state` and collects its successors in `successors`.  May be called concurrently, as long
+     * as the state manager is not modified. */
+    void collect_successors(std::vector<weighted_state> &successors, const state_type &state,
+                            heuristic_type &heuristic, expand_type &expand, Context&... context)
+    {
+        successors.clear();
+        for_each_successor([&successors](state_type successor, double h) {
+            successors.emplace_back(std::move(successor), h);
+        }, state, heuristic, expand, context...);
+    }
+
+    /** Adds the `successors` of a single expanded state to the queues, exactly like `explore_state()`. */
+    void enqueue_successors(std::vector<weighted_state> &successors, expand_type &expand, Context&... context) {
+        if constexpr (use_dynamic_beam_sarch) {
+            candidates.clear();
+            std::swap(candidates, successors);
+            beam_dynamic(expand, context...);
+        } else if constexpr (use_beam_search) {
+            candidates.clear();
+            for (auto &s : successors)
+                beam(std::move(s.state), s.h, context...);
+            for (auto &s : candidates) {
+                if constexpr (has_mark<state_type, Context...>)
+                    expand.reset_marked(s.state, context...);
+                state_manager_.push_beam_queue(std::move(s.state), s.h, context...);
+            }
+        } else {
+            for (auto &s : successors)
+                state_manager_.push_regular_queue(std::move(s.state), s.h, context...);
+        }
+        successors.clear();
+    }
+
     public:
     friend std::ostream & operator<<(std::ostream &out, const genericAStar &AStar) {
         return out << AStar.state_manager_ << ", used cached heuristic value " << AStar.num_cached_heuristic_value()
@@ -940,6 +1244,9 @@ const State & genericAStar<State, Expand, Heuristic, StaticConfig, Context...>::
     /* Initialize queue with initial state. */
     state_manager_.template push<use_beam_search and is_monotone>(std::move(initial_state), 0, context...);
 
+    if (config.num_threads > 1)
+        return search_in_parallel(have_budget, heuristic, expand, config.num_threads, context...);
+
     /* Run work list algorithm. */
     while (not state_manager_.queues_empty() and have_budget()) {
         M_insist(not (is_monotone and use_beam_search) or not state_manager_.is_beam_queue_empty(),
@@ -956,6 +1263,112 @@ const State & genericAStar<State, Expand, Heuristic, StaticConfig, Context...>::
     throw std::logic_error("goal state unreachable from provided initial state");
 }
 
+template<
+    heuristic_search_state State,
+    typename Expand,
+    typename Heuristic,
+    SearchConfigConcept StaticConfig,
+    typename... Context
+>
+requires heuristic_search_heuristic<Heuristic, Context...>
+template<typename Budget>
+const State & genericAStar<State, Expand, Heuristic, StaticConfig, Context...>::search_in_parallel(
+    Budget &have_budget,
+    heuristic_type &heuristic,
+    expand_type &expand,
+    unsigned num_threads,
+    Context&... context
+) {
+    /* The work list algorithm proceeds in rounds.  In each round, the calling thread removes a batch of up to
+     * `num_threads` most promising states from the queues.  Then, all threads -- including the calling thread --
+     * expand one state of the batch each and collect the successors in a thread-local buffer.  Finally, the calling
+     * thread adds the successors to the queues, in the same order as a sequential search expanding the batch.  Thereby,
+     * successors of all threads are pruned against the least path cost found by any thread so far.  The state manager
+     * is hence only modified between the parallel phases, while all threads share it read-only during the parallel
+     * phase, e.g. to look up cached heuristic values.  */
+    std::vector<const state_type*> batch;
+    batch.reserve(num_threads);
+    std::vector<std::vector<weighted_state>> successors(num_threads);
+    std::vector<std::exception_ptr> exceptions(num_threads);
+    bool done = false;
+    std::barrier sync(num_threads);
+
+    auto expand_batch = [&](unsigned tid) {
+        if (tid >= batch.size()) return;
+        try {
+            collect_successors(successors[tid], *batch[tid], heuristic, expand, context...);
+        } catch (...) {
+            exceptions[tid] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(num_threads - 1);
+    for (unsigned tid = 1; tid != num_threads; ++tid) {
+        workers.emplace_back([&, tid]() {
+            for (;;) {
+                sync.arrive_and_wait(); // wait for the next batch
+                if (done) return;
+                expand_batch(tid);
+                sync.arrive_and_wait(); // signal that the batch is expanded
+            }
+        });
+    }
+
+    /* Stop and join the workers when leaving this function, no matter whether by returning or by throwing. */
+    struct stop_workers
+    {
+        bool &done;
+        std::barrier<> &sync;
+        std::vector<std::thread> &workers;
+
+        ~stop_workers() {
+            done = true;
+            sync.arrive_and_wait();
+            for (auto &w : workers)
+                w.join();
+        }
+    } stop{ done, sync, workers };
+
+    for (;;) {
+        /*----- Remove the next batch of states from the queues. -----*/
+        batch.clear();
+        while (batch.size() != num_threads and not state_manager_.queues_empty()) {
+            M_insist(not (is_monotone and use_beam_search) or not state_manager_.is_beam_queue_empty(),
+                     "the beam queue must not run empty with beam search on a monotone search space");
+            /* Only return a goal if it is the most promising state, i.e. if it would be the next state to expand in a
+             * sequential search.  Otherwise, expand the batch first, which may reach the goal on a cheaper path. */
+            const bool is_goal = expand_type::is_goal(state_manager_.top(), context...);
+            if (is_goal and not batch.empty())
+                break;
+            /* Like the sequential search, consume budget for every state removed from the queues, including goals. */
+            if (not have_budget())
+                throw std::logic_error("goal state unreachable from provided initial state");
+            const state_type &state = state_manager_.pop().first;
+            if (is_goal)
+                return state;
+            batch.push_back(&state);
+        }
+        if (batch.empty())
+            break;
+
+        /*----- Expand the batch in parallel. -----*/
+        sync.arrive_and_wait(); // publish the batch
+        expand_batch(0);
+        sync.arrive_and_wait(); // wait for the batch to be expanded
+
+        /*----- Add the successors to the queues. -----*/
+        for (auto &e : exceptions) {
+            if (e)
+                std::rethrow_exception(std::exchange(e, nullptr));
+        }
+        for (std::size_t i = 0; i != batch.size(); ++i)
+            enqueue_successors(successors[i], expand, context...);
+    }
+
+    throw std::logic_error("goal state unreachable from provided initial state");
+}
+
 }
 
 }
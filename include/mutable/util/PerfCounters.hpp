@@ -0,0 +1,81 @@
+#pragma once
+
+#include <mutable/util/macro.hpp>
+#include <array>
+#include <cstdint>
+
+
+namespace m {
+
+#define M_PERF_COUNTER_LIST(X) \
+    X(CYCLES,        "cycles") \
+    X(INSTRUCTIONS,  "instructions") \
+    X(LLC_MISSES,    "LLC misses") \
+    X(BRANCH_MISSES, "branch misses") \
+    X(DTLB_MISSES,   "dTLB misses")
+
+/** Hardware performance counters of the *calling thread*, measured via `perf_event_open(2)`.  Counters that are not
+ * supported by the hardware or that may not be accessed, e.g. due to `/proc/sys/kernel/perf_event_paranoid`, are
+ * reported as `UNAVAILABLE`.  On systems other than Linux, all counters are unavailable.  Since counters are per
+ * thread, `Timer` measurements only count the thread executing the query; worker threads, e.g. for SPN learning or a
+ * parallel heuristic search, are excluded.  */
+struct PerfCounters
+{
+    enum counter_t : unsigned {
+#define M_PERF_COUNTER_ENUM(NAME, _) NAME,
+        M_PERF_COUNTER_LIST(M_PERF_COUNTER_ENUM)
+#undef M_PERF_COUNTER_ENUM
+        NUM_COUNTERS
+    };
+
+    using values_type = std::array<uint64_t, NUM_COUNTERS>;
+
+    /** The value of a counter that cannot be measured. */
+    static constexpr uint64_t UNAVAILABLE = uint64_t(-1);
+
+    /** Returns a human-readable name of counter `c`. */
+    static const char * name(counter_t c) {
+        static constexpr const char *NAMES[] = {
+#define M_PERF_COUNTER_NAME(_, NAME) NAME,
+            M_PERF_COUNTER_LIST(M_PERF_COUNTER_NAME)
+#undef M_PERF_COUNTER_NAME
+        };
+        M_insist(c < NUM_COUNTERS);
+        return NAMES[c];
+    }
+
+    private:
+    std::array<int, NUM_COUNTERS> fds_; ///< the file descriptors of the counters, -1 if unavailable
+
+    PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+
+    public:
+    ~PerfCounters();
+
+    /** Returns the counters of the calling thread.  The counters are opened on first use per thread. */
+    static PerfCounters & Get();
+
+    /** Returns `true` iff counter `c` can be measured. */
+    bool available(counter_t c) const { return fds_[c] >= 0; }
+    /** Returns `true` iff at least one counter can be measured. */
+    bool any_available() const {
+        for (auto fd : fds_)
+            if (fd >= 0) return true;
+        return false;
+    }
+
+    /** Reads the current values of all counters.  Values are scaled to compensate for multiplexing of counters by
+     * the kernel. */
+    values_type read() const;
+
+    /** Returns the difference `end - begin` for every counter, preserving `UNAVAILABLE`. */
+    static values_type difference(const values_type &begin, const values_type &end) {
+        values_type res;
+        for (unsigned i = 0; i != NUM_COUNTERS; ++i)
+            res[i] = begin[i] == UNAVAILABLE or end[i] == UNAVAILABLE ? UNAVAILABLE : end[i] - begin[i];
+        return res;
+    }
+};
+
+}
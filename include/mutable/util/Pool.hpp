@@ -1,13 +1,20 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <functional>
+#include <iterator>
+#include <memory>
 #include <mutable/util/fn.hpp>
 #include <mutable/util/macro.hpp>
 #include <mutable/util/OptField.hpp>
 #include <mutable/util/reader_writer_lock.hpp>
+#include <mutex>
 #include <type_traits>
-#include <unordered_map>
 #include <utility>
+#include <vector>
 
 
 namespace m {
@@ -16,13 +23,263 @@ namespace m {
 template<typename T, typename Pool, bool CanBeNone = false>
 struct Pooled;
 
-/** The `PODPool` implements an implicitly garbage-collected set of *pooled* (or *internalized*) POD struct entities. */
+namespace detail {
+
+/** An insert-only hash table of heap-allocated entries, used by the pools to intern entities.  Lookups are lock-free:
+ * they never write to shared memory and hence scale with the number of concurrently interning threads.  If \tparam
+ * ThreadSafe, the table is split into shards by hash value and insertions into a shard are serialized by a mutex per
+ * shard.
+ *
+ * Each shard is an open-addressing table with linear probing, whose slots hold the hash value and a pointer to the
+ * entry.  An insertion publishes the entry with a single release-store to an empty slot.  Growing a shard publishes a
+ * new slot array; concurrent lookups on the replaced array still see a valid subset of the entries, and a lookup that
+ * misses is repeated under the shard's mutex before inserting.  Since entries are never erased, replaced slot arrays
+ * are retired and reclaimed together with the table, which bounds the retired memory by the size of the current
+ * arrays.
+ *
+ * Entries are owned by the table and destroyed with it. */
+template<typename Entry, bool ThreadSafe>
+struct InternTable
+{
+    using entry_type = Entry;
+
+    ///> log2 of the number of shards; the shard of an entry is chosen by the top bits of its mixed hash value
+    static constexpr unsigned LOG2_NUM_SHARDS = ThreadSafe ? 6 : 0;
+    static constexpr std::size_t NUM_SHARDS = 1UL << LOG2_NUM_SHARDS;
+    ///> the initial number of slots of a shard
+    static constexpr std::size_t INITIAL_CAPACITY = 16;
+
+    private:
+    ///> a slot of a shard
+    struct slot
+    {
+        uint64_t hash; ///< the hash value of the entry, written before the entry is published
+        std::atomic<Entry*> entry{nullptr}; ///< the entry, or `nullptr` if the slot is empty
+    };
+
+    ///> an array of slots, with a power of 2 many slots
+    struct slot_array
+    {
+        std::size_t mask; ///< the number of slots minus 1
+        std::unique_ptr<slot[]> slots;
+
+        explicit slot_array(std::size_t capacity) : mask(capacity - 1), slots(new slot[capacity]) {
+            M_insist(is_pow_2(capacity));
+        }
+
+        std::size_t capacity() const { return mask + 1; }
+    };
+
+    struct alignas(64) shard
+    {
+        std::atomic<slot_array*> slots{nullptr}; ///< the current slot array, read by lock-free lookups
+        std::atomic<std::size_t> size{0}; ///< the number of entries
+        std::vector<std::unique_ptr<slot_array>> arrays; ///< the current and all retired slot arrays
+        mutable OptField<ThreadSafe, std::mutex> mutex; ///< serializes insertions
+        OptField<ThreadSafe, lock_contention> contention; ///< contention of `mutex`, guarded by `mutex`
+    };
+
+    std::array<shard, NUM_SHARDS> shards_;
+
+    public:
+    struct const_iterator
+    {
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Entry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Entry*;
+        using reference = const Entry&;
+
+        private:
+        const InternTable *table_ = nullptr;
+        std::size_t shard_ = NUM_SHARDS;
+        const slot_array *array_ = nullptr; ///< the slot array of the current shard
+        std::size_t slot_ = 0;
+
+        public:
+        const_iterator() = default;
+        const_iterator(const InternTable *table, std::size_t shard) : table_(table), shard_(shard) { skip_empty(); }
+
+        bool operator==(const const_iterator &other) const {
+            return this->shard_ == other.shard_ and this->slot_ == other.slot_;
+        }
+        bool operator!=(const const_iterator &other) const { return not operator==(other); }
+
+        const_iterator & operator++() { ++slot_; skip_empty(); return *this; }
+        const_iterator operator++(int) { const_iterator clone = *this; operator++(); return clone; }
+
+        reference operator*() const { return *operator->(); }
+        pointer operator->() const { return array_->slots[slot_].entry.load(std::memory_order_acquire); }
+
+        private:
+        /** Advances to the next occupied slot, or to the end. */
+        void skip_empty() {
+            for (; shard_ != NUM_SHARDS; ++shard_, slot_ = 0) {
+                array_ = table_->shards_[shard_].slots.load(std::memory_order_acquire);
+                if (not array_) continue;
+                for (; slot_ != array_->capacity(); ++slot_) {
+                    if (array_->slots[slot_].entry.load(std::memory_order_acquire))
+                        return;
+                }
+            }
+            array_ = nullptr;
+            slot_ = 0;
+        }
+    };
+
+    InternTable() = default;
+    explicit InternTable(std::size_t initial_capacity) {
+        /* Size the shards such that `initial_capacity` entries fit without growing. */
+        const std::size_t per_shard = (initial_capacity + NUM_SHARDS - 1) / NUM_SHARDS;
+        const std::size_t capacity = std::max(INITIAL_CAPACITY, std::bit_ceil(per_shard * 4 / 3 + 1));
+        for (auto &S : shards_)
+            install(S, std::make_unique<slot_array>(capacity));
+    }
+    InternTable(const InternTable&) = delete;
+
+    ~InternTable() {
+        for (auto &S : shards_) {
+            if (const slot_array *A = S.slots.load(std::memory_order_relaxed)) {
+                for (std::size_t i = 0; i != A->capacity(); ++i)
+                    delete A->slots[i].entry.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /** Returns the number of entries.  Concurrent insertions may or may not be accounted for. */
+    std::size_t size() const {
+        std::size_t n = 0;
+        for (auto &S : shards_)
+            n += S.size.load(std::memory_order_relaxed);
+        return n;
+    }
+
+    /** Returns an iterator to the first entry.  Iteration must not run concurrently to insertions. */
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(); }
+
+    /** Returns the entry with hash value \p hash for which \p is_match returns `true`, or `nullptr` if there is no such
+     * entry.  Does not acquire any lock. */
+    template<typename Pred>
+    Entry * find(uint64_t hash, Pred &&is_match) const {
+        const uint64_t mixed = murmur3_64(hash);
+        return find_in(shard_of(mixed).slots.load(std::memory_order_acquire), hash, mixed, is_match);
+    }
+
+    /** Returns the entry with hash value \p hash for which \p is_match returns `true`.  If there is no such entry,
+     * calls \p make to create a new entry, inserts it, and returns it.  \p make must return a pointer to an entry
+     * allocated with `new` and the new entry must match. */
+    template<typename Pred, typename Make>
+    Entry * find_or_insert(uint64_t hash, Pred &&is_match, Make &&make) {
+        const uint64_t mixed = murmur3_64(hash);
+        shard &S = shard_of(mixed);
+        if (Entry *e = find_in(S.slots.load(std::memory_order_acquire), hash, mixed, is_match))
+            return e; // fast path
+
+        std::unique_lock<std::mutex> lock;
+        if constexpr (ThreadSafe) {
+            lock = std::unique_lock<std::mutex>(*S.mutex, std::defer_lock);
+            lock_contention::acquisition A;
+            A.lock(lock);
+            A.acquired(*S.contention);
+        }
+
+        /* Repeat the lookup, since the entry may have been inserted concurrently. */
+        slot_array *A = S.slots.load(std::memory_order_relaxed);
+        if (Entry *e = find_in(A, hash, mixed, is_match))
+            return e;
+
+        const std::size_t size = S.size.load(std::memory_order_relaxed);
+        if (not A or (size + 1) * 4 > A->capacity() * 3) // keep load factor at most 3/4
+            A = grow(S);
+
+        std::unique_ptr<Entry> e(make());
+        std::size_t pos = mixed & A->mask;
+        while (A->slots[pos].entry.load(std::memory_order_relaxed))
+            pos = (pos + 1) & A->mask;
+        A->slots[pos].hash = hash;
+        A->slots[pos].entry.store(e.get(), std::memory_order_release); // publish
+        S.size.store(size + 1, std::memory_order_relaxed);
+        return e.release();
+    }
+
+    /** Returns statistics about the contention of inserting into this table, summed over all shards. */
+    lock_contention contention() const requires ThreadSafe {
+        lock_contention sum;
+        for (auto &S : shards_) {
+            std::unique_lock lock{*S.mutex};
+            const lock_contention &C = *S.contention;
+            sum.num_acquisitions += C.num_acquisitions;
+            sum.num_contended += C.num_contended;
+            sum.wait_time += C.wait_time;
+        }
+        return sum;
+    }
+    /** Resets the statistics about the contention of inserting into this table. */
+    void reset_contention() requires ThreadSafe {
+        for (auto &S : shards_) {
+            std::unique_lock lock{*S.mutex};
+            *S.contention = lock_contention();
+        }
+    }
+
+    private:
+    shard & shard_of(uint64_t mixed) { return shards_[LOG2_NUM_SHARDS ? mixed >> (64 - LOG2_NUM_SHARDS) : 0]; }
+    const shard & shard_of(uint64_t mixed) const { return const_cast<InternTable*>(this)->shard_of(mixed); }
+
+    template<typename Pred>
+    static Entry * find_in(const slot_array *A, uint64_t hash, uint64_t mixed, Pred &is_match) {
+        if (not A) return nullptr;
+        for (std::size_t pos = mixed & A->mask;; pos = (pos + 1) & A->mask) {
+            Entry *e = A->slots[pos].entry.load(std::memory_order_acquire);
+            if (not e) return nullptr;
+            if (A->slots[pos].hash == hash and is_match(*e)) return e;
+        }
+    }
+
+    /** Publishes \p A as the current slot array of \p S.  Requires exclusive access to \p S. */
+    static slot_array * install(shard &S, std::unique_ptr<slot_array> A) {
+        slot_array *ptr = A.get();
+        S.arrays.emplace_back(std::move(A));
+        S.slots.store(ptr, std::memory_order_release);
+        return ptr;
+    }
+
+    /** Replaces the slot array of \p S by one of twice the capacity and returns it.  The replaced array is retired but
+     * not freed, as concurrent lookups may still read it.  Requires exclusive access to \p S. */
+    static slot_array * grow(shard &S) {
+        const slot_array *old = S.slots.load(std::memory_order_relaxed);
+        if (not old)
+            return install(S, std::make_unique<slot_array>(INITIAL_CAPACITY));
+        auto A = std::make_unique<slot_array>(2 * old->capacity());
+        for (std::size_t i = 0; i != old->capacity(); ++i) {
+            Entry *e = old->slots[i].entry.load(std::memory_order_relaxed);
+            if (not e) continue;
+            const uint64_t hash = old->slots[i].hash;
+            std::size_t pos = murmur3_64(hash) & A->mask;
+            while (A->slots[pos].entry.load(std::memory_order_relaxed))
+                pos = (pos + 1) & A->mask;
+            A->slots[pos].hash = hash;
+            A->slots[pos].entry.store(e, std::memory_order_relaxed);
+        }
+        return install(S, std::move(A)); // the release-store publishes the copied slots
+    }
+};
+
+}
+
+/** The `PODPool` implements an implicitly garbage-collected set of *pooled* (or *internalized*) POD struct entities.
+ *
+ * If \tparam ThreadSafe, the pool can be used concurrently.  Lookups of already pooled entities are lock-free.  A
+ * thread-safe pool does not count references to its entities, such that copying a `Pooled` does not write to shared
+ * memory. */
 template<typename T, typename Hash = std::hash<T>, typename KeyEqual = std::equal_to<T>, typename Copy = std::identity,
          bool ThreadSafe = false>
 struct PODPool
 {
-    using counter_type = std::conditional_t<ThreadSafe, std::atomic<uint32_t>, uint32_t>;
-    using table_type = std::unordered_map<T, counter_type, Hash, KeyEqual>;
+    ///> the pooled entity and its reference count; the count is only maintained if `is_refcounted`
+    using entry_type = std::pair<const T, uint32_t>;
+    using table_type = detail::InternTable<entry_type, ThreadSafe>;
     using pooled_type = T;
     using proxy_type = Pooled<T, PODPool, false>;
     using proxy_optional_type = Pooled<T, PODPool, true>;
@@ -34,11 +291,11 @@ struct PODPool
     friend struct Pooled;
 
     static constexpr bool is_thread_safe = ThreadSafe;
+    ///> whether `Pooled` instances count the references to their pooled entity
+    static constexpr bool is_refcounted = not ThreadSafe;
 
     private:
-    table_type table_;
-
-    alignas(64) mutable OptField<ThreadSafe, reader_writer_mutex> table_mutex_;
+    mutable table_type table_;
 
     public:
     using const_iterator = table_type::const_iterator;
@@ -48,16 +305,23 @@ struct PODPool
     PODPool(std::size_t initial_capacity) : table_(initial_capacity) { }
     virtual ~PODPool() {
 #ifndef NDEBUG
-        for (auto& [_, count] : table_)
-            M_insist(count == 0, "deleting would create a dangling reference to pooled object");
+        if constexpr (is_refcounted) {
+            for (auto& [_, count] : table_)
+                M_insist(count == 0, "deleting would create a dangling reference to pooled object");
+        }
 #endif
     }
 
     /** Returns the number of elements in the pool. */
     std::size_t size() const { return table_.size(); }
 
-    const_iterator begin() { return table_.cbegin(); }
-    const_iterator end() { return table_.cend(); }
+    /** Returns statistics about the contention of inserting into this pool. */
+    lock_contention contention() const requires ThreadSafe { return table_.contention(); }
+    /** Resets the statistics about the contention of inserting into this pool. */
+    void reset_contention() const requires ThreadSafe { table_.reset_contention(); }
+
+    const_iterator begin() { return table_.begin(); }
+    const_iterator end() { return table_.end(); }
     const_iterator cbegin() const { return table_.begin(); }
     const_iterator cend() const { return table_.end(); }
 
@@ -69,38 +333,15 @@ struct PODPool
     /** Returns a reference to the value referenced by \param pooled. */
     template<bool CanBeNone>
     static const T & Get(const Pooled<T, PODPool, CanBeNone> &pooled);
-
-    /** Erases the pooled entity from the pool.  Requires that the reference count is `0`. */
-    template<bool CanBeNone>
-    bool erase(const Pooled<T, PODPool, CanBeNone> &pooled);
 };
 
 /** A pool implements an implicitly garbage-collected set of instances of a class hierarchy. */
 template<typename T, typename Hash = std::hash<T>, typename KeyEqual = std::equal_to<T>, bool ThreadSafe = false>
 struct Pool
 {
-    struct dereference_hash
-    {
-        ///> Mark this callable as *transparent*, allowing for computing the hash of various types that are
-        ///interoperable. > See https://en.cppreference.com/w/cpp/container/unordered_map/find.
-        using is_transparent = void;
-
-        template<typename U>
-        auto operator()(U &&u) const { return Hash{}(*u); }
-    };
-
-    struct dereference_equal_to
-    {
-        ///> Mark this callable as *transparent*, allowing for comparing various types that are interoperable. > See
-        ///https://en.cppreference.com/w/cpp/container/unordered_map/find.
-        using is_transparent = void;
-
-        template<typename U, typename V>
-        auto operator()(U &&first, V &&second) const { return KeyEqual{}(*first, *second); }
-    };
-
-    using counter_type = std::conditional_t<ThreadSafe, std::atomic<uint32_t>, uint32_t>;
-    using table_type = std::unordered_map<std::unique_ptr<T>, counter_type, dereference_hash, dereference_equal_to>;
+    ///> the pooled entity and its reference count; the count is only maintained if `is_refcounted`
+    using entry_type = std::pair<const std::unique_ptr<T>, uint32_t>;
+    using table_type = detail::InternTable<entry_type, ThreadSafe>;
     using pooled_type = T;
     template<typename U> using proxy_type = Pooled<U, Pool, false>;
     template<typename U> using proxy_optional_type = Pooled<U, Pool, true>;
@@ -111,11 +352,11 @@ struct Pool
     friend struct Pooled;
 
     static constexpr bool is_thread_safe = ThreadSafe;
+    ///> whether `Pooled` instances count the references to their pooled entity
+    static constexpr bool is_refcounted = not ThreadSafe;
 
     private:
-    table_type table_;
-
-    alignas(64) mutable OptField<ThreadSafe, reader_writer_mutex> table_mutex_;
+    mutable table_type table_;
 
     public:
     using const_iterator = table_type::const_iterator;
@@ -125,10 +366,9 @@ struct Pool
     Pool(std::size_t initial_capacity) : table_(initial_capacity) { }
     ~Pool() {
 #ifndef NDEBUG
-        /* Manually delete all entries and make sure we don't have any dangling references. */
-        while (not table_.empty()) {
-            typename table_type::node_type nh = table_.extract(table_.begin());
-            M_insist(nh.mapped() == 0, "deleting would create a dangling reference to pooled object");
+        if constexpr (is_refcounted) {
+            for (auto& [_, count] : table_)
+                M_insist(count == 0, "deleting would create a dangling reference to pooled object");
         }
 #endif
     }
@@ -136,8 +376,13 @@ struct Pool
     /** Returns the number of elements in the pool. */
     std::size_t size() const { return table_.size(); }
 
-    const_iterator begin() { return table_.cbegin(); }
-    const_iterator end() { return table_.cend(); }
+    /** Returns statistics about the contention of inserting into this pool. */
+    lock_contention contention() const requires ThreadSafe { return table_.contention(); }
+    /** Resets the statistics about the contention of inserting into this pool. */
+    void reset_contention() const requires ThreadSafe { table_.reset_contention(); }
+
+    const_iterator begin() { return table_.begin(); }
+    const_iterator end() { return table_.end(); }
     const_iterator cbegin() const { return table_.begin(); }
     const_iterator cend() const { return table_.end(); }
 
@@ -151,10 +396,6 @@ struct Pool
     template<typename U, bool CanBeNone>
     requires std::derived_from<U, T>
     static const U & Get(const Pooled<U, Pool, CanBeNone> &pooled);
-
-    /** Erases the pooled entity from the pool.  Requires that the reference count is `0`. */
-    template<typename U, bool CanBeNone>
-    bool erase(const Pooled<U, Pool, CanBeNone> &pooled);
 };
 
 /**
@@ -169,7 +410,7 @@ struct Pooled
     ///> Can this `Pooled` *not* reference an object?
     static constexpr bool can_be_none = CanBeNone;
 
-    using value_type = typename Pool::table_type::value_type;
+    using value_type = typename Pool::entry_type;
 
     ///> \tparam Pool needs access to private c'tor
     friend Pool;
@@ -193,7 +434,9 @@ struct Pooled
     /** Constucts a fresh `Pooled` from a pooled \param value and its owning \param pool. */
     Pooled(Pool *pool, value_type *value) : pool_(pool), ref_(value) {
         M_insist(bool(pool_) == bool(ref_), "inconsistent pooled state");
-        if constexpr (CanBeNone) {
+        if constexpr (not Pool::is_refcounted) {
+            M_insist(CanBeNone or ref_);
+        } else if constexpr (CanBeNone) {
             if (ref_) ++ref_->second;  // increase reference count
         } else {
             ++M_notnull(ref_)->second;  // increase reference count
@@ -246,16 +489,16 @@ struct Pooled
      * Returns the number of references to the pooled object or 0 if
      * this `Pooled` CanBeNone and does *not* hold a reference to an object.
      */
-    uint32_t count() const { return ref_ ? uint32_t(ref_->second) : 0; }
+    uint32_t count() const requires Pool::is_refcounted { return ref_ ? ref_->second : 0; }
 
     ~Pooled() {
         M_insist(bool(pool_) == bool(ref_), "inconsistent pooled state");
-        if (ref_) {
-            M_insist(ref_->second > 0, "underflow reference count");
-            if (--ref_->second == 0)
+        if constexpr (Pool::is_refcounted) {
+            if (ref_) {
+                M_insist(ref_->second > 0, "underflow reference count");
+                --ref_->second;
                 /* TODO: free object in pool, as it is not referenced anymore */
-                // pool_->erase(*this);
-                ;
+            }
         }
     }
 
@@ -321,9 +564,10 @@ struct Pooled
     }
 
     void dump(std::ostream &out) const {
-        out << *this
-            << " (" << &Pool::Get(*this) << ")"
-            << " count: " << this->count() << std::endl;
+        out << *this << " (" << &Pool::Get(*this) << ")";
+        if constexpr (Pool::is_refcounted)
+            out << " count: " << this->count();
+        out << std::endl;
     }
     void dump() const { dump(std::cerr); }
 };
@@ -332,41 +576,11 @@ template<typename T, typename Hash, typename KeyEqual, typename Copy, bool Threa
 template<typename U>
 PODPool<T, Hash, KeyEqual, Copy, ThreadSafe>::proxy_type PODPool<T, Hash, KeyEqual, Copy, ThreadSafe>::operator()(U &&u)
 {
-    if constexpr (ThreadSafe) {
-        reader_writer_lock lock{table_mutex_};
-        typename table_type::iterator it;
-        do {
-            lock.lock_read();
-            it = table_.find(u);
-            if (it != table_.end())
-                return proxy_type{this, &*it};
-        } while (not lock.upgrade());
-        M_insist(lock.owns_write_lock());
-        it = table_.emplace_hint(it, Copy{}(std::forward<U>(u)), 0); // perfect forwarding
-        return proxy_type{this, &*it};
-    } else {
-        auto it = table_.find(u);
-        if (it == table_.end())
-            it = table_.emplace_hint(it, Copy{}(std::forward<U>(u)), 0); // perfect forwarding
-        return proxy_type{this, &*it};
-    }
-}
-
-template<typename T, typename Hash, typename KeyEqual, typename Copy, bool ThreadSafe>
-template<bool CanBeNone>
-bool PODPool<T, Hash, KeyEqual, Copy, ThreadSafe>::erase(const Pooled<T, PODPool, CanBeNone> &pooled)
-{
-    M_insist(pooled.ref_, "cannot erase w/o valid reference");
-    if constexpr (ThreadSafe) {
-        write_lock lock{table_mutex_};
-        if (pooled.ref_->second != 0) return false;  // entity was concurrently pooled
-        table_.erase(pooled.ref_->first);
-        return true;
-    } else {
-        M_insist(pooled.ref_->second == 0, "reference count must be 0 to erase");
-        table_.erase(pooled.ref_->first);
-        return true;
-    }
+    auto is_match = [&u](const entry_type &e) -> bool { return KeyEqual{}(e.first, u); };
+    entry_type *e = table_.find_or_insert(Hash{}(u), is_match, [&u]() {
+        return new entry_type(Copy{}(std::forward<U>(u)), 0); // perfect forwarding
+    });
+    return proxy_type{this, e};
 }
 
 template<typename T, typename Hash, typename KeyEqual, typename Copy, bool ThreadSafe>
@@ -382,41 +596,11 @@ template<typename U>
 requires std::derived_from<U, T>
 Pool<T, Hash, KeyEqual, ThreadSafe>::proxy_type<U> Pool<T, Hash, KeyEqual, ThreadSafe>::operator()(U &&u)
 {
-    if constexpr (ThreadSafe) {
-        reader_writer_lock lock{table_mutex_};
-        typename table_type::iterator it;
-        do {
-            lock.lock_read();
-            it = table_.find(&u);
-            if (it != table_.end())
-                return proxy_type<U>{this, &*it};
-        } while (not lock.upgrade());
-        M_insist(lock.owns_write_lock());
-        it = table_.emplace_hint(it, as<T>(std::make_unique<U>(std::forward<U>(u))), 0); // perfect forwarding
-        return proxy_type<U>{this, &*it};
-    } else {
-        auto it = table_.find(&u);
-        if (it == table_.end())
-            it = table_.emplace_hint(it, as<T>(std::make_unique<U>(std::forward<U>(u))), 0); // perfect forwarding
-        return proxy_type<U>{this, &*it};
-    }
-}
-
-template<typename T, typename Hash, typename KeyEqual, bool ThreadSafe>
-template<typename U, bool CanBeNone>
-bool Pool<T, Hash, KeyEqual, ThreadSafe>::erase(const Pooled<U, Pool, CanBeNone> &pooled)
-{
-    M_insist(pooled.ref_, "cannot erase w/o valid reference");
-    if constexpr (ThreadSafe) {
-        write_lock lock{table_mutex_};  // acquire write lock
-        if (pooled.ref_->second != 0) return false;  // entity was concurrently pooled
-        table_.erase(pooled.ref_->first);
-        return true;
-    } else {
-        M_insist(pooled.ref_->second == 0, "reference count must be 0 to erase");
-        table_.erase(pooled.ref_->first);
-        return true;
-    }
+    auto is_match = [&u](const entry_type &e) -> bool { return KeyEqual{}(*e.first, u); };
+    entry_type *e = table_.find_or_insert(Hash{}(u), is_match, [&u]() {
+        return new entry_type(as<T>(std::make_unique<U>(std::forward<U>(u))), 0); // perfect forwarding
+    });
+    return proxy_type<U>{this, e};
 }
 
 template<typename T, typename Hash, typename KeyEqual, bool ThreadSafe>
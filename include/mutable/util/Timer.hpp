@@ -2,10 +2,13 @@
 
 #include <mutable/util/fn.hpp>
 #include <mutable/util/macro.hpp>
+#include <mutable/util/PerfCounters.hpp>
+#include <mutable/util/Tracer.hpp>
 #include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -39,11 +42,15 @@ struct Timer
     using clock = std::chrono::high_resolution_clock;
     using duration = clock::duration;
     using time_point = clock::time_point;
+    static_assert(std::is_same_v<clock, Tracer::clock>, "measurements must be traceable");
 
     struct Measurement
     {
         std::string name; ///< the name of this `Measurement`
         time_point begin, end; ///< the begin and end time points of this `Measurement`
+        bool with_counters = false; ///< whether this `Measurement` records hardware performance counters
+        ///> the readings of the hardware performance counters at begin and end of this `Measurement`
+        PerfCounters::values_type counters_begin, counters_end;
 
         explicit Measurement(std::string name, time_point begin = time_point(), time_point end = time_point())
             : name(std::move(name))
@@ -52,17 +59,26 @@ struct Timer
         { }
 
         /** Clear this `Measurement`, rendering it unused. */
-        void clear() { begin = end = time_point(); }
+        void clear() { begin = end = time_point(); with_counters = false; }
 
-        /** Start this `Measurement` by setting the start time point to *NOW*. */
-        void start() {
+        /** Start this `Measurement` by setting the start time point to *NOW*.  If `with_counters`, additionally
+         * records the hardware performance counters of the calling thread.  The counters are read *before* taking the
+         * start time point, such that opening them on first use is not part of the measured time.  Only the calling
+         * thread is measured; work offloaded to other threads is not counted. */
+        void start(bool with_counters = false) {
             M_insist(is_unused());
+            this->with_counters = with_counters;
+            if (with_counters)
+                counters_begin = PerfCounters::Get().read();
             begin = clock::now();
         }
 
-        /** Stop this `Measurement` by setting the end time point to *NOW*. */
+        /** Stop this `Measurement` by setting the end time point to *NOW*.  Must be called by the thread that started
+         * this `Measurement` to record hardware performance counters correctly. */
         void stop() {
             M_insist(is_active());
+            if (with_counters)
+                counters_end = PerfCounters::Get().read();
             end = clock::now();
         }
 
@@ -87,6 +103,17 @@ struct Timer
             return end - begin;
         }
 
+        /** Returns `true` iff this `Measurement` recorded hardware performance counters. */
+        bool has_counters() const { return with_counters; }
+
+        /** Returns the hardware performance counters of a *finished* `Measurement`.  Counters that could not be
+         * measured are `PerfCounters::UNAVAILABLE`. */
+        PerfCounters::values_type counters() const {
+            M_insist(is_finished(), "can only compute counters of finished measurements");
+            M_insist(has_counters(), "measurement did not record counters");
+            return PerfCounters::difference(counters_begin, counters_end);
+        }
+
         friend std::ostream & operator<<(std::ostream &out, const Measurement &M);
         void dump(std::ostream &out) const;
         void dump() const;
@@ -94,6 +121,7 @@ struct Timer
 
     private:
     std::vector<Measurement> measurements_;
+    bool perf_counters_ = false; ///< whether new `Measurement`s record hardware performance counters
 
     public:
     auto begin() const { return measurements_.cbegin(); }
@@ -118,6 +146,11 @@ struct Timer
     /** Erase all `Measurement`s from this `Timer`. */
     void clear() { measurements_.clear(); }
 
+    /** Returns `true` iff new `Measurement`s record hardware performance counters. */
+    bool perf_counters() const { return perf_counters_; }
+    /** Sets whether new `Measurement`s record hardware performance counters. */
+    void perf_counters(bool enable) { perf_counters_ = enable; }
+
     private:
     /** Start a new `Measurement` with the name `name`.  Returns the ID assigned to that `Measurement`. */
     std::size_t start(std::string name) {
@@ -128,13 +161,13 @@ struct Timer
             if (it->is_active())
                 throw m::invalid_argument("a measurement with that name is already in progress");
             const auto idx = std::distance(measurements_.begin(), it);
-            it->end = time_point();
-            it->begin = clock::now();
+            it->clear();
+            it->start(perf_counters_);
             return idx;
         } else { // create new measurement
             auto id = measurements_.size();
             auto &M = measurements_.emplace_back(name);
-            M.start();
+            M.start(perf_counters_);
             return id;
         }
     }
@@ -145,8 +178,13 @@ struct Timer
         auto &M = measurements_[id];
         M_insist(not M.has_ended(), "cannot stop that measurement because it has already been stopped");
         M.stop();
+        if (Tracer::Get().enabled())
+            trace(M);
     }
 
+    /** Records the finished `Measurement` \p M as span of the calling thread with the `Tracer`. */
+    static void trace(const Measurement &M);
+
     public:
     /** Creates a new `TimingProcess` with the given `name`. */
     TimingProcess create_timing(std::string name) { return TimingProcess(*this, /* ID= */ start(name)); }
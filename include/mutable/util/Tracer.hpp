@@ -0,0 +1,107 @@
+#pragma once
+
+#include <mutable/mutable-config.hpp>
+#include <mutable/util/macro.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace m {
+
+/** Records *spans*, i.e. named intervals of time on a particular thread, of the whole process and exports them in the
+ * Chrome trace event format.  The exported JSON can be viewed offline, e.g. with `chrome://tracing` or the Perfetto UI
+ * at https://ui.perfetto.dev.  Spans on the same thread that are contained in each other are shown nested.
+ *
+ * Tracing is disabled by default.  While disabled, recording a span is a no-op.  All methods are thread-safe. */
+struct M_EXPORT Tracer
+{
+    using clock = std::chrono::high_resolution_clock;
+    using time_point = clock::time_point;
+    ///> additional, numeric arguments of a span, shown when selecting the span
+    using args_type = std::vector<std::pair<std::string, uint64_t>>;
+
+    /** A recorded span. */
+    struct event
+    {
+        std::string name; ///< the name of the span
+        const char *category; ///< the category of the span, used to filter spans in the trace viewer
+        unsigned tid; ///< the ID of the thread the span was recorded on, see `Tracer::thread_id()`
+        time_point begin, end; ///< begin and end of the span
+        args_type args; ///< additional arguments of the span
+    };
+
+    /** Records a span from its construction to its destruction or a call to `end()`, whichever comes first. */
+    struct Span
+    {
+        friend struct Tracer;
+
+        private:
+        std::string name_; ///< the name of the span
+        const char *category_; ///< the category of the span
+        time_point begin_; ///< the begin of the span, `time_point()` if tracing was disabled or the span has ended
+
+        Span(std::string name, const char *category);
+
+        public:
+        Span(const Span&) = delete;
+        Span(Span &&other)
+            : name_(std::move(other.name_))
+            , category_(other.category_)
+            , begin_(std::exchange(other.begin_, time_point()))
+        { }
+        ~Span() { end(); }
+
+        /** Ends the span, if not ended before, and records it. */
+        void end(args_type args = args_type());
+    };
+
+    private:
+    std::atomic<bool> enabled_ = false; ///< whether spans are recorded
+    const time_point origin_ = clock::now(); ///< the point in time all timestamps of the trace are relative to
+    mutable std::mutex mutex_; ///< protects `events_` and `thread_names_`
+    std::vector<event> events_; ///< the recorded spans
+    std::vector<std::pair<unsigned, std::string>> thread_names_; ///< names of threads, shown in the trace viewer
+
+    Tracer() = default;
+    Tracer(const Tracer&) = delete;
+
+    public:
+    /** Returns the process-wide tracer. */
+    static Tracer & Get();
+
+    /** Returns a small, unique ID of the calling thread.  IDs are assigned in the order in which threads first ask for
+     * their ID, starting at 1. */
+    static unsigned thread_id();
+
+    /** Returns `true` iff spans are recorded. */
+    bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+    /** Sets whether spans are recorded. */
+    void enabled(bool enable) { enabled_.store(enable, std::memory_order_relaxed); }
+
+    /** Returns a `Span` named \p name of category \p category that begins *now* on the calling thread. */
+    Span span(std::string name, const char *category = "mutable") { return Span(std::move(name), category); }
+
+    /** Records a span named \p name of category \p category from \p begin to \p end on the calling thread with the
+     * additional arguments \p args iff tracing is enabled. */
+    void add(std::string name, const char *category, time_point begin, time_point end, args_type args = args_type());
+
+    /** Names the calling thread \p name in the trace. */
+    void name_thread(std::string name);
+
+    /** Returns a copy of all recorded spans. */
+    std::vector<event> events() const;
+
+    /** Discards all recorded spans. */
+    void clear();
+
+    /** Writes all recorded spans as JSON in the Chrome trace event format to \p out. */
+    void write_chrome_trace(std::ostream &out) const;
+};
+
+}
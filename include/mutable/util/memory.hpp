@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 
 namespace m {
@@ -124,6 +125,11 @@ struct M_EXPORT Memory
     /** Map `size` bytes starting at `offset_src` into the address space of `vm` at offset `offset_dst`.  */
     void map(std::size_t size, std::size_t offset_src, const AddressSpace &vm, std::size_t offset_dst) const;
 
+    /** Map `size` bytes starting at `offset_src` *copy-on-write* into the address space of `vm` at offset
+     * `offset_dst`.  Writes through the mapping go to private copies of the written pages and are not visible to
+     * other mappings.  Pages not yet copied still reflect modifications of this memory, see `make_private()`. */
+    void map_private(std::size_t size, std::size_t offset_src, const AddressSpace &vm, std::size_t offset_dst) const;
+
     void dump(std::ostream &out) const;
     void dump() const;
 };
@@ -156,6 +162,25 @@ struct M_EXPORT LinearAllocator : Allocator
     void deallocate(Memory &&mem) override;
 };
 
+/** Forces private copies of all pages of the page aligned address range `[addr, addr + size)`, which must be mapped
+ * copy-on-write, e.g. by `Memory::map_private()`.  Afterwards, modifications of the underlying memory are no longer
+ * visible through this address range. */
+M_EXPORT void make_private(void *addr, std::size_t size);
+
+/** Returns the number of bytes of the page aligned address range `[addr, addr + size)` that are currently resident in
+ * physical memory, i.e. the pages that were actually touched and not swapped out. */
+M_EXPORT std::size_t resident_bytes(const void *addr, std::size_t size);
+
+/** Memory usage of the entire process, e.g. to plan capacity and to detect queries at risk of exhausting memory. */
+struct usage_t
+{
+    std::size_t resident = 0; ///< current resident set size in bytes
+    std::size_t peak_resident = 0; ///< peak resident set size in bytes since process start
+
+    /** Returns the current memory usage of this process.  Unknown values are reported as 0. */
+    M_EXPORT static usage_t Get();
+};
+
 }
 
 }
@@ -1,7 +1,9 @@
 #pragma once
 
 
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <mutable/util/macro.hpp>
 #include <mutex>
 #include <optional>
@@ -10,6 +12,46 @@
 
 namespace m {
 
+/** Statistics about the contention of a lock.  An acquisition is *contended* if the acquiring thread had to wait. */
+struct lock_contention
+{
+    using clock = std::chrono::steady_clock;
+
+    uint64_t num_acquisitions = 0; ///< the number of acquisitions of the lock
+    uint64_t num_contended = 0; ///< the number of acquisitions that had to wait for the lock
+    clock::duration wait_time{0}; ///< the total time spent waiting for the lock
+
+    /** Records a single acquisition of a lock.  The clock is only read if the acquisition is contended, such that
+     * uncontended acquisitions remain cheap. */
+    struct acquisition
+    {
+        private:
+        std::optional<clock::time_point> wait_begin_;
+
+        public:
+        /** Marks the acquisition as contended, i.e. the acquiring thread is about to wait for the lock. */
+        void contended() { if (not wait_begin_) wait_begin_ = clock::now(); }
+
+        /** Acquires `lock` of a `std::mutex`, recording whether this acquisition is contended. */
+        void lock(std::unique_lock<std::mutex> &lock) {
+            M_insist(not lock.owns_lock());
+            if (not lock.try_lock()) {
+                contended();
+                lock.lock();
+            }
+        }
+
+        /** Adds this acquisition to `stats`.  Must be called while holding the lock guarding `stats`. */
+        void acquired(lock_contention &stats) {
+            ++stats.num_acquisitions;
+            if (wait_begin_) {
+                ++stats.num_contended;
+                stats.wait_time += clock::now() - *wait_begin_;
+            }
+        }
+    };
+};
+
 namespace detail {
 
 /**
@@ -135,26 +177,48 @@ class reader_writer_mutex
      */
     std::condition_variable cv_readers_, cv_writers_;
 
+    /** The contention of acquiring read and write locks, including upgrades.  Guarded by `mutex_`. */
+    lock_contention contention_;
+
     public:
     void notify_readers() { cv_readers_.notify_all(); }
     void notify_writer() { cv_writers_.notify_one(); }
 
+    /** Returns statistics about the contention of this mutex. */
+    lock_contention contention() {
+        std::unique_lock lock{mutex_};
+        return contention_;
+    }
+    /** Resets the statistics about the contention of this mutex. */
+    void reset_contention() {
+        std::unique_lock lock{mutex_};
+        contention_ = lock_contention();
+    }
+
     /** Acquire a read lock.  This call blocks the calling thread until a read lock was acquired. */
     void lock_read() {
-        std::unique_lock lock{mutex_};
+        lock_contention::acquisition A;
+        std::unique_lock lock{mutex_, std::defer_lock};
+        A.lock(lock);
         rw_.request_read_lock();
+        if (not rw_.can_acquire_read_lock()) A.contended();
         cv_readers_.wait(lock, [this]() -> bool { return rw_.can_acquire_read_lock(); });
         M_insist(lock.owns_lock());
         rw_.acquire_read_lock();
+        A.acquired(contention_);
     }
 
     /** Acquire the write lock.  This call blocks the calling thread until the write lock was acquired. */
     void lock_write() {
-        std::unique_lock lock{mutex_};
+        lock_contention::acquisition A;
+        std::unique_lock lock{mutex_, std::defer_lock};
+        A.lock(lock);
         rw_.request_write_lock();
+        if (not rw_.can_acquire_write_lock()) A.contended();
         cv_writers_.wait(lock, [this]() -> bool { return rw_.can_acquire_write_lock(); });
         M_insist(lock.owns_lock());
         rw_.acquire_write_lock();
+        A.acquired(contention_);
     }
 
     /** Attempts to immediatly claim a read lock.  Returns `true` on success, `false` otherwise. */
@@ -191,14 +255,18 @@ class reader_writer_mutex
      * behavior is implemented by `reader_writer_lock::upgrade()`.
      */
     [[nodiscard]] bool upgrade() {
-        std::unique_lock lock{mutex_};
+        lock_contention::acquisition A;
+        std::unique_lock lock{mutex_, std::defer_lock};
+        A.lock(lock);
         if (not rw_.try_request_upgrade())
             return false;
 
         M_insist(rw_.reader_wants_upgrade());
+        if (not rw_.can_upgrade_lock()) A.contended();
         cv_writers_.wait(lock, [this]() -> bool { return rw_.can_upgrade_lock(); });
         M_insist(lock.owns_lock());
         rw_.upgrade_lock();
+        A.acquired(contention_);
         return true;
     }
 
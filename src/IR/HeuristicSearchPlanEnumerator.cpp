@@ -37,6 +37,8 @@ float weighting_factor = 1.f;
 bool initialize_upper_bound = false;
 /** The expansion budget for Anytime A*. */
 uint64_t expansion_budget = std::numeric_limits<uint64_t>::max();
+/** The number of threads to expand search states with. */
+unsigned num_threads = 1;
 
 }
 
@@ -181,6 +183,11 @@ bool heuristic_search(PlanTable &PT, const QueryGraph &G, const AdjacencyMatrix
                       const ai::SearchConfiguration<StaticConfig> &config)
 {
     State::RESET_STATE_COUNTERS();
+#ifndef NDEBUG
+    constexpr bool is_parallel = supports_parallel_expansion<PlanTable, State, Expand, Heuristic>;
+    M_insist(config.num_threads <= 1 or is_parallel,
+             "the chosen search configuration does not support expanding states in parallel");
+#endif
 
     if constexpr (StaticConfig::PerformCostBasedPruning) {
         if (Options::Get().statistics)
@@ -193,6 +200,15 @@ bool heuristic_search(PlanTable &PT, const QueryGraph &G, const AdjacencyMatrix
         H h(PT, G, M, CF, CE);
 
         /*----- Run the search algorithm. -----*/
+        /* Synchronize the lazy computation of data models only while states are expanded in parallel.  Reset when
+         * leaving the `try` block, no matter whether by completing the search or by throwing. */
+        struct concurrent_models_guard
+        {
+            PlanTable &PT;
+
+            concurrent_models_guard(PlanTable &PT, bool concurrent) : PT(PT) { PT.concurrent_models(concurrent); }
+            ~concurrent_models_guard() { PT.concurrent_models(false); }
+        } guard(PT, config.num_threads > 1);
         const State &goal = S.search(
             /* initial_state= */ std::move(initial_state),
             /* expand=        */ Expand{},
@@ -411,6 +427,13 @@ bool heuristic_search_helper(const char *vertex_str, const char *expand_str, con
                       << std::endl;
         }
 
+        if constexpr (supports_parallel_expansion<PlanTable, State, Expand, Heuristic>) {
+            config.num_threads = std::max(options::num_threads, 1U);
+        } else if (options::num_threads > 1) {
+            std::cerr << "WARNING: option --hs-threads has no effect for the chosen search configuration"
+                      << std::endl;
+        }
+
         using H = Heuristic<PlanTable, State, Expand>;
 
         using SearchAlgorithm = Search<
@@ -646,6 +669,13 @@ void register_heuristic_search_plan_enumerator()
         /* description= */ "the expansion budget to use for Anytime A*",
         [] (uint64_t n) { options::expansion_budget = n; }
     );
+    C.arg_parser().add<unsigned>(
+        /* group=       */ "HeuristicSearch",
+        /* short=       */ nullptr,
+        /* long=        */ "--hs-threads",
+        /* description= */ "the number of threads to expand search states with in parallel (default 1)",
+        [] (unsigned n) { options::num_threads = n; }
+    );
 }
 
 }
@@ -1649,6 +1649,20 @@ void m::GraphBuilder::operator()(const ast::SelectStmt &stmt) {
             graph_->projections_.emplace_back(*s.first, s.second.text); // add to projections
     }
 
+    /*----- Process DISTINCT by grouping by all projections.  A query with aggregates but without grouping keys yields
+     * a single row, which is trivially distinct.  Projections that are equal expressions, e.g. in
+     * `SELECT DISTINCT a, a`, are a single grouping key. -----*/
+    if (SELECT->distinct and not needs_grouping_) {
+        M_insist(nested_queries_in_select.empty(), "DISTINCT with nested queries in the SELECT clause not supported");
+        for (auto &[expr, _] : graph_->projections_) {
+            const ast::Expr &e = expr.get();
+            auto is_key = [&e](const QueryGraph::group_type &key) { return key.first.get() == e; }; // `Expr` equality
+            if (std::none_of(graph_->group_by_.cbegin(), graph_->group_by_.cend(), is_key))
+                graph_->group_by_.emplace_back(e, ThreadSafePooledOptionalString{});
+        }
+        needs_grouping_ = true;
+    }
+
     /*----- Process WHERE clause. -----*/
     if (stmt.where) {
         /*----- Get WHERE clause and convert to CNF. -----*/
@@ -553,6 +553,15 @@ StackMachine Interpreter::compile_store(const Schema &tuple_schema, void *addres
     return compile_data_layout<true>(tuple_schema, address, layout, layout_schema, row_id, tuple_id);
 }
 
+/** Sets the observed cardinality of every operator of the plan rooted at \p root to \p cardinality. */
+static void observe_cardinalities(const Operator &root, std::optional<std::size_t> cardinality)
+{
+    visit([&](const Operator &op) {
+        if (op.has_info())
+            op.info().observed_cardinality = cardinality;
+    }, root, tag<ConstPreOrderOperatorVisitor>());
+}
+
 /*======================================================================================================================
  * Declaration of operator data.
  *====================================================================================================================*/
@@ -915,7 +924,7 @@ void Pipeline::operator()(const ScanOperator &op)
             Tuple *args[] = { &block_[j] };
             loader(args);
         }
-        op.parent()->accept(*this);
+        emit(op);
     }
     if (i != num_rows) {
         /* Fill last vector with remaining tuples. */
@@ -926,7 +935,7 @@ void Pipeline::operator()(const ScanOperator &op)
             Tuple *args[] = { &block_[j] };
             loader(args);
         }
-        op.parent()->accept(*this);
+        emit(op);
     }
 }
 
@@ -964,7 +973,7 @@ void Pipeline::operator()(const FilterOperator &op)
         if (data->res.is_null(0) or not data->res[0].as_b()) block_.erase(it);
     }
     if (not block_.empty())
-        op.parent()->accept(*this);
+        emit(op);
 }
 
 void Pipeline::operator()(const DisjunctiveFilterOperator &op)
@@ -986,7 +995,7 @@ void Pipeline::operator()(const DisjunctiveFilterOperator &op)
 satisfied:;
     }
     if (not block_.empty())
-        op.parent()->accept(*this);
+        emit(op);
 }
 
 void Pipeline::operator()(const JoinOperator &op)
@@ -1008,7 +1017,7 @@ void Pipeline::operator()(const JoinOperator &op)
                 pipeline.block_.fill();
                 data->ht.for_all(*args[0], [&](std::pair<const Tuple, Tuple> &v) {
                     if (i == pipeline.block_.capacity()) {
-                        pipeline.push(*op.parent());
+                        pipeline.emit(op);
                         i = 0;
                     }
 
@@ -1027,7 +1036,7 @@ void Pipeline::operator()(const JoinOperator &op)
             if (i != 0) {
                 M_insist(i <= pipeline.block_.capacity());
                 pipeline.block_.mask(i == pipeline.block_.capacity() ? -1UL : (1UL << i) - 1);
-                pipeline.push(*op.parent());
+                pipeline.emit(op);
             }
         } else {
             if (data->load_attrs.size() != 1) {
@@ -1108,7 +1117,7 @@ void Pipeline::operator()(const JoinOperator &op)
                     }
 
                     if (not pipeline.block_.empty())
-                        pipeline.push(*op.parent());
+                        pipeline.emit(op);
                     --child_id;
                 } else { // child whose tuples have been materialized in a buffer
                     ++positions[child_id];
@@ -1154,7 +1163,7 @@ void Pipeline::operator()(const ProjectionOperator &op)
         (*data->projections)(args);
     }
 
-    pipeline.push(*op.parent());
+    pipeline.emit(op);
 }
 
 void Pipeline::operator()(const LimitOperator &op)
@@ -1168,7 +1177,7 @@ void Pipeline::operator()(const LimitOperator &op)
     }
 
     if (not block_.empty())
-        op.parent()->accept(*this);
+        emit(op);
 
     if (data->num_tuples >= op.offset() + op.limit())
         throw LimitOperator::stack_unwind(); // all tuples produced, now unwind the stack
@@ -1409,6 +1418,13 @@ void Pipeline::operator()(const SortingOperator &op)
  * Interpreter - Recursive descent
  *====================================================================================================================*/
 
+void Interpreter::execute(const MatchBase &plan) const
+{
+    auto &root = plan.get_matched_root();
+    observe_cardinalities(root, 0); // count the tuples produced by each operator, see `Pipeline::emit()`
+    (*const_cast<Interpreter*>(this))(root); // use former visitor pattern on logical operators
+}
+
 void Interpreter::operator()(const CallbackOperator &op)
 {
     op.child(0)->accept(*this);
@@ -1454,8 +1470,10 @@ void Interpreter::operator()(const JoinOperator &op)
         if (op.has_info())
             data->ht.resize(op.info().estimated_cardinality);
         op.child(0)->accept(*this); // build HT on LHS
-        if (data->ht.size() == 0) // no tuples produced
+        if (data->ht.size() == 0) { // no tuples produced
+            observe_cardinalities(*op.child(1), std::nullopt); // RHS is not executed
             return;
+        }
         data->is_probe_phase = true;
         op.child(1)->accept(*this); // probe HT with RHS
     } else {
@@ -1466,8 +1484,11 @@ void Interpreter::operator()(const JoinOperator &op)
             data->active_child = i;
             auto c = op.child(i);
             c->accept(*this);
-            if (i != op.children().size() - 1 and data->buffers[i].empty()) // no tuples produced
+            if (i != op.children().size() - 1 and data->buffers[i].empty()) { // no tuples produced
+                while (++i != end)
+                    observe_cardinalities(*op.child(i), std::nullopt); // remaining children are not executed
                 return;
+            }
         }
     }
 }
@@ -1500,7 +1521,6 @@ void Interpreter::operator()(const LimitOperator &op)
 
 void Interpreter::operator()(const GroupingOperator &op)
 {
-    auto &parent = *op.parent();
     auto data = new HashBasedGroupingData(op);
     op.data(data);
 
@@ -1516,7 +1536,7 @@ void Interpreter::operator()(const GroupingOperator &op)
             auto node = data->groups.extract(it++);
             swap(data->pipeline.block_[j], node.key());
         }
-        data->pipeline.push(parent);
+        data->pipeline.emit(op);
     }
     data->pipeline.block_.clear();
     data->pipeline.block_.mask((1UL << remainder) - 1UL);
@@ -1524,7 +1544,7 @@ void Interpreter::operator()(const GroupingOperator &op)
         auto node = data->groups.extract(it++);
         swap(data->pipeline.block_[i], node.key());
     }
-    data->pipeline.push(parent);
+    data->pipeline.emit(op);
 }
 
 void Interpreter::operator()(const AggregationOperator &op)
@@ -1579,7 +1599,7 @@ void Interpreter::operator()(const AggregationOperator &op)
     data->pipeline.block_.clear();
     data->pipeline.block_.mask(1UL);
     swap(data->pipeline.block_[0], data->aggregates);
-    data->pipeline.push(*op.parent());
+    data->pipeline.emit(op);
 }
 
 void Interpreter::operator()(const SortingOperator &op)
@@ -1636,7 +1656,6 @@ void Interpreter::operator()(const SortingOperator &op)
         return res[0].as_i() < 0;
     });
 
-    auto &parent = *op.parent();
     const auto num_tuples = data->buffer.size();
     const auto remainder = num_tuples % data->pipeline.block_.capacity();
     auto it = data->buffer.begin();
@@ -1645,13 +1664,13 @@ void Interpreter::operator()(const SortingOperator &op)
         data->pipeline.block_.fill();
         for (std::size_t j = 0; j != data->pipeline.block_.capacity(); ++j)
             data->pipeline.block_[j] = std::move(*it++);
-        data->pipeline.push(parent);
+        data->pipeline.emit(op);
     }
     data->pipeline.block_.clear();
     data->pipeline.block_.mask((1UL << remainder) - 1UL);
     for (std::size_t i = 0; i != remainder; ++i)
         data->pipeline.block_[i] = std::move(*it++);
-    data->pipeline.push(parent);
+    data->pipeline.emit(op);
 }
 
 __attribute__((constructor(202)))
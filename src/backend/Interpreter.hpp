@@ -201,6 +201,14 @@ struct Pipeline : ConstOperatorVisitor
 
     void push(const Operator &pipeline_start) { (*this)(pipeline_start); }
 
+    /** Passes the tuples of this pipeline, which were produced by \p op, on to the parent of \p op.  Adds their
+     * number to the observed cardinality of \p op, if recorded. */
+    void emit(const Producer &op) {
+        if (op.has_info() and op.info().observed_cardinality)
+            *op.info().observed_cardinality += block_.size();
+        push(*op.parent());
+    }
+
     void clear() { block_.clear(); }
 
     const Schema & schema() const { return block_.schema(); }
@@ -219,9 +227,8 @@ struct Interpreter : Backend, ConstOperatorVisitor
 
     void register_operators(PhysicalOptimizer &phys_opt) const override { register_interpreter_operators(phys_opt); }
 
-    void execute(const MatchBase &plan) const override {
-        (*const_cast<Interpreter*>(this))(plan.get_matched_root()); // use former visitor pattern on logical operators
-    }
+    /** Executes \p plan and records the cardinality observed for each of its logical operators. */
+    void execute(const MatchBase &plan) const override;
 
     using ConstOperatorVisitor::operator();
 #define DECLARE(CLASS) void operator()(Const<CLASS> &op) override;
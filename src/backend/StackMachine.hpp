@@ -197,6 +197,15 @@ struct StackMachine
         return idx;
     }
 
+    /** Returns the number of `Value`s in the context. */
+    std::size_t num_context_values() const { return context_.size(); }
+
+    /** Returns the `Value` in the context at index `idx`. */
+    Value get(std::size_t idx) const {
+        M_insist(idx < context_.size(), "index out of bounds");
+        return context_[idx];
+    }
+
     /** Sets the `Value` in the context at index `idx` to `val`. */
     void set(std::size_t idx, Value val) {
         M_insist(idx < context_.size(), "index out of bounds");
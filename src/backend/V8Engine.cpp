@@ -2,6 +2,7 @@
 
 #include "backend/Interpreter.hpp"
 #include "backend/WasmOperator.hpp"
+#include "backend/WasmProfiler.hpp"
 #include "backend/WasmUtil.hpp"
 #include "mutable/util/macro.hpp"
 #include "storage/Store.hpp"
@@ -55,6 +56,10 @@ bool wasm_dump = false;
 bool asm_dump = false;
 /** The port to use for the Chrome DevTools web socket. */
 uint16_t cdt_port = 0;
+/** Whether to write a perf map of the generated machine code to `/tmp/perf-<pid>.map`. */
+bool perf_map = false;
+/** Whether to write a jitdump of the generated machine code to `jit-<pid>.dump`. */
+bool perf_jitdump = false;
 
 }
 
@@ -285,15 +290,11 @@ void m::wasm::detail::print(const v8::FunctionCallbackInfo<v8::Value> &info)
     std::cout << std::endl;
 }
 
-void m::wasm::detail::print_memory_consumption(const v8::FunctionCallbackInfo<v8::Value> &info)
+void m::wasm::detail::profile_now(const v8::FunctionCallbackInfo<v8::Value> &info)
 {
-    M_insist(Options::Get().statistics);
-
-    auto alloc_total_mem = info[0].As<v8::Uint32>()->Value();
-    auto alloc_peak_mem = info[1].As<v8::Uint32>()->Value();
-
-    std::cout << "Allocated memory overall consumption: " << alloc_total_mem / (1024.0 * 1024.0) << " MiB"<< std::endl;
-    std::cout << "Allocated memory peak consumption: " << alloc_peak_mem / (1024.0 * 1024.0) << " MiB"<< std::endl;
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    const double ns = std::chrono::duration_cast<std::chrono::duration<double, std::nano>>(now).count();
+    info.GetReturnValue().Set(v8::Number::New(info.GetIsolate(), ns));
 }
 
 void m::wasm::detail::set_wasm_instance_raw_memory(const v8::FunctionCallbackInfo<v8::Value> &info)
@@ -787,6 +788,13 @@ void V8Engine::initialize()
               << "--no-wasm-stack-checks "
               << "--wasm-simd-ssse3-codegen ";
     }
+    /* Let `perf` attribute samples in generated code to the Wasm functions, which are named after the operators and
+     * pipelines they implement, see `instantiate()`. */
+    if (options::perf_map)
+        flags << "--perf-basic-prof ";
+    if (options::perf_jitdump)
+        flags << "--perf-prof "
+              << "--no-write-protect-code-memory "; // jitdump requires the code to be written in place
     v8::V8::SetFlagsFromString(flags.str().c_str());
 
     v8::Isolate::CreateParams create_params;
@@ -799,8 +807,9 @@ void V8Engine::compile(const m::MatchBase &plan) const
 #if 1
     /*----- Add print function. --------------------------------------------------------------------------------------*/
     Module::Get().emit_function_import<void(uint32_t)>("print");
-    Module::Get().emit_function_import<void(uint32_t, uint32_t)>("print_memory_consumption");
 #endif
+    if (Profiler::Get().active())
+        Module::Get().emit_function_import<double(void)>("profile_now");
 
     /*----- Emit code for run function which computes the last pipeline and calls other pipeline functions. ----------*/
     FUNCTION(run, void(void))
@@ -815,14 +824,8 @@ void V8Engine::compile(const m::MatchBase &plan) const
     {
         auto S = CodeGenContext::Get().scoped_environment(); // create scoped environment for this function
         run(); // call run function
-        if (Options::Get().statistics) {
-            std::cout << "Pre-allocated memory overall consumption: "
-                      << Module::Allocator().pre_allocated_memory_consumption() / (1024.0 * 1024.0)
-                      << " MiB" << std::endl;
-            Module::Get().emit_call<void>("print_memory_consumption",
-                                          Module::Allocator().allocated_memory_consumption(),
-                                          Module::Allocator().allocated_memory_peak());
-        }
+        if (Profiler::Get().active() or Options::Get().statistics)
+            Profiler::Get().record_memory(); // report memory consumption of the query
         main.emit_return(CodeGenContext::Get().num_tuples()); // return size of result set
     }
 
@@ -867,6 +870,11 @@ void V8Engine::execute(const m::MatchBase &plan)
 
     Module::Init();
     CodeGenContext::Init(); // fresh context
+    /* Profile iff runtime statistics are requested, either by the user or by the cardinality estimator. */
+    Profiler::Get().reset(Options::Get().explain_analyze or
+                          C.get_database_in_use().cardinality_estimator().requests_feedback());
+    /* Account the memory consumption iff it is reported, see `compile()`. */
+    const bool report_memory = Profiler::Get().active() or Options::Get().statistics;
 
     M_insist(bool(isolate_), "must have an isolate");
     v8::Locker locker(isolate_);
@@ -963,6 +971,31 @@ void V8Engine::execute(const m::MatchBase &plan)
             if (not Options::Get().quiet)
                 noop_op->out << num_rows << " rows\n";
         }
+
+        /* Collect the runtime statistics and the memory consumption, i.e. the allocations and the physical pages
+         * touched in the heap, before the Wasm memory is released. */
+        const bool explain_analyze = Profiler::Get().active() and Options::Get().explain_analyze;
+        if (Profiler::Get().active())
+            Profiler::Get().collect(plan, num_rows);
+        if (report_memory) {
+            const std::size_t heap_capacity = wasm_context.vm.size() - wasm_context.heap;
+            Profiler::Get().collect_memory(
+                memory::resident_bytes(wasm_context.vm.as<uint8_t*>() + wasm_context.heap, heap_capacity),
+                heap_capacity
+            );
+            auto &memory_stats = *Profiler::Get().memory_statistics();
+            if (memory_stats.heap_utilization() > 0.9) {
+                std::cerr << "warning: query occupied " << 100. * memory_stats.heap_utilization()
+                          << " % of the available linear memory at peak" << std::endl;
+            }
+        }
+
+        /* Emit the annotated plan and the memory consumption. */
+        if (explain_analyze)
+            plan.dump(std::cout);
+        if (explain_analyze or Options::Get().statistics)
+            Profiler::Get().memory_statistics()->print(std::cout);
+        Profiler::Get().reset(false);
         Dispose_Wasm_Context(wasm_context);
     }
 
@@ -1036,6 +1069,20 @@ static void register_WasmV8()
         /* description= */ "specify the port for debugging via ChromeDevTools",
                            [] (int i) { options::cdt_port = i; }
     );
+    C.arg_parser().add<bool>(
+        /* group=       */ "WasmV8",
+        /* short=       */ nullptr,
+        /* long=        */ "--perf-map",
+        /* description= */ "write a perf map of the generated code to /tmp/perf-<pid>.map for profiling with perf",
+                           [] (bool b) { options::perf_map = b; }
+    );
+    C.arg_parser().add<bool>(
+        /* group=       */ "WasmV8",
+        /* short=       */ nullptr,
+        /* long=        */ "--perf-jitdump",
+        /* description= */ "write a jitdump of the generated code to jit-<pid>.dump for profiling with perf",
+                           [] (bool b) { options::perf_jitdump = b; }
+    );
 }
 
 }
@@ -1053,7 +1100,8 @@ v8::Local<v8::String> m::wasm::detail::mkstr(v8::Isolate &isolate, const std::st
 v8::Local<v8::WasmModuleObject> m::wasm::detail::instantiate(v8::Isolate &isolate, v8::Local<v8::Object> imports)
 {
     auto Ctx = isolate.GetCurrentContext();
-    auto [binary_addr, binary_size] = Module::Get().binary();
+    /* Emit function names iff profiling with `perf` s.t. V8 reports them instead of anonymous function indices. */
+    auto [binary_addr, binary_size] = Module::Get().binary(options::perf_map or options::perf_jitdump);
     auto bs = v8::ArrayBuffer::NewBackingStore(
         /* data =        */ binary_addr,
         /* byte_length=  */ binary_size,
@@ -1180,7 +1228,7 @@ v8::Local<v8::Object> m::wasm::detail::create_env(v8::Isolate &isolate, const m:
 #define ADD_FUNC_(FUNC) ADD_FUNC(FUNC, #FUNC)
     ADD_FUNC_(insist)
     ADD_FUNC_(print)
-    ADD_FUNC_(print_memory_consumption)
+    ADD_FUNC_(profile_now)
     ADD_FUNC_(read_result_set)
     ADD_FUNC(_throw, "throw")
 
@@ -274,6 +274,46 @@ template<typename T>
 requires std::same_as<T, bool>
 U64x1 reinterpret_to_U64(m::wasm::PrimitiveExpr<T> value) { return value.template to<uint64_t>(); }
 
+namespace {
+
+/** Mixes the 64 bit word \p k into the hash value \p h using the Murmur3-64a algorithm.  We use constants from
+ * MurmurHash2_64 as reported on https://sites.google.com/site/murmurhash/. */
+void murmur3_64a_mix(Var<U64x1> &h, U64x1 k)
+{
+    h ^= rotl(k * uint64_t(0xc6a4a7935bd1e995UL), 47UL) * uint64_t(0xc6a4a7935bd1e995UL);
+    h  = rotl(h, 45UL);
+    h  = h * uint64_t(5UL) + uint64_t(0xe6546b64UL);
+}
+
+/** Returns the word of the \p num_chars characters starting at \p ptr in little endian, i.e. the first character in
+ * the least significant byte.  Missing characters are zero.  Loads byte by byte to not read beyond the string, hence
+ * only use this for the characters following the last complete word. */
+U64x1 load_word(const Var<Ptr<U8x1>> &ptr, uint32_t num_chars)
+{
+    M_insist(num_chars > 0 and num_chars < 8);
+    Var<U64x1> word(U8x1(*ptr).to<uint64_t>());
+    for (uint32_t i = 1; i != num_chars; ++i)
+        word |= U8x1(*(ptr + int32_t(i))).to<uint64_t>() << uint64_t(8 * i);
+    return word;
+}
+
+/** Clears the first NUL byte of \p word and all following bytes and returns `true` iff \p word contains a NUL byte.
+ * Determines the first NUL byte without branching per byte, see
+ * https://graphics.stanford.edu/~seander/bithacks.html#ZeroInWord. */
+Boolx1 truncate_at_nul(Var<U64x1> &word)
+{
+    /* The least significant bit set marks the most significant bit of the first NUL byte.  Bits of succeeding bytes may
+     * be set spuriously, which is irrelevant since these bytes are cleared anyway. */
+    const Var<U64x1> nul_bits((word - uint64_t(0x0101010101010101UL)) bitand ~word bitand
+                              uint64_t(0x8080808080808080UL));
+    IF (nul_bits != uint64_t(0)) {
+        word &= (uint64_t(1) << (nul_bits.ctz() - uint64_t(7))) - uint64_t(1);
+    };
+    return nul_bits != uint64_t(0);
+}
+
+}
+
 
 /*----- bit mix functions --------------------------------------------------------------------------------------------*/
 
@@ -310,6 +350,44 @@ U64x1 m::wasm::fnv_1a(Ptr<U8x1> bytes, U32x1 num_bytes)
     return h;
 }
 
+U64x1 m::wasm::murmur3_64a_str_hash(Ptr<U8x1> str, uint32_t max_length)
+{
+    Wasm_insist(not str.clone().is_nullptr(), "cannot compute hash of nullptr");
+
+    Var<U64x1> h(0xc6a4a7935bd1e995UL);
+    Var<U64x1> word; // always set before used
+    Var<Boolx1> is_terminated(false);
+
+    /*----- Mix all complete words of the string until the first NUL byte.  A word starting with the NUL byte is empty
+     * after truncation and not mixed, such that the hash does not depend on \p max_length. -----*/
+    Var<Ptr<U8x1>> ptr(str);
+    if (const uint32_t num_words = max_length / 8) {
+        const Var<Ptr<U8x1>> end(ptr + int32_t(8 * num_words));
+        WHILE (ptr != end) {
+            /* The complete word is in bounds, hence load it at once.  WebAssembly loads are little endian. */
+            word = *ptr.to<void*>().to_unaligned<uint64_t*>();
+            is_terminated = truncate_at_nul(word);
+            BREAK(word == uint64_t(0)); // string ended before this word
+            murmur3_64a_mix(h, word);
+            BREAK(is_terminated);
+            ptr += 8;
+        }
+    }
+
+    /*----- Mix the remaining characters. -----*/
+    if (const uint32_t num_chars = max_length % 8) {
+        IF (not is_terminated) {
+            word = load_word(ptr, num_chars);
+            truncate_at_nul(word).discard();
+            IF (word != uint64_t(0)) {
+                murmur3_64a_mix(h, word);
+            };
+        };
+    }
+
+    return murmur3_bit_mix(h);
+}
+
 U64x1 m::wasm::str_hash(NChar _str)
 {
     Var<U64x1> h(0); // always set here
@@ -327,8 +405,8 @@ U64x1 m::wasm::str_hash(NChar _str)
             }
             h = murmur3_bit_mix(h);
         } else {
-            /*----- Compute FNV-1a hash of string. -----*/
-            h = fnv_1a(_str.to<void*>().to<uint8_t*>(), U32x1(_str.length()));
+            /*----- Hash the string word-at-a-time. -----*/
+            h = murmur3_64a_str_hash(_str.to<void*>().to<uint8_t*>(), _str.length());
         }
     };
 
@@ -403,31 +481,60 @@ U64x1 m::wasm::murmur3_64a_hash(std::vector<std::pair<const Type*, SQL_t>> value
         return murmur3_bit_mix(h);
     }
 
-    /*----- Perform general Murmur3_64a. -----*/
-    U64x1 m(0xc6a4a7935bd1e995UL);
-    Var<U64x1> k; // always set before used
-    Var<U64x1> h(uint64_t(values.size()) * m.clone());
+    /*----- Otherwise, pack the values into as few 64 bit words as possible and mix each word using Murmur3_64a, such
+     * that composite keys of narrow values require only few mixing steps.  Strings that do not fit into a single word
+     * are hashed separately and their hash is mixed instead. -----*/
+    Var<U64x1> h(uint64_t(values.size()) * uint64_t(0xc6a4a7935bd1e995UL));
+    Var<U64x1> word(0);
+    uint64_t word_size_in_bits = 0; // number of bits of `word` in use
+
+    /* Makes room for `size_in_bits` bits in `word`, mixing `word` into `h` first if it has not enough room left. */
+    auto make_room = [&](uint64_t size_in_bits) {
+        if (word_size_in_bits + size_in_bits > 64) {
+            murmur3_64a_mix(h, word);
+            word = uint64_t(0);
+            word_size_in_bits = 0;
+        }
+        if (word_size_in_bits != 0)
+            word <<= size_in_bits;
+        word_size_in_bits += size_in_bits;
+    };
 
     for (auto &p : values) {
         std::visit(overloaded {
-            [&]<typename T>(Expr<T> val) -> void {
-                k  = val.hash();
-                k *= m.clone();
-                k  = rotl(k, 47UL);
-                k *= m.clone();
-                h ^= k;
-                h  = rotl(h, 45UL);
-                h  = h * uint64_t(5UL) + uint64_t(0xe6546b64UL);
+            [&]<typename T>(Expr<T> _val) -> void {
+                make_room(p.first->size());
+                if (_val.can_be_null()) {
+                    auto [val, is_null] = _val.split();
+                    word |= (~uint64_t(0) + is_null.template to<uint64_t>()) bitand reinterpret_to_U64(val);
+                } else {
+                    word |= reinterpret_to_U64(_val.insist_not_null());
+                }
+            },
+            [&](NChar _val) -> void {
+                const uint64_t len_in_bits = 8 * _val.length();
+                if (len_in_bits > 64) {
+                    murmur3_64a_mix(h, str_hash(_val));
+                    return;
+                }
+                make_room(len_in_bits);
+                IF (not _val.clone().is_null()) {
+                    const Var<Ptr<Charx1>> val(_val.val());
+                    for (int32_t i = 0; i != _val.length(); ++i) {
+                        Charx1 c = *(val + i);
+                        const uint64_t shift = len_in_bits - 8 * (i + 1);
+                        word |= (c.to<uint64_t>() bitand uint64_t(0xffUL)) << shift; // add reinterpreted character
+                    }
+                };
             },
-            [&](NChar val) -> void { h ^= str_hash(val); },
             [](auto) -> void { M_unreachable("SIMDfication currently not supported"); },
             [](std::monostate) -> void { M_unreachable("invalid variant"); }
         }, p.second);
     }
+    if (word_size_in_bits != 0)
+        murmur3_64a_mix(h, word);
     h ^= uint64_t(values.size());
 
-    m.discard(); // since it was always cloned
-
     return murmur3_bit_mix(h);
 }
 
@@ -619,6 +726,9 @@ void ChainedHashTable<IsGlobal>::teardown()
     M_insist(bool(num_entries_), "must call `setup()` before");
     M_insist(bool(high_watermark_absolute_), "must call `setup()` before");
 
+    /*----- Account the size of the buckets and the collision list entries as the hash table only grows. -----*/
+    profile_size(size_in_bytes() + *num_entries_ * uint32_t(entry_size_in_bytes_));
+
     if constexpr (not IsGlobal) { // free memory of local hash table when user calls teardown method
         /*----- Free collision list entries. -----*/
         Var<Ptr<void>> it(begin());
@@ -774,6 +884,11 @@ HashTable::entry_t ChainedHashTable<IsGlobal>::emplace_without_rehashing(std::ve
              : hash_to_bucket(clone(key))
     ); // clone key since we need it again for insertion
 
+    /*----- Update profiling counters, i.e. a collision occurs iff the collision list is not empty. -----*/
+    profile_inc(&Profiler::record_t::num_lookups, U32x1(1));
+    profile_inc(&Profiler::record_t::num_probes, U32x1(1));
+    profile_inc(&Profiler::record_t::num_collisions, (*bucket.to<uint32_t*>() != 0U).to<uint32_t>());
+
     /*----- Allocate memory for entry. -----*/
     Var<Ptr<void>> entry = Module::Allocator().allocate(entry_size_in_bytes_, entry_max_alignment_in_bytes_);
 
@@ -822,6 +937,7 @@ std::pair<HashTable::entry_t, Boolx1> ChainedHashTable<IsGlobal>::try_emplace(st
     ); // clone key since we need it again for insertion
 
     /*----- Probe collision list, abort and skip insertion if key already exists. -----*/
+    profile_inc(&Profiler::record_t::num_lookups, U32x1(1));
     Var<Boolx1> entry_inserted(false);
     Var<Ptr<void>> bucket_it(Ptr<void>(*bucket.to<uint32_t*>()));
     BLOCK(insert_entry) {
@@ -829,6 +945,7 @@ std::pair<HashTable::entry_t, Boolx1> ChainedHashTable<IsGlobal>::try_emplace(st
             bucket_it = bucket - ptr_offset_in_bytes_; // set bucket iterator to point to bucket's collision list front
         } ELSE {
             LOOP () {
+                profile_inc(&Profiler::record_t::num_probes, U32x1(1));
                 GOTO(equal_key(bucket_it, clone(key)), insert_entry); // clone key (see above)
                 const Var<Ptr<void>> next_bucket_it(
                     Ptr<void>(*(bucket_it + ptr_offset_in_bytes_).template to<uint32_t*>())
@@ -843,8 +960,10 @@ std::pair<HashTable::entry_t, Boolx1> ChainedHashTable<IsGlobal>::try_emplace(st
             Wasm_insist(*pred or bucket_it == bucket - ptr_offset_in_bytes_,
                         "predication dummy must always contain an empty collision list");
 
-        /*----- Set flag to indicate insertion. -----*/
+        /*----- Set flag to indicate insertion.  A collision occurs iff the collision list is not empty. -----*/
         entry_inserted = true;
+        profile_inc(&Profiler::record_t::num_collisions,
+                    (bucket_it != bucket - ptr_offset_in_bytes_).to<uint32_t>());
 
         /*----- Allocate memory for entry. -----*/
         Var<Ptr<void>> entry = Module::Allocator().allocate(entry_size_in_bytes_, entry_max_alignment_in_bytes_);
@@ -876,8 +995,10 @@ std::pair<HashTable::entry_t, Boolx1> ChainedHashTable<IsGlobal>::find(std::vect
         bucket_hint ? *bucket_hint : compute_bucket(clone(key)); // clone key since we need it again for comparison
 
     /*----- Probe collision list, abort if key already exists. -----*/
+    profile_inc(&Profiler::record_t::num_lookups, U32x1(1));
     Var<Ptr<void>> bucket_it(Ptr<void>(*bucket.to<uint32_t*>()));
     WHILE (not bucket_it.is_nullptr()) { // another entry in collision list
+        profile_inc(&Profiler::record_t::num_probes, U32x1(1));
         BREAK(equal_key(bucket_it, std::move(key))); // move key at last use
         bucket_it = Ptr<void>(*(bucket_it + ptr_offset_in_bytes_).template to<uint32_t*>());
     }
@@ -913,8 +1034,10 @@ void ChainedHashTable<IsGlobal>::for_each_in_equal_range(std::vector<SQL_t> key,
         bucket_hint ? *bucket_hint : compute_bucket(clone(key)); // clone key since we need it again for comparison
 
     /*----- Iterate over collision list entries and call pipeline (with entry handle argument) on matches. -----*/
+    profile_inc(&Profiler::record_t::num_lookups, U32x1(1));
     Var<Ptr<void>> bucket_it(Ptr<void>(*bucket.to<uint32_t*>()));
     WHILE (not bucket_it.is_nullptr()) { // another entry in collision list
+        profile_inc(&Profiler::record_t::num_probes, U32x1(1));
         if (predicated) {
             CodeGenContext::Get().env().add_predicate(equal_key(bucket_it, std::move(key)));
             Pipeline(entry(bucket_it));
@@ -1554,6 +1677,12 @@ void OpenAddressingHashTable<IsGlobal, ValueInPlace>::teardown()
     M_insist(bool(num_entries_), "must call `setup()` before");
     M_insist(bool(high_watermark_absolute_), "must call `setup()` before");
 
+    /*----- Account the size of the slots and the out-of-place values as the hash table only grows. -----*/
+    if constexpr (ValueInPlace)
+        profile_size(size_in_bytes());
+    else
+        profile_size(size_in_bytes() + *num_entries_ * uint32_t(layout_.values_size_in_bytes_));
+
     if constexpr (not IsGlobal) { // free memory of local hash table when user calls teardown method
         if constexpr (not ValueInPlace) {
             /*----- Free out-of-place values. -----*/
@@ -1681,6 +1810,11 @@ Ptr<void> OpenAddressingHashTable<IsGlobal, ValueInPlace>::emplace_without_rehas
         Wasm_insist(begin() <= slot and slot < end(), "slot out-of-bounds");
     }
 
+    /*----- Update profiling counters, i.e. a collision occurs iff the bucket is already occupied. -----*/
+    profile_inc(&Profiler::record_t::num_lookups, U32x1(1));
+    profile_inc(&Profiler::record_t::num_probes, refs + ref_t(1));
+    profile_inc(&Profiler::record_t::num_collisions, (refs != ref_t(0)).to<uint32_t>());
+
     /*----- Update reference count of this bucket. -----*/
     reference_count(bucket) = refs + ref_t(1); // no predication special case since bucket equals slot if dummy is used
 
@@ -1731,10 +1865,12 @@ OpenAddressingHashTable<IsGlobal, ValueInPlace>::try_emplace(std::vector<SQL_t>
     Var<PrimitiveExpr<ref_t>> refs(0);
 
     /*----- Probe slots, abort and skip insertion if key already exists. -----*/
+    profile_inc(&Profiler::record_t::num_lookups, U32x1(1));
     Var<Boolx1> entry_inserted(false);
     Var<Ptr<void>> slot(bucket.val());
     BLOCK(insert_entry) {
         WHILE (reference_count(slot) != ref_t(0)) {
+            profile_inc(&Profiler::record_t::num_probes, U32x1(1));
             GOTO(equal_key(slot, clone(key)), insert_entry); // clone key (see above)
             refs += ref_t(1);
             Wasm_insist(refs <= *num_entries_, "probing strategy has to find unoccupied slot if there is one");
@@ -1745,8 +1881,9 @@ OpenAddressingHashTable<IsGlobal, ValueInPlace>::try_emplace(std::vector<SQL_t>
         if (pred)
             Wasm_insist(*pred or refs == ref_t(0), "predication dummy must always be unoccupied");
 
-        /*----- Set flag to indicate insertion. -----*/
+        /*----- Set flag to indicate insertion.  A collision occurs iff the bucket is already occupied. -----*/
         entry_inserted = true;
+        profile_inc(&Profiler::record_t::num_collisions, (refs != ref_t(0)).to<uint32_t>());
 
         /*----- Update reference count of this bucket. -----*/
         Wasm_insist(reference_count(bucket) <= refs, "reference count must increase if unoccupied slot is found");
@@ -1805,8 +1942,10 @@ std::pair<HashTable::entry_t, Boolx1> OpenAddressingHashTable<IsGlobal, ValueInP
     /*----- Probe slots, abort if end of bucket is reached or key already exists. -----*/
     Var<Ptr<void>> slot(bucket);
     Var<PrimitiveExpr<ref_t>> steps(0);
+    profile_inc(&Profiler::record_t::num_lookups, U32x1(1));
     WHILE (steps != refs) {
         Wasm_insist(reference_count(slot) != ref_t(0), "slot in bucket list must be occupied");
+        profile_inc(&Profiler::record_t::num_probes, U32x1(1));
         BREAK(equal_key(slot, std::move(key))); // move key at last use
         steps += ref_t(1);
         Wasm_insist(steps <= *num_entries_, "probing strategy has to find unoccupied slot if there is one");
@@ -1855,6 +1994,8 @@ void OpenAddressingHashTable<IsGlobal, ValueInPlace>::for_each_in_equal_range(st
     const Var<PrimitiveExpr<ref_t>> refs(reference_count(bucket.clone()));
 
     /*----- Iterate over slots and call pipeline (with entry handle argument) on matches with the given key. -----*/
+    profile_inc(&Profiler::record_t::num_lookups, U32x1(1));
+    profile_inc(&Profiler::record_t::num_probes, refs.val());
     Var<Ptr<void>> slot(bucket);
     Var<PrimitiveExpr<ref_t>> steps(0);
     WHILE (steps != refs) { // end of bucket not reached
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "backend/WasmProfiler.hpp"
 #include "backend/WasmUtil.hpp"
 #include <mutable/parse/AST.hpp>
 #include <optional>
@@ -42,10 +43,15 @@ U64x1 murmur3_bit_mix(U64x1 bits);
 
 /** Hashes \p num_bytes bytes of \p bytes using the FNV-1a algorithm. */
 U64x1 fnv_1a(Ptr<U8x1> bytes, U32x1 num_bytes);
+/** Hashes the characters of the string \p str up to the first NUL byte or at most \p max_length characters.  Combines
+ * eight characters at a time into a 64 bit word and mixes each word using the Murmur3-64a algorithm.  The hash of a
+ * string does not depend on \p max_length. */
+U64x1 murmur3_64a_str_hash(Ptr<U8x1> str, uint32_t max_length);
 /** Hashes the string \p str. */
 U64x1 str_hash(NChar str);
 /** Hashes the elements of \p values where the first element is the type of the value to hash and the second element
- * is the value itself using the Murmur3-64a algorithm. */
+ * is the value itself using the Murmur3-64a algorithm.  Values are packed into as few 64 bit words as possible, such
+ * that composite keys of narrow values are hashed with few mixing steps. */
 U64x1 murmur3_64a_hash(std::vector<std::pair<const Type*, SQL_t>> values);
 
 
@@ -504,6 +510,7 @@ struct HashTable
     std::reference_wrapper<const Schema> schema_; ///< schema of hash table
     std::vector<index_t> key_indices_; ///< keys of hash table
     std::vector<index_t> value_indices_; ///< values of hash table
+    Profiler::record_t *profile_ = nullptr; ///< profiling record to account accesses to, iff profiled
 
     public:
     HashTable() = delete;
@@ -530,6 +537,15 @@ struct HashTable
 
     const Schema & schema() const { return schema_; }
 
+    /** Accounts all subsequently emitted accesses to `this` hash table to the physical operator match \p M iff the
+     * query is profiled. */
+    void profile(const m::MatchBase &M) {
+        if (Profiler::Get().active()) {
+            profile_ = &Profiler::Get().record(M);
+            profile_->uses_hash_table = 1;
+        }
+    }
+
     /** Performs the setup of the hash table.  Must be called before any call to a setup method, i.e. setting the
      * high watermark, or an access method, i.e. clearing, insertion, lookup, or dummy entry creation. */
     virtual void setup() = 0;
@@ -591,6 +607,21 @@ struct HashTable
     virtual entry_t dummy_entry() = 0;
 
     protected:
+    /** Emits code to increment the profiling counter \p counter by \p n iff `this` hash table is profiled. */
+    void profile_inc(uint32_t Profiler::record_t::*counter, U32x1 n) const {
+        if (profile_)
+            *Ptr<U32x1>(&(profile_->*counter)) += n;
+        else
+            n.discard();
+    }
+    /** Emits code to raise the profiled peak size of `this` hash table to \p bytes iff `this` hash table is profiled. */
+    void profile_size(U32x1 bytes) const {
+        if (profile_)
+            Profiler::update_peak(profile_->hash_table_bytes, bytes);
+        else
+            bytes.discard();
+    }
+
     /** Sets the byte offsets of an entry containing values of types \p types in \p offsets_in_bytes with the starting
      * offset at \p initial_offset_in_bytes and an initial alignment requirement of \p initial_max_alignment_in_bytes.
      * To minimize padding, the values are sorted by their alignment requirement.  Returns the byte size of an entry
@@ -934,8 +934,9 @@ struct Module final
     void set_feature(::wasm::FeatureSet feature, bool value) { module_.features.set(feature, value); }
 
     /** Returns the binary representation of `module_` in a freshly allocated memory.  The caller must dispose of this
-     * memory. */
-    std::pair<uint8_t*, std::size_t> binary();
+     * memory.  If \p with_names, the binary contains a names section s.t. the engine can report the names of the
+     * functions, e.g. to profilers. */
+    std::pair<uint8_t*, std::size_t> binary(bool with_names = false);
 
     private:
     void create_local_bitmap_stack();
@@ -4240,6 +4241,15 @@ struct PrimitiveExpr<T, L>
         return PrimitiveExpr<To, ToL>(addr_.move(), offset_);
     }
 
+    /** Explicit conversion of a `PrimitiveExpr<void*, 1>` to a `PrimitiveExpr<To, ToL>` *without* checking the
+     * alignment requirement of \tparam To, e.g. to load a word from a string.  WebAssembly permits unaligned loads and
+     * stores; they are potentially slower.  Only applicable if \tparam To is a pointer to primitive type. */
+    template<dsl_pointer_to_primitive To, std::size_t ToL = L>
+    requires (not std::is_void_v<std::remove_pointer_t<To>>)
+    PrimitiveExpr<To, ToL> to_unaligned() requires std::is_void_v<pointed_type> and (L == 1) {
+        return PrimitiveExpr<To, ToL>(addr_.move(), offset_);
+    }
+
     /** Explicit conversion of a `PrimitiveExpr<T*, L>` to a `PrimitiveExpr<uint32_t, 1>`.  Adds possible offset to
      * the pointer. */
     template<typename To, std::size_t ToL = 1>
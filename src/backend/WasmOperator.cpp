@@ -3,6 +3,7 @@
 #include "backend/Interpreter.hpp"
 #include "backend/WasmAlgo.hpp"
 #include "backend/WasmMacro.hpp"
+#include "storage/ZoneMap.hpp"
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/parse/AST.hpp>
 #include <mutable/util/fn.hpp>
@@ -31,7 +32,8 @@ static void add_wasm_operator_args()
         /* group=       */ "Wasm",
         /* short=       */ nullptr,
         /* long=        */ "--scan-implementations",
-        /* description= */ "a comma seperated list of physical scan implementations to consider (`Scan` or `IndexScan`)",
+        /* description= */ "a comma seperated list of physical scan implementations to consider (`Scan`, `IndexScan`, "
+                           "or `SkippingScan`)",
         /* callback=    */ [](std::vector<std::string_view> impls){
             options::scan_implementations = option_configs::ScanImplementation(0UL);
             for (const auto &elem : impls) {
@@ -39,6 +41,8 @@ static void add_wasm_operator_args()
                     options::scan_implementations |= option_configs::ScanImplementation::SCAN;
                 else if (strneq(elem.data(), "IndexScan", elem.size()))
                     options::scan_implementations |= option_configs::ScanImplementation::INDEX_SCAN;
+                else if (strneq(elem.data(), "SkippingScan", elem.size()))
+                    options::scan_implementations |= option_configs::ScanImplementation::SKIPPING_SCAN;
                 else
                     std::cerr << "warning: ignore invalid physical scan implementation " << elem << std::endl;
             }
@@ -557,6 +561,8 @@ void m::register_wasm_operators(PhysicalOptimizer &phys_opt)
         if (bool(options::index_implementations bitand option_configs::IndexImplementation::RMI))
             phys_opt.register_operator<IndexScan<idx::IndexMethod::Rmi>>();
     }
+    if (bool(options::scan_implementations bitand option_configs::ScanImplementation::SKIPPING_SCAN))
+        phys_opt.register_operator<SkippingScan>();
     if (bool(options::filter_selection_strategy bitand option_configs::SelectionStrategy::BRANCHING))
         phys_opt.register_operator<Filter<false>>();
     if (bool(options::filter_selection_strategy bitand option_configs::SelectionStrategy::PREDICATED))
@@ -1224,6 +1230,42 @@ void Print<SIMDfied>::execute(const Match<Print> &M, setup_t, pipeline_t, teardo
  * Scan
  *====================================================================================================================*/
 
+/** Returns the attributes scanned by \p scan that are known to be sorted, with their orders.  These are the longest
+ * prefix of the declared sort key of the scanned table whose attributes are all scanned, provided that all rows of the
+ * scanned store are sorted, i.e. no unsorted runs are pending (see `Store::num_sorted_rows()`), followed by the
+ * scanned attributes assumed to be sorted by the CLI options `--xxx-asc-sorted-attributes` and
+ * `--xxx-desc-sorted-attributes`. */
+Sortedness::order_t get_sorted_attributes(const ScanOperator &scan)
+{
+    Sortedness::order_t orders;
+    auto &schema = scan.schema();
+
+    /*----- Add the scanned prefix of the declared sort key.  Subsequent attributes of the sort key are only sorted
+     * among rows with equal values of the attributes not scanned. -----*/
+    if (scan.store().num_sorted_rows() == scan.store().num_rows()) {
+        for (auto [attr, ascending] : scan.store().table().sort_key()) {
+            Schema::Identifier id(scan.alias(), attr.get().name);
+            if (not schema.has(id))
+                break;
+            orders.add(std::move(id), ascending ? Sortedness::O_ASC : Sortedness::O_DESC);
+        }
+    }
+
+    /*----- Check if any other attribute of scanned table is assumed to be sorted. -----*/
+    for (auto &e : schema) {
+        if (orders.find(e.id) != orders.cend())
+            continue; // already sorted by the declared sort key
+        auto pred = [&e](const auto &p){ return e.id == p.first; };
+        if (auto it = std::find_if(options::sorted_attributes.cbegin(), options::sorted_attributes.cend(), pred);
+            it != options::sorted_attributes.cend())
+        {
+            orders.add(e.id, it->second ? Sortedness::O_ASC : Sortedness::O_DESC);
+        }
+    }
+
+    return orders;
+}
+
 template<bool SIMDfied>
 ConditionSet Scan<SIMDfied>::pre_condition(std::size_t child_idx,
                                            const std::tuple<const ScanOperator*> &partial_inner_nodes)
@@ -1266,17 +1308,8 @@ ConditionSet Scan<SIMDfied>::post_condition(const Match<Scan> &M)
         post_cond.add_condition(NoSIMD());
     }
 
-    /*----- Check if any attribute of scanned table is assumed to be sorted. -----*/
-    Sortedness::order_t orders;
-    for (auto &e : M.scan.schema()) {
-        auto pred = [&e](const auto &p){ return e.id == p.first; };
-        if (auto it = std::find_if(options::sorted_attributes.cbegin(), options::sorted_attributes.cend(), pred);
-            it != options::sorted_attributes.cend())
-        {
-            orders.add(e.id, it->second ? Sortedness::O_ASC : Sortedness::O_DESC);
-        }
-    }
-    if (not orders.empty())
+    /*----- Check if any attribute of scanned table is sorted. -----*/
+    if (auto orders = get_sorted_attributes(M.scan); not orders.empty())
         post_cond.add_condition(Sortedness(std::move(orders)));
 
     return post_cond;
@@ -1342,6 +1375,140 @@ void Scan<SIMDfied>::execute(const Match<Scan> &M, setup_t setup, pipeline_t pip
 }
 
 
+/*======================================================================================================================
+ * SkippingScan
+ *====================================================================================================================*/
+
+ConditionSet SkippingScan::pre_condition(std::size_t child_idx,
+                                         const std::tuple<const FilterOperator*, const ScanOperator*> &partial_inner_nodes)
+{
+    M_insist(child_idx == 0);
+
+    auto &filter = *std::get<0>(partial_inner_nodes);
+    auto &scan = *std::get<1>(partial_inner_nodes);
+
+    /*----- Skipping scan needs zones to skip, i.e. zone maps must be enabled. -----*/
+    if (scan.store().zone_map().zone_size() == 0)
+        return ConditionSet::Make_Unsatisfiable();
+
+    /*----- Skipping scan needs a filter condition on attributes to decide which zones to skip. -----*/
+    if (filter.filter().get_required().num_entries() == 0)
+        return ConditionSet::Make_Unsatisfiable();
+
+    return ConditionSet();
+}
+
+ConditionSet SkippingScan::post_condition(const Match<SkippingScan> &M)
+{
+    ConditionSet post_cond;
+
+    /*----- Skipping scan does not introduce predication. -----*/
+    post_cond.add_condition(Predicated(false));
+
+    /*----- Non-SIMDfied skipping scan does not introduce SIMD. -----*/
+    post_cond.add_condition(NoSIMD());
+
+    /*----- Skipping scan preserves the order of rows.  Check if any attribute of scanned table is sorted. -----*/
+    if (auto orders = get_sorted_attributes(M.scan); not orders.empty())
+        post_cond.add_condition(Sortedness(std::move(orders)));
+
+    return post_cond;
+}
+
+double SkippingScan::cost(const Match<SkippingScan> &M)
+{
+    /* Scanning and filtering costs as much as `Scan` and `Filter` do, but only for the rows that are not skipped.
+     * Additionally, iterating over the qualifying ranges has a constant overhead and every range requires to
+     * reinitialize the pointers into the data layout, which is costly when many small ranges are interleaved with
+     * skipped zones. */
+    auto &store = M.scan.store();
+    auto &zone_map = store.zone_map();
+    const auto ranges = zone_map.qualifying_ranges(M.filter.filter());
+    const std::size_t num_rows_scanned =
+        std::accumulate(ranges.cbegin(), ranges.cend(), 0UL, [](std::size_t sum, const auto &range) {
+            return sum + (range.second - range.first);
+        });
+    const std::size_t num_rows = store.num_rows();
+    const double fraction_scanned = num_rows ? double(num_rows_scanned) / num_rows : 1.0;
+    const std::size_t num_zones = (num_rows + zone_map.zone_size() - 1) / zone_map.zone_size();
+    const double fraction_ranges = num_zones ? double(ranges.size()) / num_zones : 0.0;
+
+    const cnf::CNF &cond = M.filter.filter();
+    const unsigned filter_cost =
+        std::accumulate(cond.cbegin(), cond.cend(), 0U, [](unsigned cost, const cnf::Clause &clause) {
+            return cost + clause.size();
+        });
+    return 1.0 + fraction_ranges + (2.0 + filter_cost) * fraction_scanned;
+}
+
+void SkippingScan::execute(const Match<SkippingScan> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown)
+{
+    auto &schema = M.scan.schema();
+    auto &store = M.scan.store();
+    auto &table = store.table();
+
+    M_insist(schema == schema.drop_constants().deduplicate(), "schema of `ScanOperator` must not contain NULL or duplicates");
+    M_insist(schema.num_entries() != 0, "filter condition must require at least one attribute");
+    M_insist(not table.layout().is_finite(), "layout for `wasm::SkippingScan` must be infinite");
+
+    /*----- Skipping scan does not support SIMD. -----*/
+    CodeGenContext::Get().set_num_simd_lanes(1);
+
+    /*----- Compute the ranges of rows which are not skipped and materialize them in memory. -----*/
+    /* Rows appended after summarizing the store are not covered by the zone map and must always be scanned.  Hence,
+     * append a last range from the end of the covered rows to the (runtime) number of rows. */
+    const std::size_t num_rows_covered = store.num_rows();
+    const auto ranges = store.zone_map().qualifying_ranges(M.filter.filter());
+    const std::size_t num_ranges = ranges.size() + 1;
+    uint32_t *ranges_address =
+        Module::Allocator().raw_malloc<uint32_t>(2 * num_ranges + 1); // +1 for storing number of ranges itself
+    uint32_t *ranges_ptr = ranges_address;
+    *ranges_ptr++ = num_ranges; // store in memory to enable caching
+    for (auto [begin, end] : ranges) {
+        M_insist(std::in_range<uint32_t>(end), "tuple id must fit in uint32_t");
+        *ranges_ptr++ = uint32_t(begin);
+        *ranges_ptr++ = uint32_t(end);
+    }
+    *ranges_ptr++ = uint32_t(std::max(num_rows_covered, ranges.empty() ? 0UL : ranges.back().second));
+    *ranges_ptr++ = std::numeric_limits<uint32_t>::max();
+
+    /*----- Import the number of rows and the base address of the mapped memory of `table`. -----*/
+    const Var<U32x1> num_rows(get_num_rows(table.name()));
+    Ptr<void> base_address = get_base_address(table.name());
+
+    /*----- Emit setup code *before* compiling data layout to not overwrite its temporary boolean variables. -----*/
+    setup();
+
+    /*----- Compile data layout to generate sequential load from table. -----*/
+    Var<U32x1> tuple_id;
+    static Schema empty_schema;
+    auto [inits, loads, jumps] = compile_load_sequential(schema, empty_schema, base_address, table.layout(),
+                                                         /* num_simd_lanes= */ 1, table.schema(M.scan.alias()),
+                                                         tuple_id);
+
+    /*----- Generate a loop over all ranges, with the actual scan and the filter emitted into the loop body. -----*/
+    Ptr<U32x1> base(ranges_address + 1); // +1 to skip stored number of ranges
+    Var<Ptr<U32x1>> range(base.clone());
+    const Var<Ptr<U32x1>> ranges_end(base + (U32x1(*Ptr<U32x1>(ranges_address)) * 2U).make_signed());
+    WHILE (range < ranges_end) {
+        tuple_id = U32x1(*range);
+        const Var<U32x1> range_end(Select(U32x1(*(range + 1)) < num_rows, U32x1(*(range + 1)), num_rows));
+        inits.attach_to_current();
+        WHILE (tuple_id < range_end) {
+            loads.attach_to_current();
+            IF (CodeGenContext::Get().env().compile<_Boolx1>(M.filter.filter()).is_true_and_not_null()) {
+                pipeline();
+            };
+            jumps.attach_to_current();
+        }
+        range += 2;
+    }
+
+    /*----- Emit teardown code. -----*/
+    teardown();
+}
+
+
 /*======================================================================================================================
  * Index Scan
  *====================================================================================================================*/
@@ -2575,6 +2742,7 @@ void HashBasedGrouping::execute(const Match<HashBasedGrouping> &M, setup_t setup
     } else {
         ht = std::make_unique<GlobalChainedHashTable>(ht_schema, std::move(key_indices), initial_capacity);
     }
+    ht->profile(M);
 
     /*----- Create child function. -----*/
     FUNCTION(hash_based_grouping_child_pipeline, void(void)) // create function for pipeline
@@ -4756,6 +4924,7 @@ void Quicksort<CmpPredicated>::execute(const Match<Quicksort> &M, setup_t setup,
     GlobalBuffer buffer(
         buffer_schema, *M.materializing_factory, false, 0, std::move(setup), std::move(pipeline), std::move(teardown)
     );
+    buffer.profile(M);
 
     /*----- Create child function. -----*/
     FUNCTION(sorting_child_pipeline, void(void)) // create function for pipeline
@@ -4908,6 +5077,8 @@ void NestedLoopsJoin<Predicated>::execute(const Match<NestedLoopsJoin> &M, setup
                 );
             }
 
+            buffers.back().profile(M);
+
             /*----- Materialize the current result tuple in pipeline. -----*/
             M.children[i]->execute(
                 /* setup=    */ setup_t::Make_Without_Parent([&](){ buffers.back().setup(); }),
@@ -5044,6 +5215,7 @@ void SimpleHashJoin<UniqueBuild, Predicated>::execute(const Match<SimpleHashJoin
     } else {
         ht = std::make_unique<GlobalChainedHashTable>(ht_schema, std::move(build_key_indices), initial_capacity);
     }
+    ht->profile(M);
 
     /*----- Create function for build child. -----*/
     FUNCTION(simple_hash_join_child_pipeline, void(void)) // create function for pipeline
@@ -5312,10 +5484,14 @@ void SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>::execute(
     const auto schema_parent = M.parent.schema().drop_constants().deduplicate();
     const auto schema_child  = M.child.schema().drop_constants().deduplicate();
     std::optional<GlobalBuffer> buffer_parent, buffer_child;
-    if (needs_buffer_parent)
+    if (needs_buffer_parent) {
         buffer_parent.emplace(schema_parent, *M.left_materializing_factory);
-    if (needs_buffer_child)
+        buffer_parent->profile(M);
+    }
+    if (needs_buffer_child) {
         buffer_child.emplace(schema_child, *M.right_materializing_factory);
+        buffer_child->profile(M);
+    }
 
     /*----- Create child functions. -----*/
     if (needs_buffer_parent) {
@@ -5654,6 +5830,7 @@ void HashBasedGroupJoin::execute(const Match<HashBasedGroupJoin> &M, setup_t set
     } else {
         ht = std::make_unique<GlobalChainedHashTable>(ht_schema, std::move(key_indices), initial_capacity);
     }
+    ht->profile(M);
 
     std::optional<HashTable::entry_t> dummy; ///< *local* dummy slot
 
@@ -6260,17 +6437,38 @@ void HashBasedGroupJoin::execute(const Match<HashBasedGroupJoin> &M, setup_t set
 struct print_info
 {
     const Operator &op;
+    const m::MatchBase *match; ///< the physical operator match whose runtime statistics to print, if profiled
 
     friend std::ostream & operator<<(std::ostream &out, const print_info &info) {
         if (info.op.has_info())
             out << " <" << info.op.info().estimated_cardinality << '>';
+        if (auto stats = Profiler::Get().statistics(*info.match)) {
+            out << " [actual " << stats->num_tuples;
+            if (info.op.has_info()) {
+                /* Report the misestimation as q-error, i.e. the factor by which the estimate is off. */
+                const double estimated = std::max<double>(info.op.info().estimated_cardinality, 1);
+                const double actual = std::max<double>(stats->num_tuples, 1);
+                out << ", q-error " << std::max(estimated / actual, actual / estimated);
+            }
+            out << ", pipeline " << stats->pipeline_time_ns / 1e6 << " ms in " << stats->num_pipeline_invocations
+                << " invocation" << (stats->num_pipeline_invocations == 1 ? "" : "s");
+            if (stats->uses_hash_table) {
+                out << ", hash table " << stats->num_lookups << " lookups, "
+                    << (stats->num_lookups ? double(stats->num_probes) / stats->num_lookups : 0.)
+                    << " probes/lookup, " << stats->num_collisions << " collisions, "
+                    << stats->hash_table_bytes / 1024. << " KiB";
+            }
+            if (stats->buffer_bytes)
+                out << ", buffer " << stats->buffer_bytes / 1024. << " KiB";
+            out << ']';
+        }
         return out;
     }
 };
 
 void Match<m::wasm::NoOp>::print(std::ostream &out, unsigned level) const
 {
-    indent(out, level) << "wasm::NoOp" << print_info(this->noop) << " (cumulative cost " << cost() << ')';
+    indent(out, level) << "wasm::NoOp" << print_info(this->noop, this) << " (cumulative cost " << cost() << ')';
     this->child->print(out, level + 1);
 }
 
@@ -6278,7 +6476,7 @@ template<bool SIMDfied>
 void Match<m::wasm::Callback<SIMDfied>>::print(std::ostream &out, unsigned level) const
 {
     indent(out, level) << "wasm::Callback with " << this->result_set_window_size << " tuples result set "
-                       << this->callback.schema() << print_info(this->callback)
+                       << this->callback.schema() << print_info(this->callback, this)
                        << " (cumulative cost " << cost() << ')';
     this->child->print(out, level + 1);
 }
@@ -6287,7 +6485,7 @@ template<bool SIMDfied>
 void Match<m::wasm::Print<SIMDfied>>::print(std::ostream &out, unsigned level) const
 {
     indent(out, level) << "wasm::Print with " << this->result_set_window_size << " tuples result set "
-                       << this->print_op.schema() << print_info(this->print_op)
+                       << this->print_op.schema() << print_info(this->print_op, this)
                        << " (cumulative cost " << cost() << ')';
     this->child->print(out, level + 1);
 }
@@ -6298,7 +6496,15 @@ void Match<m::wasm::Scan<SIMDfied>>::print(std::ostream &out, unsigned level) co
     indent(out, level) << (SIMDfied ? "wasm::SIMDScan(" : "wasm::Scan(") << this->scan.alias() << ") ";
     if (this->buffer_factory_ and this->scan.schema().drop_constants().deduplicate().num_entries())
         out << "with " << this->buffer_num_tuples_ << " tuples output buffer ";
-    out << this->scan.schema() << print_info(this->scan) << " (cumulative cost " << cost() << ')';
+    out << this->scan.schema() << print_info(this->scan, this) << " (cumulative cost " << cost() << ')';
+}
+
+void Match<m::wasm::SkippingScan>::print(std::ostream &out, unsigned level) const
+{
+    indent(out, level) << "wasm::SkippingScan(" << this->scan.alias() << ", " << this->filter.filter() << ") ";
+    if (this->buffer_factory_ and this->scan.schema().drop_constants().deduplicate().num_entries())
+        out << "with " << this->buffer_num_tuples_ << " tuples output buffer ";
+    out << this->scan.schema() << print_info(this->scan, this) << " (cumulative cost " << cost() << ')';
 }
 
 template<idx::IndexMethod IndexMethod>
@@ -6348,7 +6554,7 @@ void Match<m::wasm::IndexScan<IndexMethod>>::print(std::ostream &out, unsigned l
     out << "], " << this->scan.alias() << ", " << this->filter.filter() << ") ";
     if (this->buffer_factory_ and this->scan.schema().drop_constants().deduplicate().num_entries())
         out << "with " << this->buffer_num_tuples_ << " tuples output buffer ";
-    out << this->scan.schema() << print_info(this->scan) << " (cumulative cost " << cost() << ')';
+    out << this->scan.schema() << print_info(this->scan, this) << " (cumulative cost " << cost() << ')';
 }
 
 template<bool Predicated>
@@ -6357,7 +6563,7 @@ void Match<m::wasm::Filter<Predicated>>::print(std::ostream &out, unsigned level
     indent(out, level) << "wasm::" << (Predicated ? "Predicated" : "Branching") << "Filter ";
     if (this->buffer_factory_ and this->filter.schema().drop_constants().deduplicate().num_entries())
         out << "with " << this->buffer_num_tuples_ << " tuples output buffer ";
-    out << this->filter.schema() << print_info(this->filter) << " (cumulative cost " << cost() << ')';
+    out << this->filter.schema() << print_info(this->filter, this) << " (cumulative cost " << cost() << ')';
     this->child->print(out, level + 1);
 }
 
@@ -6371,7 +6577,7 @@ void Match<m::wasm::LazyDisjunctiveFilter>::print(std::ostream &out, unsigned le
         if (it != clause.cbegin()) out << " → ";
         out << *it;
     }
-    out << ' ' << this->filter.schema() << print_info(this->filter) << " (cumulative cost " << cost() << ')';
+    out << ' ' << this->filter.schema() << print_info(this->filter, this) << " (cumulative cost " << cost() << ')';
     this->child->print(out, level + 1);
 }
 
@@ -6380,28 +6586,28 @@ void Match<m::wasm::Projection>::print(std::ostream &out, unsigned level) const
     indent(out, level) << "wasm::Projection ";
     if (this->buffer_factory_ and this->projection.schema().drop_constants().deduplicate().num_entries())
         out << "with " << this->buffer_num_tuples_ << " tuples output buffer ";
-    out << this->projection.schema() << print_info(this->projection) << " (cumulative cost " << cost() << ')';
+    out << this->projection.schema() << print_info(this->projection, this) << " (cumulative cost " << cost() << ')';
     if (this->child)
         this->child->get()->print(out, level + 1);
 }
 
 void Match<m::wasm::HashBasedGrouping>::print(std::ostream &out, unsigned level) const
 {
-    indent(out, level) << "wasm::HashBasedGrouping " << this->grouping.schema() << print_info(this->grouping)
+    indent(out, level) << "wasm::HashBasedGrouping " << this->grouping.schema() << print_info(this->grouping, this)
                        << " (cumulative cost " << cost() << ')';
     this->child->print(out, level + 1);
 }
 
 void Match<m::wasm::OrderedGrouping>::print(std::ostream &out, unsigned level) const
 {
-    indent(out, level) << "wasm::OrderedGrouping " << this->grouping.schema() << print_info(this->grouping)
+    indent(out, level) << "wasm::OrderedGrouping " << this->grouping.schema() << print_info(this->grouping, this)
                        << " (cumulative cost " << cost() << ')';
     this->child->print(out, level + 1);
 }
 
 void Match<m::wasm::Aggregation>::print(std::ostream &out, unsigned level) const
 {
-    indent(out, level) << "wasm::Aggregation " << this->aggregation.schema() << print_info(this->aggregation)
+    indent(out, level) << "wasm::Aggregation " << this->aggregation.schema() << print_info(this->aggregation, this)
                        << " (cumulative cost " << cost() << ')';
     this->child->print(out, level + 1);
 }
@@ -6410,13 +6616,13 @@ template<bool CmpPredicated>
 void Match<m::wasm::Quicksort<CmpPredicated>>::print(std::ostream &out, unsigned level) const
 {
     indent(out, level) << "wasm::" << (CmpPredicated ? "Predicated" : "") << "Quicksort " << this->sorting.schema()
-                       << print_info(this->sorting) << " (cumulative cost " << cost() << ')';
+                       << print_info(this->sorting, this) << " (cumulative cost " << cost() << ')';
     this->child->print(out, level + 1);
 }
 
 void Match<m::wasm::NoOpSorting>::print(std::ostream &out, unsigned level) const
 {
-    indent(out, level) << "wasm::NoOpSorting" << print_info(this->sorting) << " (cumulative cost " << cost() << ')';
+    indent(out, level) << "wasm::NoOpSorting" << print_info(this->sorting, this) << " (cumulative cost " << cost() << ')';
     this->child->print(out, level + 1);
 }
 
@@ -6426,7 +6632,7 @@ void Match<m::wasm::NestedLoopsJoin<Predicated>>::print(std::ostream &out, unsig
     indent(out, level) << "wasm::" << (Predicated ? "Predicated" : "") << "NestedLoopsJoin ";
     if (this->buffer_factory_ and this->join.schema().drop_constants().deduplicate().num_entries())
         out << "with " << this->buffer_num_tuples_ << " tuples output buffer ";
-    out << this->join.schema() << print_info(this->join) << " (cumulative cost " << cost() << ')';
+    out << this->join.schema() << print_info(this->join, this) << " (cumulative cost " << cost() << ')';
 
     ++level;
     std::size_t i = this->children.size();
@@ -6444,7 +6650,7 @@ void Match<m::wasm::SimpleHashJoin<Unique, Predicated>>::print(std::ostream &out
     if (Unique) out << " on UNIQUE key ";
     if (this->buffer_factory_ and this->join.schema().drop_constants().deduplicate().num_entries())
         out << "with " << this->buffer_num_tuples_ << " tuples output buffer ";
-    out << this->join.schema() << print_info(this->join) << " (cumulative cost " << cost() << ')';
+    out << this->join.schema() << print_info(this->join, this) << " (cumulative cost " << cost() << ')';
 
     ++level;
     const m::wasm::MatchBase &build = *this->children[0];
@@ -6475,7 +6681,7 @@ void Match<m::wasm::SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated
         out << "and materializing left input ";
     else if (needs_buffer_child)
         out << "and materializing right input ";
-    out << this->join.schema() << print_info(this->join) << " (cumulative cost " << cost() << ')';
+    out << this->join.schema() << print_info(this->join, this) << " (cumulative cost " << cost() << ')';
 
     ++level;
     const m::wasm::MatchBase &left  = *this->children[0];
@@ -6488,7 +6694,7 @@ void Match<m::wasm::SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated
 
 void Match<m::wasm::Limit>::print(std::ostream &out, unsigned level) const
 {
-    indent(out, level) << "wasm::Limit " << this->limit.schema() << print_info(this->limit)
+    indent(out, level) << "wasm::Limit " << this->limit.schema() << print_info(this->limit, this)
                        << " (cumulative cost " << cost() << ')';
     this->child->print(out, level + 1);
 }
@@ -6498,7 +6704,7 @@ void Match<m::wasm::HashBasedGroupJoin>::print(std::ostream &out, unsigned level
     indent(out, level) << "wasm::HashBasedGroupJoin ";
     if (this->buffer_factory_ and this->grouping.schema().drop_constants().deduplicate().num_entries())
         out << "with " << this->buffer_num_tuples_ << " tuples output buffer ";
-    out << this->grouping.schema() << print_info(this->grouping) << " (cumulative cost " << cost() << ')';
+    out << this->grouping.schema() << print_info(this->grouping, this) << " (cumulative cost " << cost() << ')';
 
     ++level;
     const m::wasm::MatchBase &build = *this->children[0];
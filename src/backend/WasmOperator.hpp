@@ -1,5 +1,6 @@
 #pragma once
 
+#include "backend/WasmProfiler.hpp"
 #include "backend/WasmUtil.hpp"
 #include <mutable/IR/PhysicalOptimizer.hpp>
 #include <mutable/storage/DataLayoutFactory.hpp>
@@ -20,9 +21,10 @@ namespace option_configs {
 
 /*----- algorithmic decisions ----------------------------------------------------------------------------------------*/
 enum class ScanImplementation : uint64_t {
-    ALL        = 0b11,
-    SCAN       = 0b01,
-    INDEX_SCAN = 0b10,
+    ALL           = 0b111,
+    SCAN          = 0b001,
+    INDEX_SCAN    = 0b010,
+    SKIPPING_SCAN = 0b100,
 };
 
 enum class GroupingImplementation : uint64_t {
@@ -233,6 +235,7 @@ namespace m {
 
 #define M_WASM_OPERATOR_LIST_NON_TEMPLATED(X) \
     X(NoOp) \
+    X(SkippingScan) \
     X(LazyDisjunctiveFilter) \
     X(Projection) \
     X(HashBasedGrouping) \
@@ -404,6 +407,17 @@ struct IndexScan : PhysicalOperator<IndexScan<IndexMethod>, pattern_t<FilterOper
     static ConditionSet post_condition(const Match<IndexScan> &M);
 };
 
+/** Scans a table and filters its rows, skipping all zones of the table's `storage::ZoneMap` that cannot contain a
+ * qualifying row. */
+struct SkippingScan : PhysicalOperator<SkippingScan, pattern_t<FilterOperator, ScanOperator>>
+{
+    static void execute(const Match<SkippingScan> &M, setup_t setup, pipeline_t pipeline, teardown_t teardown);
+    static double cost(const Match<SkippingScan> &M);
+    static ConditionSet pre_condition(std::size_t child_idx,
+                                      const std::tuple<const FilterOperator*, const ScanOperator*> &partial_inner_nodes);
+    static ConditionSet post_condition(const Match<SkippingScan> &M);
+};
+
 template<bool Predicated>
 struct Filter : PhysicalOperator<Filter<Predicated>, FilterOperator>
 {
@@ -613,8 +627,20 @@ namespace wasm {
 /** An abstract `MatchBase` for the `WasmV8` backend.  Adds accept methods for respective visitor.  */
 struct MatchBase : m::MatchBase
 {
+    /** Executes this physical operator match.  Iff the query is profiled, the callbacks are instrumented to record
+     * runtime statistics of this match before `execute_impl()` is invoked. */
+    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const final {
+        if (Profiler::Get().active())
+            Profiler::Get().instrument(*this, setup, pipeline, teardown);
+        execute_impl(std::move(setup), std::move(pipeline), std::move(teardown));
+    }
+
     virtual void accept(MatchBaseVisitor &v) = 0;
     virtual void accept(ConstMatchBaseVisitor &v) const = 0;
+
+    protected:
+    /** Emits the code of this physical operator match.  See `m::MatchBase::execute()`. */
+    virtual void execute_impl(setup_t setup, pipeline_t pipeline, teardown_t teardown) const = 0;
 };
 
 /** Intermediate match type for leaves, i.e. physical operator matches without children. */
@@ -659,7 +685,7 @@ struct Match<wasm::NoOp> : wasm::MatchSingleChild
         , noop(*noop)
     { }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_impl(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         wasm::NoOp::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -685,7 +711,7 @@ struct Match<wasm::Callback<SIMDfied>> : wasm::MatchSingleChild
         , callback(*callback)
     { }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_impl(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         wasm::Callback<SIMDfied>::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -711,7 +737,7 @@ struct Match<wasm::Print<SIMDfied>> : wasm::MatchSingleChild
         , print_op(*print)
     { }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_impl(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         wasm::Print<SIMDfied>::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -742,7 +768,7 @@ struct Match<wasm::Scan<SIMDfied>> : wasm::MatchLeaf
         M_insist(children.empty());
     }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_impl(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         if (buffer_factory_) {
             auto buffer_schema = scan.schema().drop_constants().deduplicate();
             if (buffer_schema.num_entries()) {
@@ -797,7 +823,42 @@ struct Match<wasm::IndexScan<IndexMethod>> : wasm::MatchLeaf
         M_insist(children.empty());
     }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_impl(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+        execute_buffered(*this, filter.schema(), buffer_factory_, buffer_num_tuples_,
+                         std::move(setup), std::move(pipeline), std::move(teardown));
+    }
+
+    const Operator & get_matched_root() const override { return filter; }
+
+    void accept(wasm::MatchBaseVisitor &v) override;
+    void accept(wasm::ConstMatchBaseVisitor &v) const override;
+
+    protected:
+    void print(std::ostream &out, unsigned level) const override;
+};
+
+template<>
+struct Match<wasm::SkippingScan> : wasm::MatchLeaf
+{
+    const ScanOperator &scan;
+    const FilterOperator &filter;
+    private:
+    std::unique_ptr<const storage::DataLayoutFactory> buffer_factory_ =
+        bool(options::soft_pipeline_breaker bitand option_configs::SoftPipelineBreakerStrategy::AFTER_FILTER)
+            ? M_notnull(options::soft_pipeline_breaker_layout.get())->clone()
+            : std::unique_ptr<storage::DataLayoutFactory>();
+    std::size_t buffer_num_tuples_ = options::soft_pipeline_breaker_num_tuples;
+
+    public:
+    Match(const FilterOperator *filter, const ScanOperator *scan,
+          std::vector<unsharable_shared_ptr<const m::MatchBase>> &&children)
+        : scan(*scan)
+        , filter(*filter)
+    {
+        M_insist(children.empty());
+    }
+
+    void execute_impl(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         execute_buffered(*this, filter.schema(), buffer_factory_, buffer_num_tuples_,
                          std::move(setup), std::move(pipeline), std::move(teardown));
     }
@@ -828,7 +889,7 @@ struct Match<wasm::Filter<Predicated>> : wasm::MatchSingleChild
         , filter(*filter)
     { }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_impl(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         execute_buffered(*this, filter.schema(), buffer_factory_, buffer_num_tuples_,
                          std::move(setup), std::move(pipeline), std::move(teardown));
     }
@@ -859,7 +920,7 @@ struct Match<wasm::LazyDisjunctiveFilter> : wasm::MatchSingleChild
         , filter(*filter)
     { }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_impl(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         execute_buffered(*this, filter.schema(), buffer_factory_, buffer_num_tuples_,
                          std::move(setup), std::move(pipeline), std::move(teardown));
     }
@@ -895,7 +956,7 @@ struct Match<wasm::Projection> : wasm::MatchBase
         }
     }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_impl(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         execute_buffered(*this, projection.schema(), buffer_factory_, buffer_num_tuples_,
                          std::move(setup), std::move(pipeline), std::move(teardown));
     }
@@ -925,7 +986,7 @@ struct Match<wasm::HashBasedGrouping> : wasm::MatchSingleChild
         , grouping(*grouping)
     { }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_impl(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         wasm::HashBasedGrouping::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -948,7 +1009,7 @@ struct Match<wasm::OrderedGrouping> : wasm::MatchSingleChild
         , grouping(*grouping)
     { }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_impl(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         wasm::OrderedGrouping::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -971,7 +1032,7 @@ struct Match<wasm::Aggregation> : wasm::MatchSingleChild
         , aggregation(*aggregation)
     { }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_impl(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         wasm::Aggregation::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -996,7 +1057,7 @@ struct Match<wasm::Quicksort<CmpPredicated>> : wasm::MatchSingleChild
         , sorting(*sorting)
     { }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_impl(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         wasm::Quicksort<CmpPredicated>::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -1019,7 +1080,7 @@ struct Match<wasm::NoOpSorting> : wasm::MatchSingleChild
         , sorting(*sorting)
     { }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_impl(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         wasm::NoOpSorting::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -1053,7 +1114,7 @@ struct Match<wasm::NestedLoopsJoin<Predicated>> : wasm::MatchMultipleChildren
             materializing_factories_.push_back(M_notnull(options::hard_pipeline_breaker_layout.get())->clone());
     }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_impl(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         execute_buffered(*this, join.schema(), buffer_factory_, buffer_num_tuples_,
                          std::move(setup), std::move(pipeline), std::move(teardown));
     }
@@ -1097,7 +1158,7 @@ struct Match<wasm::SimpleHashJoin<UniqueBuild, Predicated>> : wasm::MatchMultipl
         M_insist(children.size() == 2);
     }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_impl(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         execute_buffered(*this, join.schema(), buffer_factory_, buffer_num_tuples_,
                          std::move(setup), std::move(pipeline), std::move(teardown));
     }
@@ -1132,7 +1193,7 @@ struct Match<wasm::SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>
         M_insist(children.size() == 2);
     }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_impl(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         wasm::SortMergeJoin<SortLeft, SortRight, Predicated, CmpPredicated>::execute(
             *this, std::move(setup), std::move(pipeline), std::move(teardown)
         );
@@ -1157,7 +1218,7 @@ struct Match<wasm::Limit> : wasm::MatchSingleChild
         , limit(*limit)
     { }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_impl(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         wasm::Limit::execute(*this, std::move(setup), std::move(pipeline), std::move(teardown));
     }
 
@@ -1202,7 +1263,7 @@ struct Match<wasm::HashBasedGroupJoin> : wasm::MatchMultipleChildren
         M_insist(children.size() == 2);
     }
 
-    void execute(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
+    void execute_impl(setup_t setup, pipeline_t pipeline, teardown_t teardown) const override {
         execute_buffered(*this, grouping.schema(), buffer_factory_, buffer_num_tuples_,
                          std::move(setup), std::move(pipeline), std::move(teardown));
     }
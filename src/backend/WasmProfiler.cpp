@@ -0,0 +1,129 @@
+#include "backend/WasmProfiler.hpp"
+
+#include "backend/WasmMacro.hpp"
+
+
+using namespace m;
+using namespace m::wasm;
+
+
+Profiler::record_t & Profiler::record(const m::MatchBase &M)
+{
+    M_insist(active_, "profiler must be active");
+    auto [it, inserted] = records_.try_emplace(&M, nullptr);
+    if (inserted) {
+        it->second = static_cast<record_t*>(Module::Allocator().raw_allocate(sizeof(record_t), alignof(record_t)));
+        *it->second = record_t(); // zero-initialize counters
+    }
+    return *it->second;
+}
+
+void Profiler::instrument(const m::MatchBase &M, setup_t &setup, pipeline_t &pipeline, teardown_t &teardown)
+{
+    record_t *rec = &record(M);
+
+    /*----- Record when the pipeline, in which `M` produces its results, is entered. -----*/
+    setup = setup_t(std::move(setup), [rec](){
+        *Ptr<Doublex1>(&rec->pipeline_begin_ns) = now();
+    });
+
+    /*----- Count the tuples produced by `M`, i.e. the tuples passed to the pipeline of its parent. -----*/
+    if (pipeline) { // the root operator has no parent pipeline, its results are counted by `collect()`
+        pipeline = [rec, pipeline=std::move(pipeline)](){
+            auto &env = CodeGenContext::Get().env();
+            if (env.predicated()) {
+                switch (CodeGenContext::Get().num_simd_lanes()) {
+                    default: M_unreachable("invalid number of simd lanes");
+                    case  1: {
+                        *Ptr<U32x1>(&rec->num_tuples) +=
+                            env.get_predicate<_Boolx1>().is_true_and_not_null().to<uint32_t>();
+                        break;
+                    }
+                    case 16: {
+                        auto pred = env.get_predicate<_Boolx16>().is_true_and_not_null();
+                        *Ptr<U32x1>(&rec->num_tuples) += pred.bitmask().popcnt();
+                        break;
+                    }
+                    case 32: {
+                        auto pred = env.get_predicate<_Boolx32>().is_true_and_not_null();
+                        *Ptr<U32x1>(&rec->num_tuples) += pred.bitmask().popcnt();
+                        break;
+                    }
+                }
+            } else {
+                *Ptr<U32x1>(&rec->num_tuples) += uint32_t(CodeGenContext::Get().num_simd_lanes());
+            }
+            pipeline();
+        };
+    }
+
+    /*----- Accumulate the time spent in the pipeline when it is left. -----*/
+    teardown = teardown_t(std::move(teardown), [rec](){
+        Doublex1 begin = *Ptr<Doublex1>(&rec->pipeline_begin_ns);
+        *Ptr<Doublex1>(&rec->pipeline_time_ns) += now() - begin;
+        *Ptr<U32x1>(&rec->num_pipeline_invocations) += 1U;
+    });
+}
+
+PrimitiveExpr<double> Profiler::now()
+{
+    return Module::Get().emit_call<double>("profile_now");
+}
+
+void Profiler::update_peak(uint32_t &counter, U32x1 bytes)
+{
+    const Var<U32x1> current(*Ptr<U32x1>(&counter));
+    *Ptr<U32x1>(&counter) = Select(current > bytes.clone(), current, bytes);
+}
+
+void Profiler::record_memory()
+{
+    M_insist(not memory_record_, "must not record the memory consumption twice");
+    memory_record_ = static_cast<memory_record_t*>(
+        Module::Allocator().raw_allocate(sizeof(memory_record_t), alignof(memory_record_t))
+    );
+    *memory_record_ = memory_record_t(); // zero-initialize counters
+    *Ptr<U32x1>(&memory_record_->allocated_bytes) = Module::Allocator().allocated_memory_consumption();
+    *Ptr<U32x1>(&memory_record_->peak_allocated_bytes) = Module::Allocator().allocated_memory_peak();
+}
+
+void Profiler::collect_memory(std::size_t resident_bytes, std::size_t heap_capacity_bytes)
+{
+    M_insist(bool(memory_record_), "memory consumption was not recorded");
+    auto &stats = memory_statistics_.emplace();
+    stats.pre_allocated_bytes = Module::Allocator().pre_allocated_memory_consumption();
+    stats.allocated_bytes = memory_record_->allocated_bytes; // copy from Wasm memory
+    stats.peak_allocated_bytes = memory_record_->peak_allocated_bytes; // copy from Wasm memory
+    stats.resident_bytes = resident_bytes;
+    stats.heap_capacity_bytes = heap_capacity_bytes;
+    stats.process = memory::usage_t::Get();
+    memory_record_ = nullptr;
+}
+
+void Profiler::memory_statistics_t::print(std::ostream &out) const
+{
+    constexpr double MiB = 1024. * 1024.;
+    out << "Pre-allocated memory overall consumption: " << pre_allocated_bytes / MiB << " MiB\n"
+        << "Allocated memory overall consumption: " << allocated_bytes / MiB << " MiB\n"
+        << "Allocated memory peak consumption: " << peak_allocated_bytes / MiB << " MiB\n"
+        << "Resident heap memory: " << resident_bytes / MiB << " MiB\n"
+        << "Heap utilization: " << 100. * heap_utilization() << " % of " << heap_capacity_bytes / MiB << " MiB\n"
+        << "Process resident memory: " << process.resident / MiB << " MiB (peak " << process.peak_resident / MiB
+        << " MiB)" << std::endl;
+}
+
+void Profiler::collect(const m::MatchBase &root, uint32_t num_rows)
+{
+    M_insist(active_, "profiler must be active");
+    for (auto [M, rec] : records_)
+        statistics_.emplace(M, *rec); // copy from Wasm memory
+    records_.clear();
+    statistics_[&root].num_tuples = num_rows;
+
+    /*----- Provide the observed cardinalities to the logical plan, e.g. for cardinality feedback. -----*/
+    for (auto &[M, rec] : statistics_) {
+        if (auto &op = M->get_matched_root(); op.has_info())
+            op.info().observed_cardinality = rec.num_tuples;
+    }
+    active_ = false;
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "backend/WasmUtil.hpp"
+#include <cstdint>
+#include <mutable/IR/PhysicalOptimizer.hpp>
+#include <mutable/util/memory.hpp>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+
+
+namespace m {
+
+namespace wasm {
+
+/** The `Profiler` collects runtime statistics of the physical operators of a query, e.g. to implement `EXPLAIN
+ * ANALYZE`.
+ *
+ * During code generation, every profiled physical operator match is assigned a `record_t` of counters which is
+ * pre-allocated in the memory of the Wasm module.  The generated code updates these counters in place.  After
+ * execution, `collect()` copies all records to the host such that they outlive the Wasm module and its memory.
+ *
+ * The time of an operator is the time spent in the pipeline in which the operator produces its results, measured by
+ * a host clock imported into the Wasm module.  Hence, all operators of the same pipeline report the same time.
+ */
+struct Profiler
+{
+    /** Counters of a single physical operator match.  Lives in the memory of the Wasm module and is thus restricted to
+     * primitive types. */
+    struct record_t
+    {
+        uint32_t num_tuples; ///< number of tuples produced by the operator
+        uint32_t num_pipeline_invocations; ///< number of executions of the pipeline the operator produces tuples in
+        uint32_t num_lookups; ///< number of accesses to the hash table of the operator
+        uint32_t num_probes; ///< number of slots resp. collision list entries visited by these accesses
+        uint32_t num_collisions; ///< number of insertions into already occupied buckets
+        uint32_t uses_hash_table; ///< whether the hash table counters are maintained for the operator
+        uint32_t hash_table_bytes; ///< peak size of the hash table of the operator in bytes
+        uint32_t buffer_bytes; ///< peak size of a materialization buffer of the operator in bytes
+        double pipeline_begin_ns; ///< host time at which the pipeline was entered last
+        double pipeline_time_ns; ///< overall host time spent in the pipeline
+    };
+    static_assert(std::is_trivial_v<record_t>, "record must be placeable in the Wasm memory");
+
+    /** Counters of the runtime allocations of an entire query.  Lives in the memory of the Wasm module. */
+    struct memory_record_t
+    {
+        uint32_t allocated_bytes; ///< overall number of bytes allocated at runtime
+        uint32_t peak_allocated_bytes; ///< peak number of bytes allocated at runtime at the same time
+    };
+    static_assert(std::is_trivial_v<memory_record_t>, "record must be placeable in the Wasm memory");
+
+    /** Memory consumption of an entire query, collected after its execution. */
+    struct memory_statistics_t
+    {
+        std::size_t pre_allocated_bytes = 0; ///< number of bytes pre-allocated at compile time
+        std::size_t allocated_bytes = 0; ///< overall number of bytes allocated at runtime
+        std::size_t peak_allocated_bytes = 0; ///< peak number of bytes allocated at runtime at the same time
+        std::size_t resident_bytes = 0; ///< number of bytes of the heap backed by physical pages after execution
+        std::size_t heap_capacity_bytes = 0; ///< size of the heap, i.e. the linear memory available for allocations
+        memory::usage_t process; ///< memory usage of the entire process after execution
+
+        /** Returns the fraction of the heap capacity occupied at peak. */
+        double heap_utilization() const {
+            return heap_capacity_bytes ? double(pre_allocated_bytes + peak_allocated_bytes) / heap_capacity_bytes
+                                       : 0.;
+        }
+
+        /** Prints the memory consumption to \p out. */
+        void print(std::ostream &out) const;
+    };
+
+    private:
+    bool active_ = false; ///< whether the code currently generated is profiled
+    ///> records of the currently generated Wasm module, living in its memory
+    std::unordered_map<const m::MatchBase*, record_t*> records_;
+    ///> records collected from the last executed Wasm module, living on the host
+    std::unordered_map<const m::MatchBase*, record_t> statistics_;
+    ///> memory record of the currently generated Wasm module, living in its memory
+    memory_record_t *memory_record_ = nullptr;
+    ///> memory consumption collected from the last executed Wasm module
+    std::optional<memory_statistics_t> memory_statistics_;
+
+    Profiler() = default;
+    Profiler(const Profiler&) = delete;
+
+    public:
+    /** Returns the thread-local profiler. */
+    static Profiler & Get() {
+        static thread_local Profiler the_profiler;
+        return the_profiler;
+    }
+
+    /** Discards all records and statistics of the previous query and profiles the next query iff \p active. */
+    void reset(bool active) {
+        active_ = active;
+        records_.clear();
+        statistics_.clear();
+        memory_record_ = nullptr;
+        memory_statistics_.reset();
+    }
+
+    /** Returns `true` iff the code currently generated is profiled. */
+    bool active() const { return active_; }
+
+    /** Returns the record of the physical operator match \p M.  The record is allocated in the memory of the current
+     * Wasm module on first access and must hence be requested *before* the pre-allocations are performed. */
+    record_t & record(const m::MatchBase &M);
+
+    /** Instruments the callbacks \p setup, \p pipeline, and \p teardown passed to the physical operator match \p M
+     * such that the number of tuples produced by \p M and the time spent in its pipeline are recorded. */
+    void instrument(const m::MatchBase &M, setup_t &setup, pipeline_t &pipeline, teardown_t &teardown);
+
+    /** Emits code to read the host clock and returns the current time in nanoseconds. */
+    static PrimitiveExpr<double> now();
+
+    /** Emits code to raise the profiling counter \p counter, living in the memory of the current Wasm module, to \p
+     * bytes iff it is currently smaller.  Used to track the peak size of hash tables and buffers. */
+    static void update_peak(uint32_t &counter, U32x1 bytes);
+
+    /** Emits code to store the runtime allocation counters of the current Wasm module into a memory record.  Must be
+     * emitted at the very end of the query and *before* the pre-allocations are performed.  Independent of whether
+     * the profiler is active, e.g. to report the memory consumption for `--statistics`. */
+    void record_memory();
+
+    /** Copies the memory record from the memory of the current Wasm module to the host and complements it by the
+     * \p resident_bytes and the \p heap_capacity_bytes of the heap as well as the current memory usage of the
+     * process.  Must be called after executing the module and before its memory is released. */
+    void collect_memory(std::size_t resident_bytes, std::size_t heap_capacity_bytes);
+
+    /** Returns the memory consumption of the last executed Wasm module or `nullptr` if it was not recorded. */
+    const memory_statistics_t * memory_statistics() const {
+        return memory_statistics_ ? &*memory_statistics_ : nullptr;
+    }
+
+    /** Copies all records from the memory of the current Wasm module to the host.  Must be called after executing the
+     * module and before its memory is released.  The number of tuples of the root operator \p root, which has no
+     * parent pipeline to instrument, is set to \p num_rows. */
+    void collect(const m::MatchBase &root, uint32_t num_rows);
+
+    /** Returns the collected statistics of the physical operator match \p M or `nullptr` if there are none. */
+    const record_t * statistics(const m::MatchBase &M) const {
+        auto it = statistics_.find(&M);
+        return it == statistics_.end() ? nullptr : &it->second;
+    }
+};
+
+}
+
+}
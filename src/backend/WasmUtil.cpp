@@ -2,6 +2,7 @@
 
 #include "backend/Interpreter.hpp"
 #include "backend/WasmMacro.hpp"
+#include "backend/WasmProfiler.hpp"
 #include "mutable/util/macro.hpp"
 #include <mutable/util/concepts.hpp>
 #include <optional>
@@ -24,6 +25,9 @@ bool pointer_sharing = true;
 /** Whether data layout compilation makes use of remainder removal optimization. */
 bool remainder_removal = true;
 
+/** Whether string comparisons and `LIKE` compare 16 characters at a time using SIMD instructions. */
+bool simd_strings = true;
+
 }
 
 __attribute__((constructor(201)))
@@ -46,6 +50,13 @@ static void add_wasm_util_args()
         /* description= */ "do not use remainder removal optimization for data layout compilation",
         /* callback=    */ [](bool){ options::remainder_removal = false; }
     );
+    C.arg_parser().add<bool>(
+        /* group=       */ "Wasm",
+        /* short=       */ nullptr,
+        /* long=        */ "--no-simd-strings",
+        /* description= */ "do not use SIMD instructions for string comparison and LIKE",
+        /* callback=    */ [](bool){ options::simd_strings = false; }
+    );
 }
 
 }
@@ -2531,6 +2542,13 @@ Buffer<IsGlobal>::~Buffer()
     }
 }
 
+template<bool IsGlobal>
+void Buffer<IsGlobal>::profile(const m::MatchBase &M)
+{
+    if (Profiler::Get().active())
+        profile_size_ = &Profiler::Get().record(M).buffer_bytes;
+}
+
 template<bool IsGlobal>
 buffer_load_proxy_t<IsGlobal> Buffer<IsGlobal>::create_load_proxy(param_t _tuple_value_schema,
                                                                   param_t _tuple_addr_schema) const
@@ -2646,6 +2664,19 @@ void Buffer<IsGlobal>::teardown()
     M_insist(not layout_.is_finite() == bool(capacity_), "must call `setup()` before");
     M_insist(not layout_.is_finite() == bool(first_iteration_), "must call `setup()` before");
 
+    /*----- Account the size of the buffer as it only grows. -----*/
+    if (profile_size_) {
+        const uint32_t child_size_in_bytes = (layout_.stride_in_bits() + 7) / 8;
+        if (layout_.is_finite()) {
+            const uint32_t num_children =
+                (layout_.num_tuples() + layout_.child().num_tuples() - 1) / layout_.child().num_tuples();
+            Profiler::update_peak(*profile_size_, U32x1(num_children * child_size_in_bytes));
+        } else {
+            Profiler::update_peak(*profile_size_,
+                                  (*capacity_ / uint32_t(layout_.child().num_tuples())) * child_size_in_bytes);
+        }
+    }
+
     if constexpr (not IsGlobal) { // free memory of local buffer when user calls teardown method
         if (not layout_.is_finite()) {
             /*----- Deallocate memory for buffer. -----*/
@@ -3099,6 +3130,29 @@ template struct m::wasm::buffer_swap_proxy_t<true>;
  * string comparison
  *====================================================================================================================*/
 
+namespace {
+
+/** Loads the 16 characters starting at \p ptr into a SIMD vector.  All 16 characters must be accessible. */
+U8x16 load_chunk(Ptr<Charx1> ptr) { return *ptr.to<void*>().to<uint8_t*, 16>(); }
+
+/** Advances \p left and \p right in chunks of 16 characters as long as the chunks of both strings are equal and contain
+ * no NUL byte.  At most the first \p len characters of each string are accessed.  Afterwards, the first position where
+ * the strings differ or end is at most 15 characters ahead, hence the caller must finish the comparison
+ * character-wise. */
+template<typename P>
+void skip_equal_chunks(P &left, P &right, I32x1 len)
+{
+    const Var<Ptr<Charx1>> end_chunks(left.val() + (len bitand int32_t(~15))); // end of the last whole chunk
+    WHILE (left != end_chunks) {
+        const Var<U8x16> chars_left(load_chunk(left.val()));
+        BREAK(((chars_left != load_chunk(right.val())) or (chars_left == U8x16(0U))).any_true());
+        left  += 16;
+        right += 16;
+    }
+}
+
+}
+
 _I32x1 m::wasm::strncmp(NChar _left, NChar _right, U32x1 len, bool reverse)
 {
     static thread_local struct {} _; // unique caller handle
@@ -3139,11 +3193,15 @@ _I32x1 m::wasm::strncmp(NChar _left, NChar _right, U32x1 len, bool reverse)
 
                         Var<I32x1> result; // always set here
 
-                        I32x1 len_left  = Select(len < len_ty_left,  len, len_ty_left) .make_signed();
-                        I32x1 len_right = Select(len < len_ty_right, len, len_ty_right).make_signed();
+                        const Var<I32x1> len_left (Select(len < len_ty_left,  len, len_ty_left) .make_signed());
+                        const Var<I32x1> len_right(Select(len < len_ty_right, len, len_ty_right).make_signed());
                         Var<Ptr<Charx1>> end_left (left  + len_left);
                         Var<Ptr<Charx1>> end_right(right + len_right);
 
+                        /* Skip the equal prefix of both strings chunk-wise. */
+                        if (options::simd_strings)
+                            skip_equal_chunks(left, right, Select(len_left < len_right, len_left, len_right));
+
                         LOOP() {
                             /* Check whether one side is shorter than the other. */
                             result = (left != end_left).to<int32_t>() - (right != end_right).to<int32_t>();
@@ -3184,14 +3242,19 @@ _I32x1 m::wasm::strncmp(NChar _left, NChar _right, U32x1 len, bool reverse)
 
                         Var<I32x1> result; // always set here
 
-                        I32x1 len_left  = Select(len < len_ty_left,  len, len_ty_left) .make_signed();
-                        I32x1 len_right = Select(len < len_ty_right, len, len_ty_right).make_signed();
+                        const Var<I32x1> len_left (Select(len < len_ty_left,  len, len_ty_left) .make_signed());
+                        const Var<I32x1> len_right(Select(len < len_ty_right, len, len_ty_right).make_signed());
                         Var<Ptr<Charx1>> end_left, end_right;
 
                         if (not reverse) {
                             /* Set end variables according to theoretical length. */
                             end_left  = left  + len_left;
                             end_right = right + len_right;
+
+                            /* Skip the equal prefix of both strings chunk-wise.  All characters of the common length
+                             * are in bounds. */
+                            if (options::simd_strings)
+                                skip_equal_chunks(left, right, Select(len_left < len_right, len_left, len_right));
                         } else {
                             /* Set end variables to first found NUL byte without exceeding the theoretical length. */
                             end_left = left;
@@ -3591,8 +3654,38 @@ _Boolx1 m::wasm::like_contains(NChar _str, const ThreadSafePooledString &_patter
                     tbl[i] = len_prefix;
                 }
 
-                /*----- Search pattern in string. -----*/
                 const Var<Ptr<Charx1>> end_str(val_str + len_ty_str);
+
+                /*----- Search pattern in string chunk-wise.  Candidate positions are those where both the first and the
+                 * last character of the pattern match, the remaining characters of the pattern are verified for each
+                 * candidate.  Stop at the first chunk containing a NUL byte, since the characters following it are not
+                 * part of the string. -----*/
+                if (options::simd_strings) {
+                    const uint8_t first_char = (*_pattern)[1];
+                    const uint8_t last_char  = (*_pattern)[len_pattern];
+                    WHILE (val_str + (len_pattern + 15) <= end_str) { // last character of all candidates in bounds
+                        const Var<U8x16> chars(load_chunk(val_str.val()));
+                        BREAK((chars == U8x16(0U)).any_true());
+                        Var<U32x1> candidates(
+                            ((chars == U8x16(first_char)) and
+                             (load_chunk(val_str + (len_pattern - 1)) == U8x16(last_char))).bitmask()
+                        );
+                        WHILE (candidates != 0U) {
+                            const Var<Ptr<Charx1>> candidate(val_str + candidates.val().ctz().make_signed());
+                            Var<I32x1> pos(1);
+                            WHILE (pos < len_pattern - 1 and *(candidate + pos) == *(Ptr<Charx1>(pattern) + pos)) {
+                                pos += 1;
+                            }
+                            IF (pos >= len_pattern - 1) {
+                                RETURN(true);
+                            };
+                            candidates = candidates bitand (candidates - 1U); // clear lowest candidate
+                        }
+                        val_str += 16;
+                    }
+                }
+
+                /*----- Search pattern in remainder of string. -----*/
                 Var<I32x1> pos_pattern(0);
                 WHILE (val_str < end_str and *val_str != '\0') {
                     WHILE(pos_pattern >= 0 and *val_str != *(Ptr<Charx1>(pattern) + pos_pattern)) {
@@ -1085,6 +1085,7 @@ struct Buffer
     teardown_t teardown_; ///< remaining pipeline post-processing
     ///> function to resume pipeline for entire buffer; expects base address and size of buffer as parameters
     mutable std::optional<FunctionProxy<void(void*, uint32_t)>> resume_pipeline_;
+    uint32_t *profile_size_ = nullptr; ///< profiling counter to account the peak size of the buffer to, iff profiled
 
     public:
     /** Creates a buffer for \p num_tuples tuples (0 means infinite) of schema \p schema using the data layout
@@ -1102,6 +1103,9 @@ struct Buffer
 
     Buffer & operator=(Buffer&&) = default;
 
+    /** Accounts the peak size of `this` buffer to the physical operator match \p M iff the query is profiled. */
+    void profile(const m::MatchBase &M);
+
     /** Returns the schema of the buffer. */
     const Schema & schema() const { return schema_; }
     /** Returns the layout of the buffer. */
@@ -73,12 +73,13 @@ uint32_t WasmEngine::WasmContext::map_table(const Table &table)
     const std::size_t num_instances = (table.store().num_rows() + num_rows_per_instance - 1) / num_rows_per_instance;
     const std::size_t bytes = instance_stride_in_bytes * num_instances;
 
-    /* Map entry into WebAssembly linear memory. */
+    /* Map a copy-on-write snapshot of the table into WebAssembly linear memory, such that concurrent modifications of
+     * the table do not affect the query. */
     const auto off = heap;
     const auto aligned_bytes = Ceil_To_Next_Page(bytes);
-    const auto &mem = table.store().memory();
     if (aligned_bytes) {
-        mem.map(aligned_bytes, 0, vm, off);
+        auto &snapshot = snapshots.emplace_back(table.store().snapshot(vm, off));
+        M_insist(snapshot->size() == aligned_bytes);
         heap += aligned_bytes;
         install_guard_page();
     }
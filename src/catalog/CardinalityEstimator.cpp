@@ -2,12 +2,16 @@
 
 #include "backend/Interpreter.hpp"
 #include "catalog/SpnWrapper.hpp"
+#include "parse/ASTPrinter.hpp"
 #include "util/Spn.hpp"
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
 #include <filesystem>
+#include <iomanip>
+#include <iterator>
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/IR/CNF.hpp>
 #include <mutable/IR/Operator.hpp>
@@ -17,6 +21,8 @@
 #include <mutable/util/Diagnostic.hpp>
 #include <mutable/util/Pool.hpp>
 #include <nlohmann/json.hpp>
+#include <sstream>
+#include <thread>
 
 
 using namespace m;
@@ -27,9 +33,30 @@ namespace {
 namespace options {
 
 std::filesystem::path injected_cardinalities_file;
+std::filesystem::path cardinality_feedback_file;
+std::size_t cardinality_feedback_batch_size = 0;
+const char *feedback_estimator = "CartesianProduct";
+std::size_t spn_sample_size = 0;
+unsigned spn_learning_threads = std::max(std::thread::hardware_concurrency(), 1U);
+std::size_t spn_update_batch_size = 1;
 
 }
 
+/** Prints expressions like `ast::ASTPrinter`, except that designators of attributes are qualified by the name of the
+ * attribute's table rather than by the alias used in the query. */
+struct SignaturePrinter : ast::ASTPrinter
+{
+    using ast::ASTPrinter::ASTPrinter;
+    using ast::ASTPrinter::operator();
+
+    void operator()(Const<ast::Designator> &e) override {
+        if (auto attr = std::get_if<const Attribute*>(&e.target()))
+            out << (*attr)->table.name() << '.' << (*attr)->name;
+        else
+            ast::ASTPrinter::operator()(e);
+    }
+};
+
 }
 
 /*======================================================================================================================
@@ -45,6 +72,12 @@ double CardinalityEstimator::predict_number_distinct_values(const DataModel&) co
     throw data_model_exception("predicting the number of distinct values is not supported by this data model.");
 };
 
+void CardinalityEstimator::feedback(const Operator&) { /* nothing to be done */ }
+
+void CardinalityEstimator::rows_appended(const Table&, std::size_t) { /* nothing to be done */ }
+
+void CardinalityEstimator::flush_appended_rows(const Table&) { /* nothing to be done */ }
+
 M_LCOV_EXCL_START
 void CardinalityEstimator::dump(std::ostream &out) const
 {
@@ -291,16 +324,17 @@ InjectionCardinalityEstimator::estimate_grouping(const QueryGraph&, const DataMo
         return std::make_unique<InjectionCardinalityDataModel>(data.subproblem_, 1); // single group
 
     /* Combine grouping keys into an identifier. */
-    oss_.str("");
-    oss_ << "g";
+    static thread_local std::ostringstream oss;
+    oss.str("");
+    oss << "g";
     for (auto [grp, alias] : exprs) {
-        oss_ << '#';
+        oss << '#';
         if (alias.has_value())
-            oss_ << alias;
+            oss << alias;
         else
-            oss_ << grp.get();
+            oss << grp.get();
     }
-    ThreadSafePooledString id = Catalog::Get().pool(oss_.str().c_str());
+    ThreadSafePooledString id = Catalog::Get().pool(oss.str().c_str());
 
     if (auto it = cardinality_table_.find(id); it != cardinality_table_.end()) {
         /* Clamp injected cardinality to at most the cardinality of the grouping's child since it cannot produce more
@@ -413,15 +447,17 @@ ThreadSafePooledString InjectionCardinalityEstimator::make_identifier(const Quer
         names.emplace_back(G.sources()[id]->name());
     std::sort(names.begin(), names.end(), [](auto lhs, auto rhs){ return strcmp(*lhs, *rhs) < 0; });
 
-    buf_.clear();
+    static thread_local std::vector<char> buf;
+    buf.clear();
     for (auto it = names.begin(); it != names.end(); ++it) {
         if (it != names.begin())
-            buf_.emplace_back('$');
-        buf_append(**it);
+            buf.emplace_back('$');
+        for (const char *c = **it; *c; ++c)
+            buf.emplace_back(*c);
     }
 
-    buf_.emplace_back(0);
-    return C.pool(buf_view());
+    buf.emplace_back(0);
+    return C.pool(buf.data());
 }
 
 
@@ -531,16 +567,60 @@ SpnEstimator::~SpnEstimator()
         delete e.second;
 }
 
-void SpnEstimator::learn_spns() { table_to_spn_ = SpnWrapper::learn_spn_database(name_of_database_); }
+void SpnEstimator::learn_spns()
+{
+    table_to_spn_ = SpnWrapper::learn_spn_database(name_of_database_, {}, options::spn_sample_size,
+                                                   options::spn_learning_threads);
+}
 
 void SpnEstimator::learn_new_spn(const ThreadSafePooledString &name_of_table)
 {
     table_to_spn_.emplace(
         name_of_table,
-        new SpnWrapper(SpnWrapper::learn_spn_table(name_of_database_, name_of_table))
+        new SpnWrapper(SpnWrapper::learn_spn_table(name_of_database_, name_of_table, {}, options::spn_sample_size,
+                                                   options::spn_learning_threads))
     );
 }
 
+void SpnEstimator::rows_appended(const Table &table, std::size_t first_row)
+{
+    auto spn_it = table_to_spn_.find(table.name());
+    if (spn_it == table_to_spn_.end()) return; // no Spn learned on this table
+
+    /* collect appended rows until a batch is complete */
+    auto [pending_it, _] = pending_rows_.try_emplace(table.name(), first_row);
+    const std::size_t first_pending_row = pending_it->second;
+    if (table.store().num_rows() - first_pending_row < options::spn_update_batch_size) return;
+    pending_rows_.erase(pending_it);
+
+    insert_rows(table, spn_it->second, first_pending_row);
+}
+
+void SpnEstimator::flush_appended_rows(const Table &table)
+{
+    auto pending_it = pending_rows_.find(table.name());
+    if (pending_it == pending_rows_.end()) return; // no rows pending
+    const std::size_t first_pending_row = pending_it->second;
+    pending_rows_.erase(pending_it);
+
+    insert_rows(table, table_to_spn_.at(table.name()), first_pending_row);
+}
+
+void SpnEstimator::insert_rows(const Table &table, SpnWrapper *&spn, std::size_t first_row)
+{
+    if (spn->num_rows() == 0) {
+        /* an Spn learned on an empty table has no structure to maintain, hence learn it from scratch */
+        delete spn;
+        spn = new SpnWrapper(SpnWrapper::learn_spn_table(name_of_database_, table.name(), {},
+                                                         options::spn_sample_size, options::spn_learning_threads));
+        return;
+    }
+
+    spn->insert_rows(table, first_row);
+    if (spn->has_drifted())
+        spn->relearn_drifted(name_of_database_, table.name(), options::spn_sample_size, options::spn_learning_threads);
+}
+
 std::pair<unsigned, bool> SpnEstimator::find_spn_id(const SpnDataModel &data, SpnJoin &join)
 {
     /* we only have a single spn */
@@ -798,10 +878,390 @@ std::size_t SpnEstimator::predict_cardinality(const DataModel &_data) const
 void SpnEstimator::print(std::ostream&) const { }
 
 
+/*======================================================================================================================
+ * FeedbackCardinalityEstimator
+ *====================================================================================================================*/
+
+/*----- Constructors -------------------------------------------------------------------------------------------------*/
+
+FeedbackCardinalityEstimator::FeedbackCardinalityEstimator(ThreadSafePooledString name_of_database)
+    : name_of_database_(name_of_database)
+    , estimator_(Catalog::Get().create_cardinality_estimator(Catalog::Get().pool(options::feedback_estimator),
+                                                             std::move(name_of_database)))
+{
+    if (not options::cardinality_feedback_file.empty()) {
+        std::ifstream in(options::cardinality_feedback_file);
+        if (in) { // the file is created on the first feedback otherwise
+            Diagnostic diag(Options::Get().has_color, std::cout, std::cerr);
+            read_json(diag, in);
+        }
+    }
+}
+
+FeedbackCardinalityEstimator::FeedbackCardinalityEstimator(ThreadSafePooledString name_of_database,
+                                                           std::unique_ptr<CardinalityEstimator> estimator)
+    : name_of_database_(std::move(name_of_database))
+    , estimator_(M_notnull(std::move(estimator)))
+{ }
+
+FeedbackCardinalityEstimator::~FeedbackCardinalityEstimator()
+{
+    if (not estimator_ or num_unpersisted_queries_ == 0) // moved-from or nothing to persist
+        return;
+    try {
+        persist();
+    } catch (const runtime_error &e) {
+        std::cerr << "warning: " << e.what() << ", observed cardinalities are lost" << std::endl;
+    }
+}
+
+void FeedbackCardinalityEstimator::read_json(Diagnostic &diag, std::istream &in)
+{
+    Position pos("FeedbackCardinalityEstimator");
+
+    using json = nlohmann::json;
+    json feedback;
+    try {
+        in >> feedback;
+    } catch (json::parse_error parse_error) {
+        diag.w(pos) << "The feedback file could not be parsed as json. Parser error output:\n"
+                    << parse_error.what() << "\n"
+                    << "Previously observed cardinalities will not be used.\n";
+        return;
+    }
+
+    auto database_entry = feedback.find(*name_of_database_);
+    if (database_entry == feedback.end())
+        return; // nothing observed for this database yet
+    observed_.reserve(database_entry->size());
+    for (auto &subproblem_entry : *database_entry) {
+        try {
+            observed_[subproblem_entry.at("key").get<std::string>()] = subproblem_entry.at("size").get<std::size_t>();
+        } catch (json::exception &exception) {
+            diag.w(pos) << "The entry " << subproblem_entry << " for the db \"" << name_of_database_ << "\""
+                        << " does not have the required form of {\"key\": ..., \"size\": ... } "
+                        << "and will thus be ignored.\n";
+        }
+    }
+}
+
+void FeedbackCardinalityEstimator::persist()
+{
+    if (options::cardinality_feedback_file.empty()) {
+        num_unpersisted_queries_ = 0;
+        return;
+    }
+
+    /*----- Read the entries of all databases to preserve them. -----*/
+    using json = nlohmann::json;
+    json feedback = json::object();
+    if (std::ifstream in(options::cardinality_feedback_file); in) {
+        try {
+            in >> feedback;
+        } catch (json::parse_error) {
+            feedback = json::object(); // overwrite unparsable file
+        }
+    }
+
+    /*----- Replace the entry of this database. -----*/
+    json &database_entry = feedback[*name_of_database_] = json::array();
+    for (auto &[key, size] : observed_)
+        database_entry.push_back({ { "key", key }, { "size", size } });
+
+    std::ofstream out(options::cardinality_feedback_file);
+    if (not out)
+        throw runtime_error("could not write the cardinality feedback file");
+    out << feedback.dump(4) << std::endl;
+    num_unpersisted_queries_ = 0;
+}
+
+void FeedbackCardinalityEstimator::observe(std::vector<std::string> sources, std::size_t size,
+                                           std::vector<std::string> joins)
+{
+    M_insist(not sources.empty(), "a subproblem must contain at least one data source");
+    observed_[make_key(std::move(sources), std::move(joins))] = size;
+}
+
+std::string FeedbackCardinalityEstimator::make_filter_signature(const cnf::CNF &filter)
+{
+    if (filter.empty())
+        return std::string();
+    std::string signature;
+    for (auto &clause : make_clause_signatures(filter)) {
+        signature += signature.empty() ? "[" : " ^ ";
+        signature += clause;
+    }
+    return signature + ']';
+}
+
+std::vector<std::string> FeedbackCardinalityEstimator::make_clause_signatures(const cnf::CNF &cnf)
+{
+    std::vector<std::string> signatures;
+    signatures.reserve(cnf.size());
+    for (auto &clause : cnf) {
+        std::ostringstream out;
+        SignaturePrinter print(out);
+        print.expand_nested_queries(false);
+        for (auto it = clause.begin(); it != clause.end(); ++it) {
+            if (it != clause.begin()) out << " v ";
+            if (it->negative()) out << '-';
+            print(**it);
+        }
+        signatures.emplace_back(std::move(out).str());
+    }
+    std::sort(signatures.begin(), signatures.end());
+    return signatures;
+}
+
+std::vector<std::string> FeedbackCardinalityEstimator::make_join_signatures(const QueryGraph &G, Subproblem S)
+{
+    std::vector<std::string> signatures;
+    for (auto &J : G.joins()) {
+        Subproblem join_sources;
+        for (auto ds : J->sources())
+            join_sources(ds.get().id()) = true;
+        if (join_sources.is_subset(S)) {
+            auto clauses = make_clause_signatures(J->condition());
+            signatures.insert(signatures.end(), std::make_move_iterator(clauses.begin()),
+                              std::make_move_iterator(clauses.end()));
+        }
+    }
+    std::sort(signatures.begin(), signatures.end());
+    return signatures;
+}
+
+std::string FeedbackCardinalityEstimator::make_key(std::vector<std::string> sources, std::vector<std::string> joins)
+{
+    std::sort(sources.begin(), sources.end());
+    std::sort(joins.begin(), joins.end());
+    std::string key;
+    for (auto it = sources.begin(); it != sources.end(); ++it) {
+        if (it != sources.begin())
+            key += '$';
+        key += *it;
+    }
+    for (auto it = joins.begin(); it != joins.end(); ++it) {
+        key += it == joins.begin() ? '|' : '$';
+        key += *it;
+    }
+    return key;
+}
+
+std::unique_ptr<FeedbackCardinalityEstimator::FeedbackDataModel>
+FeedbackCardinalityEstimator::make_model(std::unique_ptr<DataModel> model, Subproblem subproblem,
+                                         std::vector<std::string> sources, std::vector<std::string> joins,
+                                         double correction) const
+{
+    const std::size_t estimate = estimator_->predict_cardinality(*model);
+
+    if (not sources.empty()) {
+        if (auto it = observed_.find(make_key(sources, joins)); it != observed_.end()) {
+            /* Prefer the observed cardinality and remember by which factor the underlying estimate was off. */
+            const double observed_correction =
+                double(std::max<std::size_t>(it->second, 1)) / std::max<std::size_t>(estimate, 1);
+            return std::make_unique<FeedbackDataModel>(std::move(model), subproblem, std::move(sources), it->second,
+                                                       observed_correction);
+        }
+    }
+
+    /* Correct the underlying estimate by the corrections of the inputs. */
+    const std::size_t size = std::llround(estimate * correction);
+    return std::make_unique<FeedbackDataModel>(std::move(model), subproblem, std::move(sources), size, correction);
+}
+
+/*----- Model calculation --------------------------------------------------------------------------------------------*/
+
+std::unique_ptr<DataModel> FeedbackCardinalityEstimator::empty_model() const
+{
+    return std::make_unique<FeedbackDataModel>(estimator_->empty_model(), Subproblem(), std::vector<std::string>(), 0,
+                                               1.);
+}
+
+std::unique_ptr<DataModel> FeedbackCardinalityEstimator::estimate_scan(const QueryGraph &G, Subproblem P) const
+{
+    M_insist(P.size() == 1);
+    auto &DS = *G.sources()[*P.begin()];
+
+    /* Key base tables by the name of the table, independent of an alias.  Nested queries are not keyed. */
+    std::vector<std::string> sources;
+    if (auto bt = cast<const BaseTable>(&DS))
+        sources.emplace_back(*bt->table().name());
+    return make_model(estimator_->estimate_scan(G, P), P, std::move(sources), std::vector<std::string>(), 1.);
+}
+
+std::unique_ptr<DataModel>
+FeedbackCardinalityEstimator::estimate_filter(const QueryGraph &G, const DataModel &_data,
+                                              const cnf::CNF &filter) const
+{
+    auto &data = as<const FeedbackDataModel>(_data);
+
+    /* Only filters on a single data source are part of the key, see `feedback()`. */
+    std::vector<std::string> sources;
+    if (data.sources_.size() == 1)
+        sources.emplace_back(data.sources_.front() + make_filter_signature(filter));
+    return make_model(estimator_->estimate_filter(G, *data.model_, filter), data.subproblem_, std::move(sources),
+                      std::vector<std::string>(), data.correction_);
+}
+
+std::unique_ptr<DataModel>
+FeedbackCardinalityEstimator::estimate_limit(const QueryGraph &G, const DataModel &_data, std::size_t limit,
+                                             std::size_t offset) const
+{
+    auto &data = as<const FeedbackDataModel>(_data);
+    auto model = estimator_->estimate_limit(G, *data.model_, limit, offset);
+    const std::size_t estimate = estimator_->predict_cardinality(*model);
+    const std::size_t remaining = offset > data.size_ ? 0UL : data.size_ - offset;
+    const std::size_t size = std::min(remaining, limit);
+    return std::make_unique<FeedbackDataModel>(std::move(model), data.subproblem_, std::vector<std::string>(), size,
+                                               double(std::max<std::size_t>(size, 1)) / std::max<std::size_t>(estimate, 1));
+}
+
+std::unique_ptr<DataModel>
+FeedbackCardinalityEstimator::estimate_grouping(const QueryGraph &G, const DataModel &_data,
+                                                const std::vector<group_type> &groups) const
+{
+    auto &data = as<const FeedbackDataModel>(_data);
+    auto model = estimator_->estimate_grouping(G, *data.model_, groups);
+    const std::size_t estimate = estimator_->predict_cardinality(*model);
+    const std::size_t size = std::min(estimate, data.size_); // a grouping cannot produce more tuples than it receives
+    return std::make_unique<FeedbackDataModel>(std::move(model), data.subproblem_, std::vector<std::string>(), size,
+                                               double(std::max<std::size_t>(size, 1)) / std::max<std::size_t>(estimate, 1));
+}
+
+std::unique_ptr<DataModel>
+FeedbackCardinalityEstimator::estimate_join(const QueryGraph &G, const DataModel &_left, const DataModel &_right,
+                                            const cnf::CNF &condition) const
+{
+    auto &left  = as<const FeedbackDataModel>(_left);
+    auto &right = as<const FeedbackDataModel>(_right);
+
+    const Subproblem subproblem = left.subproblem_ | right.subproblem_;
+
+    /* Key the join by the join predicates of the query graph rather than by `condition`, which plan enumerators do not
+     * provide. */
+    std::vector<std::string> sources, joins;
+    if (not left.sources_.empty() and not right.sources_.empty()) {
+        sources.reserve(left.sources_.size() + right.sources_.size());
+        std::merge(left.sources_.begin(), left.sources_.end(), right.sources_.begin(), right.sources_.end(),
+                   std::back_inserter(sources));
+        joins = make_join_signatures(G, subproblem);
+    }
+    return make_model(estimator_->estimate_join(G, *left.model_, *right.model_, condition), subproblem,
+                      std::move(sources), std::move(joins), left.correction_ * right.correction_);
+}
+
+template<typename PlanTable>
+std::unique_ptr<DataModel>
+FeedbackCardinalityEstimator::operator()(estimate_join_all_tag, PlanTable &&PT, const QueryGraph &G,
+                                         Subproblem to_join, const cnf::CNF &condition) const
+{
+    /* The underlying estimator expects its own models in the plan table.  Hence, join the data sources pairwise and
+     * apply the condition with the last join. */
+    auto it = to_join.begin();
+    const DataModel &first = *PT[it.as_set()].model;
+    if (++it == to_join.end())
+        return estimate_filter(G, first, condition);
+
+    std::unique_ptr<DataModel> model;
+    const DataModel *left = &first;
+    while (it != to_join.end()) {
+        const DataModel &right = *PT[it.as_set()].model;
+        const bool is_last = ++it == to_join.end();
+        model = estimate_join(G, *left, right, is_last ? condition : cnf::CNF());
+        left = model.get();
+    }
+    return model;
+}
+
+std::size_t FeedbackCardinalityEstimator::predict_cardinality(const DataModel &data) const
+{
+    return as<const FeedbackDataModel>(data).size_;
+}
+
+/*----- Feedback from execution --------------------------------------------------------------------------------------*/
+
+void FeedbackCardinalityEstimator::feedback(const Operator &plan)
+{
+    /** The signatures of the data sources of a subplan and of the clauses of the join predicates among them. */
+    struct signature_t
+    {
+        std::vector<std::string> sources;
+        std::vector<std::string> joins;
+    };
+
+    /* Computes the signature of the subplan rooted at `op`, iff the result of the subplan is identified by it, i.e. the
+     * subplan consists of scans, filters on single data sources, and joins.  Records the observed cardinalities of all
+     * such subplans.  Uses CPS to implement a recursive lambda. */
+    auto record = [this](const Operator &op, auto &record_rec) -> std::optional<signature_t> {
+        std::vector<std::optional<signature_t>> children;
+        if (auto c = cast<const Consumer>(&op)) {
+            for (auto child : c->children())
+                children.push_back(record_rec(*child, record_rec));
+        }
+
+        std::optional<signature_t> signature;
+        if (auto scan = cast<const ScanOperator>(&op)) {
+            signature.emplace().sources.emplace_back(*scan->store().table().name());
+        } else if (auto filter = cast<const FilterOperator>(&op)) { // includes disjunctive filters
+            M_insist(children.size() == 1);
+            if (children[0] and children[0]->sources.size() == 1) {
+                signature = std::move(children[0]);
+                signature->sources.front() += make_filter_signature(filter->filter());
+            }
+        } else if (auto join = cast<const JoinOperator>(&op)) {
+            signature.emplace().joins = make_clause_signatures(join->predicate());
+            for (auto &child : children) {
+                if (not child) {
+                    signature.reset();
+                    break;
+                }
+                signature->sources.insert(signature->sources.end(), child->sources.begin(), child->sources.end());
+                signature->joins.insert(signature->joins.end(), child->joins.begin(), child->joins.end());
+            }
+        }
+
+        if (signature and op.has_info() and op.info().observed_cardinality)
+            observe(signature->sources, *op.info().observed_cardinality, signature->joins);
+        return signature;
+    };
+    record(plan, record);
+
+    /* Persist in batches rather than rewriting the feedback file after every query. */
+    ++num_unpersisted_queries_;
+    if (options::cardinality_feedback_batch_size != 0 and
+        num_unpersisted_queries_ >= options::cardinality_feedback_batch_size)
+    {
+        persist();
+    }
+}
+
+M_LCOV_EXCL_START
+void FeedbackCardinalityEstimator::print(std::ostream &out) const
+{
+    constexpr uint32_t max_rows_printed = 100;     /// Number of rows of the observed cardinalities printed
+    std::size_t sub_len = 13;                         /// Length of Subproblem column
+    for (auto &entry : observed_)
+        sub_len = std::max(sub_len, entry.first.length());
+
+    out << std::left << "FeedbackCardinalityEstimator on top of " << *estimator_ << '\n'
+        << std::setw(sub_len) << "Subproblem" << "Size" << "\n" << std::right;
+
+    /* ------- Print maximum max_rows_printed rows of the observed cardinalities */
+    uint32_t counter = 0;
+    for (auto &entry : observed_) {
+        if (counter >= max_rows_printed) break;
+        out << std::left << std::setw(sub_len) << entry.first << entry.second << "\n";
+        counter++;
+    }
+}
+M_LCOV_EXCL_STOP
+
+
 #define LIST_CE(X) \
     X(CartesianProductEstimator, "CartesianProduct", "estimates cardinalities as Cartesian product") \
     X(InjectionCardinalityEstimator, "Injected", "estimates cardinalities based on a JSON file") \
-    X(SpnEstimator, "Spn", "estimates cardinalities based on Sum-Product Networks")
+    X(SpnEstimator, "Spn", "estimates cardinalities based on Sum-Product Networks") \
+    X(FeedbackCardinalityEstimator, "Feedback", "corrects estimates by cardinalities observed during execution")
 
 #define INSTANTIATE(TYPE, _1, _2) \
     template std::unique_ptr<DataModel> TYPE::operator()(estimate_join_all_tag, PlanTableSmallOrDense &&PT, \
@@ -865,4 +1325,60 @@ Example for injected cardinalities file:\n\
             options::injected_cardinalities_file = path;
         }
     );
+    C.arg_parser().add<const char*>(
+        /* group=       */ "Cardinality estimation",
+        /* short=       */ nullptr,
+        /* long=        */ "--cardinality-feedback-file",
+        /* description= */ "persist cardinalities observed during execution in the given JSON file",
+        [] (const char *path) {
+            options::cardinality_feedback_file = path;
+        }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Cardinality estimation",
+        /* short=       */ nullptr,
+        /* long=        */ "--cardinality-feedback-batch-size",
+        /* description= */ "persist observed cardinalities after this many queries (0 to persist only on shutdown)",
+        [] (std::size_t size) { options::cardinality_feedback_batch_size = size; }
+    );
+    C.arg_parser().add<const char*>(
+        /* group=       */ "Cardinality estimation",
+        /* short=       */ nullptr,
+        /* long=        */ "--feedback-estimator",
+        /* description= */ "cardinality estimator whose estimates are corrected by observed cardinalities",
+        [] (const char *name) {
+            if (streq(name, "Feedback")) {
+                std::cerr << "The feedback estimator cannot be built on top of itself.\n";
+                std::exit(EXIT_FAILURE);
+            }
+            options::feedback_estimator = name;
+        }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Cardinality estimation",
+        /* short=       */ nullptr,
+        /* long=        */ "--spn-sample-size",
+        /* description= */ "learn SPNs on a uniform random sample of this many rows per table (0 for all rows)",
+        [] (std::size_t size) { options::spn_sample_size = size; }
+    );
+    C.arg_parser().add<unsigned>(
+        /* group=       */ "Cardinality estimation",
+        /* short=       */ nullptr,
+        /* long=        */ "--spn-learning-threads",
+        /* description= */ "the maximum number of threads to learn an SPN with",
+        [] (unsigned num_threads) {
+            if (num_threads == 0) {
+                std::cerr << "The number of threads to learn SPNs with must be positive.\n";
+                std::exit(EXIT_FAILURE);
+            }
+            options::spn_learning_threads = num_threads;
+        }
+    );
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Cardinality estimation",
+        /* short=       */ nullptr,
+        /* long=        */ "--spn-update-batch-size",
+        /* description= */ "the minimum number of rows appended to a table before they are inserted into its SPN",
+        [] (std::size_t size) { options::spn_update_batch_size = size; }
+    );
 }
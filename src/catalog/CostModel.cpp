@@ -2,6 +2,7 @@
 
 #include "storage/ColumnStore.hpp"
 #include "storage/store_manip.hpp"
+#include "storage/ZoneMap.hpp"
 #include "util/GridSearch.hpp"
 #include "util/stream.hpp"
 #include <mutable/catalog/TrainedCostFunction.hpp>
@@ -234,6 +235,7 @@ std::pair<Eigen::MatrixXd, Eigen::VectorXd> generate_training_suite_group_by()
         if (old_num_distinct_values != num_distinct_values) {
             if (old_cardinality > cardinality) {
                 /*  Shrink store. */
+                table.store().detach_snapshots(cardinality); // dropped rows are rewritten when re-appended
                 for (unsigned i = old_cardinality; i != cardinality; --i) table.store().drop();
             } else if (old_cardinality < cardinality) {
                 /* Grow store. */
@@ -268,7 +270,9 @@ std::pair<Eigen::MatrixXd, Eigen::VectorXd> generate_training_suite_group_by()
             M_insist(distinct_values.size() == num_distinct_values);
 
             /* Completely fill the entire column with the new distinct values. */
+            table.store().detach_snapshots(0);
             fill_uniform(val_column, distinct_values, 0, cardinality);
+            table.store().zone_map().invalidate(); // rows were modified in place
 
             old_cardinality = cardinality;
             old_num_distinct_values = num_distinct_values;
@@ -289,6 +293,7 @@ std::pair<Eigen::MatrixXd, Eigen::VectorXd> generate_training_suite_group_by()
             scan_time = time_select_query_execution(DB, "SELECT val FROM group_by;");
         } else if (old_cardinality > cardinality) {
             /* Shrink store. */
+            table.store().detach_snapshots(cardinality); // dropped rows are rewritten when re-appended
             for (unsigned i = old_cardinality; i != cardinality; --i) table.store().drop();
             M_insist(table.store().num_rows() == cardinality);
 
@@ -393,6 +398,7 @@ std::pair<Eigen::MatrixXd, Eigen::VectorXd> generate_training_suite_join()
             generate_primary_keys(id_column_left, *table_left[0UL].type, old_cardinality_left, cardinality_left);
         } else if (old_cardinality_left > cardinality_left) {
             /* Shrink store. */
+            table_left.store().detach_snapshots(cardinality_left); // dropped rows are rewritten when re-appended
             for (unsigned i = old_cardinality_left; i != cardinality_left; --i) table_left.store().drop();
         }
         M_insist(table_left.store().num_rows() == cardinality_left);
@@ -404,6 +410,7 @@ std::pair<Eigen::MatrixXd, Eigen::VectorXd> generate_training_suite_join()
             generate_primary_keys(id_column_right, *table_right[0UL].type, old_cardinality_right, cardinality_right);
         } else if (old_cardinality_right > cardinality_right) {
             /* Shrink store. */
+            table_right.store().detach_snapshots(cardinality_right); // dropped rows are rewritten when re-appended
             for (unsigned i = old_cardinality_right; i != cardinality_right; --i) table_right.store().drop();
         }
 
@@ -446,8 +453,12 @@ std::pair<Eigen::MatrixXd, Eigen::VectorXd> generate_training_suite_join()
 
 
         /* Completely fill the entire column with the new distinct values. */
+        table_left.store().detach_snapshots(0);
+        table_right.store().detach_snapshots(0);
         fill_uniform(val_column_left, distinct_values_left, 0, cardinality_left);
         fill_uniform(val_column_right, distinct_values_right, 0, cardinality_right);
+        table_left.store().zone_map().invalidate(); // rows were modified in place
+        table_right.store().zone_map().invalidate();
 
         old_cardinality_left = cardinality_left;
         old_cardinality_right = cardinality_right;
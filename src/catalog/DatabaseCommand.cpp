@@ -121,8 +121,11 @@ void QueryDatabase::execute(Diagnostic &diag)
     if (Options::Get().physplan)
         physical_plan_->dump(std::cout);
 
-    if (not Options::Get().dryrun)
+    if (not Options::Get().dryrun) {
         M_TIME_EXPR(backend->execute(*physical_plan_), "Execute query", C.timer());
+        if (auto &CE = C.get_database_in_use().cardinality_estimator(); CE.requests_feedback())
+            CE.feedback(*logical_plan_);
+    }
 }
 
 void InsertRecords::execute(Diagnostic&)
@@ -148,6 +151,7 @@ void InsertRecords::execute(Diagnostic&)
     });
 
     /* Write all tuples to the store. */
+    const std::size_t first_row = store.num_rows();
     for (auto &t : I.tuples) {
         StackMachine get_tuple(Schema{});
         for (std::size_t i = 0; i != t.size(); ++i) {
@@ -182,8 +186,7 @@ void InsertRecords::execute(Diagnostic&)
 
         W.append(tup);
     }
-    /* Invalidate all indexes on the table. */
-    DB.invalidate_indexes(T.name());
+    DB.rows_appended(T, first_row);
 }
 
 void UpdateRecords::execute(Diagnostic&)
@@ -211,7 +214,9 @@ void ImportDSV::execute(Diagnostic &diag)
                 diag.err() << ": " << strerror(errsv);
             diag.err() << std::endl;
         } else {
+            const std::size_t first_row = table_.store().num_rows();
             M_TIME_EXPR(R(file, path_.c_str()), "Read DSV file", C.timer());
+            C.get_database_in_use().rows_appended(table_, first_row);
         }
     } catch (m::invalid_argument e) {
         diag.err() << "Error reading DSV file: " << e.what() << "\n";
@@ -1,5 +1,8 @@
 #include <mutable/catalog/Schema.hpp>
 
+#include "storage/Clustering.hpp"
+#include "storage/Dictionary.hpp"
+#include "storage/ZoneMap.hpp"
 #include <algorithm>
 #include <cmath>
 #include <iostream>
@@ -109,6 +112,13 @@ void ConcreteTable::dump(std::ostream &out) const
     out << "Table `" << name_ << '`';
     for (const auto &attr : attrs_)
         out << "\n` " << attr.id << ": `" << attr.name << "` " << *attr.type;
+    if (not sort_key_.empty()) {
+        out << "\nsorted by ";
+        for (auto it = sort_key_.cbegin(); it != sort_key_.cend(); ++it) {
+            if (it != sort_key_.cbegin()) out << ", ";
+            out << '`' << attrs_[it->first].name << "` " << (it->second ? "ASC" : "DESC");
+        }
+    }
     out << std::endl;
 }
 
@@ -320,6 +330,22 @@ Table & Database::add_table(ThreadSafePooledString name) {
     return *it->second;
 }
 
+void Database::rows_appended(const Table &table, std::size_t first_row)
+{
+    if (table.store().num_rows() == first_row)
+        return; // nothing appended
+    invalidate_indexes(table.name());
+    /* Maintain the statistics of the cardinality estimator and the dictionaries before restoring the sort order moves
+     * the appended rows, including rows the estimator has not processed yet. */
+    cardinality_estimator().rows_appended(table, first_row);
+    if (not table.sort_key().empty())
+        cardinality_estimator().flush_appended_rows(table);
+    storage::maintain_dictionaries(table, first_row);
+    /* Maintain the sort order of the table and the zone map. */
+    storage::restore_sort_order(table, first_row);
+    table.store().zone_map().rows_appended();
+}
+
 const Function * Database::get_function(const ThreadSafePooledString &name) const
 {
     try {
@@ -1,6 +1,8 @@
 #include "catalog/SerialScheduler.hpp"
 #include "parse/Sema.hpp"
 #include <mutable/mutable.hpp>
+#include <mutable/util/PerfCounters.hpp>
+#include <mutable/util/Tracer.hpp>
 
 
 using namespace m;
@@ -8,7 +10,10 @@ using namespace m;
 
 std::optional<m::Scheduler::queued_command> SerialScheduler::CommandQueue::pop()
 {
-    std::unique_lock<std::mutex> lock(mutex_);
+    lock_contention::acquisition A;
+    std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+    A.lock(lock);
+    A.acquired(contention_); // waiting for a command is not contention
     has_element_.wait(lock, []{
         // always wake up if the queue is closed
         if (query_queue_.closed_) [[unlikely]]
@@ -38,7 +43,10 @@ std::optional<m::Scheduler::queued_command> SerialScheduler::CommandQueue::pop()
 
 void SerialScheduler::CommandQueue::push(Transaction &t, std::unique_ptr<ast::Command> command, Diagnostic &diag, std::promise<bool> promise)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
+    lock_contention::acquisition A;
+    std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+    A.lock(lock);
+    A.acquired(contention_);
     if (closed_) {
         /* Since the command queue is closed, no more command will be executed
          * => set the promise of this newly pushed command to false right away */
@@ -88,6 +96,18 @@ void SerialScheduler::CommandQueue::stop_transaction(Transaction &t) {
     has_element_.notify_one();
 }
 
+lock_contention SerialScheduler::CommandQueue::contention()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return contention_;
+}
+
+void SerialScheduler::CommandQueue::reset_contention()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    contention_ = lock_contention();
+}
+
 SerialScheduler::CommandQueue SerialScheduler::query_queue_;
 std::atomic<int64_t> SerialScheduler::next_start_time = 0;
 
@@ -131,12 +151,18 @@ bool SerialScheduler::abort(std::unique_ptr<SerialScheduler::Transaction> t) {
 void SerialScheduler::schedule_thread()
 {
     Catalog &C = Catalog::Get();
+    Tracer::Get().name_thread("scheduler");
+    /* Hardware performance counters are per thread.  Open them for this thread, which executes all commands, before
+     * the first measurement rather than lazily within it. */
+    if (C.timer().perf_counters())
+        PerfCounters::Get();
     while (not query_queue_.is_closed()) {
         auto ret = query_queue_.pop();
         // pop() should only return no value if the queue is closed
         if (not ret.has_value()) continue;
 
         auto [t, ast, diag, promise] = std::move(ret.value());
+        auto span = Tracer::Get().span("Execute command", "scheduler");
 
         // check if transaction has a start_time, set one if not. -1 represents an undefined value.
         if (t.start_time() == -1) t.start_time(next_start_time++);
@@ -149,7 +175,9 @@ void SerialScheduler::schedule_thread()
         bool err = diag.num_errors() > 0; // parser errors
 
         diag.clear();
+        auto sema_span = Tracer::Get().span("Semantic analysis");
         auto cmd = sema.analyze(std::move(ast));
+        sema_span.end();
         err |= diag.num_errors() > 0; // sema errors
 
         M_insist(not err == bool(cmd), "when there are no errors, Sema must have returned a command");
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mutable/catalog/Scheduler.hpp>
+#include <mutable/util/reader_writer_lock.hpp>
 #include <condition_variable>
 #include <list>
 #include <future>
@@ -24,6 +25,7 @@ struct SerialScheduler : Scheduler
         std::mutex mutex_;
         std::condition_variable has_element_;
         bool closed_ = false;
+        lock_contention contention_; ///< the contention of `mutex_` when pushing and popping commands
 
         public:
         CommandQueue() = default;
@@ -38,6 +40,8 @@ struct SerialScheduler : Scheduler
         void close();    ///< empties and closes the queue without executing the remaining `ast::Command`s.
         bool is_closed();  ///< signals waiting threads that no more elements will be pushed
         void stop_transaction(Transaction &t); ///< Marks `t` as no longer running.
+        lock_contention contention(); ///< returns the contention of pushing and popping commands
+        void reset_contention(); ///< resets the contention statistics
     };
 
     static CommandQueue query_queue_; ///< instance of our thread-safe query queue that stores all incoming plans.
@@ -57,6 +61,11 @@ struct SerialScheduler : Scheduler
 
     bool abort(std::unique_ptr<Transaction> t) override;
 
+    /** Returns statistics about the contention of the lock guarding the queue of commands. */
+    static lock_contention queue_contention() { return query_queue_.contention(); }
+    /** Resets the statistics about the contention of the lock guarding the queue of commands. */
+    static void reset_queue_contention() { query_queue_.reset_contention(); }
+
     private:
     /** The method run by the worker thread `schedule_thread_`.
      * While stopping, the query that is already being executed will complete its execution
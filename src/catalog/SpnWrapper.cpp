@@ -2,15 +2,32 @@
 
 #include <mutable/mutable.hpp>
 #include <mutable/util/Diagnostic.hpp>
+#include "backend/Interpreter.hpp"
+#include "util/datagen.hpp"
+#include <string_view>
 
 
 using namespace m;
 using namespace Eigen;
 
 
-SpnWrapper SpnWrapper::learn_spn_table(const ThreadSafePooledString &name_of_database,
-                                       const ThreadSafePooledString &name_of_table,
-                                       std::vector<Spn::LeafType> leaf_types)
+namespace {
+
+/** Converts the \p value of an attribute of type \p type to the domain of the SPN. */
+float to_spn_domain(const Type &type, const Value &value)
+{
+    if (type.is_float()) return value.as_f();
+    if (type.is_double()) return float(value.as_d());
+    if (type.is_integral()) return float(value.as_i());
+    if (type.is_character_sequence()) return float(std::hash<std::string_view>{}(static_cast<const char*>(value.as_p())));
+    return 0.f;
+}
+
+}
+
+SpnWrapper::TableData SpnWrapper::read_table(const ThreadSafePooledString &name_of_database,
+                                             const ThreadSafePooledString &name_of_table,
+                                             std::vector<Spn::LeafType> &leaf_types, std::size_t sample_size)
 {
     auto &C = Catalog::Get();
     auto &db = C.get_database(name_of_database);
@@ -32,7 +49,13 @@ SpnWrapper SpnWrapper::learn_spn_table(const ThreadSafePooledString &name_of_dat
         primary_key_id.push_back(elem.get().id);
     }
 
-    MatrixXf data(num_rows, num_columns - primary_key_id.size());
+    /* draw the rows to learn on; the rows are sorted, so we can match them while scanning the table */
+    const bool is_sampled = sample_size != 0 and sample_size < num_rows;
+    const std::vector<std::size_t> sample =
+        is_sampled ? datagen::reservoir_sample(num_rows, sample_size) : std::vector<std::size_t>();
+    const std::size_t num_learning_rows = is_sampled ? sample_size : num_rows;
+
+    MatrixXf data(num_learning_rows, num_columns - primary_key_id.size());
     MatrixXi null_matrix = MatrixXi::Zero(data.rows(), data.cols());
     std::unordered_map<ThreadSafePooledString, unsigned> attribute_to_id;
 
@@ -55,12 +78,20 @@ SpnWrapper SpnWrapper::learn_spn_table(const ThreadSafePooledString &name_of_dat
 
         auto &type = table.at(current_column).type;
         std::size_t current_row = 0;
+        std::size_t current_tuple = 0;
+        /* returns `true` iff the current tuple is not part of the sample, and advances to the next tuple */
+        auto skip_tuple = [&]() {
+            const bool skip = is_sampled and (current_row == sample.size() or sample[current_row] != current_tuple);
+            ++current_tuple;
+            return skip;
+        };
 
         if (type->is_float()) {
             if (leaf_types[current_column - primary_key_count] == Spn::AUTO) {
                 leaf_types[current_column - primary_key_count] = Spn::CONTINUOUS;
             }
             auto callback_data = std::make_unique<CallbackOperator>([&](const Schema &S, const Tuple &T) {
+                if (skip_tuple()) return;
                 if (T.is_null(current_column)) {
                     null_matrix(current_row, current_column - primary_key_count) = 1;
                     data(current_row, current_column - primary_key_count) = 0;
@@ -77,6 +108,7 @@ SpnWrapper SpnWrapper::learn_spn_table(const ThreadSafePooledString &name_of_dat
                 leaf_types[current_column - primary_key_count] = Spn::CONTINUOUS;
             }
             auto callback_data = std::make_unique<CallbackOperator>([&](const Schema &S, const Tuple &T) {
+                if (skip_tuple()) return;
                 if (T.is_null(current_column)) {
                     null_matrix(current_row, current_column - primary_key_count) = 1;
                     data(current_row, current_column - primary_key_count) = 0;
@@ -93,6 +125,7 @@ SpnWrapper SpnWrapper::learn_spn_table(const ThreadSafePooledString &name_of_dat
                 leaf_types[current_column - primary_key_count] = Spn::DISCRETE;
             }
             auto callback_data = std::make_unique<CallbackOperator>([&](const Schema &S, const Tuple &T) {
+                if (skip_tuple()) return;
                 if (T.is_null(current_column)) {
                     null_matrix(current_row, current_column - primary_key_count) = 1;
                     data(current_row, current_column - primary_key_count) = 0;
@@ -109,13 +142,14 @@ SpnWrapper SpnWrapper::learn_spn_table(const ThreadSafePooledString &name_of_dat
                 leaf_types[current_column - primary_key_count] = Spn::CONTINUOUS;
             }
             auto callback_data = std::make_unique<CallbackOperator>([&](const Schema &S, const Tuple &T) {
+                if (skip_tuple()) return;
                 if (T.is_null(current_column)) {
                     null_matrix(current_row, current_column - primary_key_count) = 1;
                     data(current_row, current_column - primary_key_count) = 0;
                 } else {
                     auto v_pointer = T.get(current_column).as_p();
                     const char* value = static_cast<const char*>(v_pointer);
-                    data(current_row, current_column - primary_key_count) = float(std::hash<const char*>{}(value));
+                    data(current_row, current_column - primary_key_count) = float(std::hash<std::string_view>{}(value));
                     //data(current_row, current_column-primary_key_count) = 0;
                 }
                 current_row++;
@@ -126,12 +160,23 @@ SpnWrapper SpnWrapper::learn_spn_table(const ThreadSafePooledString &name_of_dat
 
     db.cardinality_estimator(std::move(old_estimator));
 
-    return SpnWrapper(Spn::learn_spn(data, null_matrix, leaf_types), std::move(attribute_to_id));
+    return { std::move(data), std::move(null_matrix), std::move(attribute_to_id), num_rows };
+}
+
+SpnWrapper SpnWrapper::learn_spn_table(const ThreadSafePooledString &name_of_database,
+                                       const ThreadSafePooledString &name_of_table,
+                                       std::vector<Spn::LeafType> leaf_types,
+                                       std::size_t sample_size, unsigned num_threads)
+{
+    auto [data, null_matrix, attribute_to_id, num_rows] =
+        read_table(name_of_database, name_of_table, leaf_types, sample_size);
+    return SpnWrapper(Spn::learn_spn(data, null_matrix, leaf_types, num_rows, num_threads), std::move(attribute_to_id));
 }
 
 std::unordered_map<ThreadSafePooledString, SpnWrapper*>
 SpnWrapper::learn_spn_database(const ThreadSafePooledString &name_of_database,
-                               std::unordered_map<ThreadSafePooledString, std::vector<Spn::LeafType>> leaf_types)
+                               std::unordered_map<ThreadSafePooledString, std::vector<Spn::LeafType>> leaf_types,
+                               std::size_t sample_size, unsigned num_threads)
 {
     auto &C = Catalog::Get();
     auto &db = C.get_database(name_of_database);
@@ -142,10 +187,49 @@ SpnWrapper::learn_spn_database(const ThreadSafePooledString &name_of_database,
         spns.emplace(
             table_it->first,
             new SpnWrapper(
-                learn_spn_table(name_of_database, table_it->first, std::move(leaf_types[table_it->first]))
+                learn_spn_table(name_of_database, table_it->first, std::move(leaf_types[table_it->first]), sample_size,
+                                num_threads)
             )
         );
     }
 
     return spns;
 }
+
+void SpnWrapper::insert_rows(const Table &table, std::size_t first_row)
+{
+    auto &store = table.store();
+    const std::size_t num_rows = store.num_rows();
+    if (first_row >= num_rows) return;
+
+    /* map each attribute of the table to its position in a row of the SPN; primary keys are not part of the SPN */
+    const Schema schema = table.schema();
+    std::vector<std::pair<std::size_t, unsigned>> columns;
+    for (std::size_t i = 0; i != schema.num_entries(); ++i) {
+        if (auto it = attribute_to_id_.find(schema[i].id.name); it != attribute_to_id_.end())
+            columns.emplace_back(i, it->second);
+    }
+
+    /* load the appended rows directly from the store */
+    auto loader = Interpreter::compile_load(schema, store.memory().addr(), table.layout(), schema, first_row);
+    Tuple tup(schema);
+    Tuple *args[] = { &tup };
+    VectorXf row(columns.size());
+    for (std::size_t i = first_row; i != num_rows; ++i) {
+        loader(args);
+        for (auto [column, spn_id] : columns)
+            row(spn_id) = tup.is_null(column) ? 0.f : to_spn_domain(*schema[column].type, tup.get(column));
+        spn_.insert_row(row);
+        tup.clear();
+    }
+}
+
+void SpnWrapper::relearn_drifted(const ThreadSafePooledString &name_of_database,
+                                 const ThreadSafePooledString &name_of_table,
+                                 std::size_t sample_size, unsigned num_threads)
+{
+    std::vector<Spn::LeafType> leaf_types;
+    auto [data, null_matrix, attribute_to_id, num_rows] =
+        read_table(name_of_database, name_of_table, leaf_types, sample_size);
+    spn_.relearn_drifted(data, null_matrix, num_rows, num_threads);
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutable/catalog/Schema.hpp>
 #include <mutable/util/Pool.hpp>
 #include <unordered_map>
 #include <util/Spn.hpp>
@@ -18,6 +19,21 @@ struct SpnWrapper
     Spn spn_;
     std::unordered_map<ThreadSafePooledString, unsigned> attribute_to_id_; ///< a map from attribute to spn internal id
 
+    /** The data of a table prepared for learning. */
+    struct TableData
+    {
+        Eigen::MatrixXf data; ///< the data of the non-primary key attributes of the (sampled) rows
+        Eigen::MatrixXi null_matrix; ///< the NULL values of the data as a matrix
+        std::unordered_map<ThreadSafePooledString, unsigned> attribute_to_id; ///< from attribute to spn internal id
+        std::size_t num_rows; ///< the number of rows of the table
+    };
+
+    /** Reads the data of table \p name_of_table in database \p name_of_database, possibly a uniform sample of \p
+     * sample_size rows, and resolves the \p leaf_types of type `AUTO`. */
+    static TableData read_table(const ThreadSafePooledString &name_of_database,
+                                const ThreadSafePooledString &name_of_table,
+                                std::vector<Spn::LeafType> &leaf_types, std::size_t sample_size);
+
     SpnWrapper(Spn spn, std::unordered_map<ThreadSafePooledString, unsigned> attribute_to_id)
         : spn_(std::move(spn))
         , attribute_to_id_(std::move(attribute_to_id))
@@ -49,22 +65,29 @@ struct SpnWrapper
      * @param name_of_database  the database
      * @param name_of_table     the table in the database
      * @param leaf_types        the types of a leaf for a non-primary key attribute
+     * @param sample_size       the number of rows, drawn uniformly at random, to learn the SPN on; 0 to learn on all rows
+     * @param num_threads       the maximum number of threads to learn with
      * @return                  the learned SPN
      */
     static SpnWrapper learn_spn_table(const ThreadSafePooledString &name_of_database,
                                       const ThreadSafePooledString &name_of_table,
-                                      std::vector<Spn::LeafType> leaf_types = decltype(leaf_types)());
+                                      std::vector<Spn::LeafType> leaf_types = decltype(leaf_types)(),
+                                      std::size_t sample_size = 0, unsigned num_threads = 1);
 
     /** Learn SPNs over the tables in the given database.
      *
      * @param name_of_database  the database
      * @param leaf_types        the type of a leaf for a non-primary key attribute in the respective table
+     * @param sample_size       the number of rows per table to learn the SPNs on; 0 to learn on all rows
+     * @param num_threads       the maximum number of threads to learn each SPN with
      * @return                  the learned SPNs
      */
     static std::unordered_map<ThreadSafePooledString, SpnWrapper*>
     learn_spn_database(
         const ThreadSafePooledString &name_of_database,
-        std::unordered_map<ThreadSafePooledString, std::vector<Spn::LeafType>> leaf_types = decltype(leaf_types)()
+        std::unordered_map<ThreadSafePooledString, std::vector<Spn::LeafType>> leaf_types = decltype(leaf_types)(),
+        std::size_t sample_size = 0,
+        unsigned num_threads = 1
     );
 
 
@@ -106,6 +129,24 @@ struct SpnWrapper
     /** Delete the given row from the SPN. */
     void delete_row(Eigen::VectorXf &row) { spn_.delete_row(row); };
 
+    /** Insert the rows of \p table from \p first_row to the end of its store into the SPN, e.g. after an INSERT or
+     * IMPORT statement appended these rows. */
+    void insert_rows(const Table &table, std::size_t first_row);
+
+    /** Returns `true` iff the rows inserted since learning deviate so much from the learned data that parts of the SPN
+     * should be relearned. */
+    bool has_drifted() const { return spn_.has_drifted(); }
+
+    /** Relearn the drifted parts of the SPN from the current data of the table.
+     *
+     * @param name_of_database  the database
+     * @param name_of_table     the table in the database this SPN was learned on
+     * @param sample_size       the number of rows, drawn uniformly at random, to relearn on; 0 to relearn on all rows
+     * @param num_threads       the maximum number of threads to learn with
+     */
+    void relearn_drifted(const ThreadSafePooledString &name_of_database, const ThreadSafePooledString &name_of_table,
+                         std::size_t sample_size = 0, unsigned num_threads = 1);
+
     /** Estimate the number of distinct values of the given attribute. */
     std::size_t estimate_number_distinct_values(const ThreadSafePooledString &attribute) const {
         return spn_.estimate_number_distinct_values(translate_attribute(attribute));
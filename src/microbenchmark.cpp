@@ -0,0 +1,637 @@
+#include "backend/StackMachine.hpp"
+#include "util/container/RefCountingHashMap.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/CostFunction.hpp>
+#include <mutable/io/Reader.hpp>
+#include <mutable/IR/PlanEnumerator.hpp>
+#include <mutable/IR/PlanTable.hpp>
+#include <mutable/IR/QueryGraph.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <mutable/mutable.hpp>
+#include <mutable/Options.hpp>
+#include <mutable/storage/Store.hpp>
+#include <mutable/util/ADT.hpp>
+#include <mutable/util/ArgParser.hpp>
+#include <mutable/util/Diagnostic.hpp>
+#include <mutable/util/fn.hpp>
+#include <mutable/util/Pool.hpp>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+using namespace std::chrono;
+using Subproblem = m::SmallBitset;
+
+
+/*======================================================================================================================
+ * Allocation counting
+ *
+ * All dynamic allocations of the benchmarked thread are counted by interposing the allocation functions.  With glibc,
+ * we interpose `malloc` and friends, which also covers `operator new` and allocations by `strdup()` etc.  Elsewhere, we
+ * can only replace the global `operator new`.
+ *====================================================================================================================*/
+
+namespace {
+
+/* Constant-initialized such that they can be used before any dynamic initialization. */
+thread_local std::size_t num_allocations = 0; ///< the number of allocations of this thread
+thread_local std::size_t num_allocated_bytes = 0; ///< the number of bytes allocated by this thread
+
+inline void count_allocation(std::size_t size) { ++num_allocations; num_allocated_bytes += size; }
+
+}
+
+#if defined(__GLIBC__)
+extern "C" {
+
+void * __libc_malloc(std::size_t size);
+void * __libc_calloc(std::size_t num, std::size_t size);
+void * __libc_realloc(void *ptr, std::size_t size);
+void * __libc_memalign(std::size_t alignment, std::size_t size);
+void __libc_free(void *ptr);
+
+void * malloc(std::size_t size) noexcept { count_allocation(size); return __libc_malloc(size); }
+void * calloc(std::size_t num, std::size_t size) noexcept { count_allocation(num * size); return __libc_calloc(num, size); }
+void * realloc(void *ptr, std::size_t size) noexcept { count_allocation(size); return __libc_realloc(ptr, size); }
+void free(void *ptr) noexcept { __libc_free(ptr); }
+
+void * aligned_alloc(std::size_t alignment, std::size_t size) noexcept
+{
+    count_allocation(size);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **ptr, std::size_t alignment, std::size_t size) noexcept
+{
+    count_allocation(size);
+    *ptr = __libc_memalign(alignment, size);
+    return *ptr ? 0 : ENOMEM;
+}
+
+}
+#else
+void * operator new(std::size_t size)
+{
+    count_allocation(size);
+    if (void *ptr = std::malloc(size)) return ptr;
+    throw std::bad_alloc();
+}
+void * operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+#endif
+
+
+/*======================================================================================================================
+ * Benchmark harness
+ *====================================================================================================================*/
+
+struct
+{
+    ///> whether to show a help message
+    bool show_help;
+    ///> whether to list the benchmarks instead of running them
+    bool list;
+    ///> only benchmarks whose name matches this regular expression are run
+    std::regex filter;
+    ///> the number of measured repetitions of each benchmark
+    unsigned repetitions;
+    ///> the number of unmeasured repetitions before the measured repetitions
+    unsigned warmup;
+    ///> the number of relations of the synthetic query graphs
+    unsigned num_relations;
+    ///> the seed for the PRNG
+    unsigned seed;
+} args;
+
+/** Prevents the compiler from optimizing away the computation of \p value. */
+template<typename T>
+inline void do_not_optimize(T &&value) { asm volatile("" : : "g"(&value) : "memory"); }
+
+/** A single repetition of a benchmark. */
+struct measurement
+{
+    double ns; ///< the time in nanoseconds
+    std::size_t num_allocations; ///< the number of allocations
+    std::size_t num_allocated_bytes; ///< the number of bytes allocated
+};
+
+/** Returns `true` iff the benchmark \p name is selected by the filter and must be run.  When only listing the
+ * benchmarks, prints \p name instead and returns `false`.  Benchmarks with expensive setup check this before their
+ * setup. */
+bool must_run(const std::string &name)
+{
+    if (not std::regex_search(name, args.filter))
+        return false;
+    if (args.list) {
+        std::cout << name << '\n';
+        return false;
+    }
+    return true;
+}
+
+/** Runs the benchmark \p name, that performs \p num_ops operations in \p run, `args.repetitions` times and emits the
+ * median and minimal time per operation as well as the number of allocations and allocated bytes per operation.  \p
+ * prepare is invoked before every repetition and is neither timed nor are its allocations counted. */
+template<typename Prepare, typename Run>
+void benchmark(const std::string &name, std::size_t num_ops, Prepare &&prepare, Run &&run)
+{
+    if (not must_run(name))
+        return;
+
+    std::vector<measurement> measurements;
+    measurements.reserve(args.repetitions);
+    for (unsigned i = 0; i != args.warmup + args.repetitions; ++i) {
+        prepare();
+        const auto allocations_before = num_allocations;
+        const auto bytes_before = num_allocated_bytes;
+        const auto begin = steady_clock::now();
+        run();
+        const auto end = steady_clock::now();
+        if (i >= args.warmup) {
+            measurements.push_back(measurement{
+                .ns = double(duration_cast<nanoseconds>(end - begin).count()),
+                .num_allocations = num_allocations - allocations_before,
+                .num_allocated_bytes = num_allocated_bytes - bytes_before,
+            });
+        }
+    }
+
+    std::sort(measurements.begin(), measurements.end(), [](auto &left, auto &right) { return left.ns < right.ns; });
+    const auto &median = measurements[measurements.size() / 2];
+    const auto &min = measurements.front();
+    const double ops = num_ops;
+    std::cout << name << ',' << num_ops << ','
+              << median.ns / ops << ',' << min.ns / ops << ','
+              << median.num_allocations / ops << ',' << median.num_allocated_bytes / ops << std::endl;
+}
+
+template<typename Run>
+void benchmark(const std::string &name, std::size_t num_ops, Run &&run)
+{
+    benchmark(name, num_ops, [](){ }, std::forward<Run>(run));
+}
+
+
+/*======================================================================================================================
+ * StackMachine
+ *====================================================================================================================*/
+
+void benchmark_StackMachine(m::Diagnostic &diag)
+{
+    constexpr std::size_t NUM_EVALUATIONS = 1UL << 16;
+    m::Catalog &C = m::Catalog::Get();
+    auto &DB = C.get_database_in_use();
+
+    auto &tbl = DB.add_table(C.pool("sm"));
+    tbl.push_back(C.pool("i"), m::Type::Get_Integer(m::Type::TY_Vector, 8));
+    tbl.push_back(C.pool("d"), m::Type::Get_Double(m::Type::TY_Vector));
+    tbl.push_back(C.pool("c"), m::Type::Get_Char(m::Type::TY_Vector, 16));
+
+    m::Schema schema;
+    for (auto &attr : tbl)
+        schema.add({tbl.name(), attr.name}, attr.type);
+
+    m::Tuple in(schema);
+    in.set(0, int64_t(42));
+    in.set(1, 13.37);
+    in.not_null(2);
+    strcpy(reinterpret_cast<char*>(in[2].as_p()), "microbenchmark");
+
+    for (auto expr_str : {
+        "i + 42",
+        "i * i + i / 3",
+        "d * 2.5 - d",
+        "i < 100 AND d > 1.5",
+        "i * d",
+        "c = \"microbenchmark\"",
+        "c < \"micro\"",
+        "c LIKE \"%bench%\"",
+    }) {
+        auto stmt = m::statement_from_string(diag, std::string("SELECT ") + expr_str + " FROM sm;");
+        if (diag.num_errors()) {
+            std::cerr << "Skipping StackMachine benchmark of '" << expr_str << "'.\n";
+            diag.clear();
+            continue;
+        }
+        auto &select = m::as<const m::ast::SelectClause>(*m::as<const m::ast::SelectStmt>(*stmt).select);
+        auto &expr = *select.select[0].first;
+        m::StackMachine SM(schema);
+        SM.emit(expr, 1);
+        SM.emit_St_Tup(0, 0, expr.type());
+        m::Tuple out({ expr.type() });
+        m::Tuple *args[] = { &out, &in };
+
+        std::ostringstream name;
+        name << "StackMachine/" << expr_str << " (" << SM.num_ops() << " opcodes)";
+        benchmark(name.str(), NUM_EVALUATIONS, [&]() {
+            for (std::size_t i = 0; i != NUM_EVALUATIONS; ++i) {
+                SM(args);
+                do_not_optimize(out);
+            }
+        });
+    }
+}
+
+
+/*======================================================================================================================
+ * Pool
+ *====================================================================================================================*/
+
+void benchmark_Pool()
+{
+    constexpr std::size_t NUM_STRINGS = 1UL << 16;
+    std::vector<std::string> strings;
+    strings.reserve(NUM_STRINGS);
+    for (std::size_t i = 0; i != NUM_STRINGS; ++i)
+        strings.emplace_back("identifier_" + std::to_string(i * 2654435761UL));
+
+    auto run = [&strings]<typename StringPool>(const char *name) {
+        using proxy_type = typename StringPool::proxy_type;
+
+        /*----- Intern strings that are not yet pooled. -----*/
+        std::unique_ptr<StringPool> pool;
+        std::vector<proxy_type> pooled;
+        auto insert = [&]() {
+            for (auto &str : strings)
+                pooled.emplace_back((*pool)(str.c_str()));
+        };
+        benchmark(std::string("Pool/") + name + "/insert", NUM_STRINGS,
+            [&]() { pooled.clear(); pool = std::make_unique<StringPool>(); pooled.reserve(NUM_STRINGS); },
+            insert
+        );
+
+        /*----- Intern strings that are already pooled. -----*/
+        /* Fills the pool, unless the insert benchmark was run and already filled it. */
+        auto prepare_lookup = [&]() {
+            if (not pool) {
+                pool = std::make_unique<StringPool>();
+                pooled.reserve(NUM_STRINGS);
+                insert();
+            }
+        };
+        benchmark(std::string("Pool/") + name + "/lookup", NUM_STRINGS, prepare_lookup, [&]() {
+            for (auto &str : strings) {
+                auto p = (*pool)(str.c_str());
+                do_not_optimize(p);
+            }
+        });
+        pooled.clear();
+    };
+    run.operator()<m::StringPool>("StringPool");
+    run.operator()<m::ThreadSafeStringPool>("ThreadSafeStringPool");
+}
+
+
+/*======================================================================================================================
+ * RefCountingHashMap
+ *====================================================================================================================*/
+
+void benchmark_RefCountingHashMap()
+{
+    using map_type = m::RefCountingHashMap<uint64_t, uint64_t>;
+
+    for (std::size_t num_keys : { 1UL << 10, 1UL << 20 }) {
+        std::vector<uint64_t> keys(num_keys);
+        std::mt19937_64 g(args.seed);
+        for (auto &k : keys) k = g();
+        const std::string suffix = '/' + std::to_string(num_keys);
+
+        std::unique_ptr<map_type> map;
+        auto insert = [&]() {
+            for (auto k : keys)
+                map->insert_with_duplicates(k, k);
+        };
+        /* Fills the map, unless the insert benchmark was run and already filled it. */
+        auto prepare_find = [&]() {
+            if (not map) {
+                map = std::make_unique<map_type>(1024);
+                insert();
+            }
+        };
+        benchmark("RefCountingHashMap/insert" + suffix, num_keys,
+            [&]() { map = std::make_unique<map_type>(1024); },
+            insert
+        );
+        benchmark("RefCountingHashMap/find_hit" + suffix, num_keys, prepare_find, [&]() {
+            for (auto k : keys) {
+                auto it = map->find(k);
+                do_not_optimize(it);
+            }
+        });
+        benchmark("RefCountingHashMap/find_miss" + suffix, num_keys, prepare_find, [&]() {
+            for (auto k : keys) {
+                auto it = map->find(~k);
+                do_not_optimize(it);
+            }
+        });
+    }
+}
+
+
+/*======================================================================================================================
+ * SmallBitset subset enumeration
+ *====================================================================================================================*/
+
+void benchmark_SmallBitset()
+{
+    for (unsigned n : { 16U, 20U }) {
+        const Subproblem All = Subproblem::All(n);
+        const std::string suffix = '/' + std::to_string(n);
+
+        benchmark("SmallBitset/next_subset" + suffix, (1UL << n) - 1, [&]() {
+            for (Subproblem S = m::least_subset(All); S != All; S = m::next_subset(S, All))
+                do_not_optimize(S);
+        });
+
+        /* Every element is contained in half of all subsets, i.e. in 2^(n-1) - 1 of the enumerated proper subsets. */
+        benchmark("SmallBitset/iterate" + suffix, n * ((1UL << (n - 1)) - 1), [&]() {
+            for (Subproblem S = m::least_subset(All); S != All; S = m::next_subset(S, All)) {
+                for (auto it = S.begin(); it != S.end(); ++it)
+                    do_not_optimize(it);
+            }
+        });
+
+        const unsigned k = n / 2;
+        std::size_t num_subsets = 0;
+        for (auto GH = m::GospersHack::enumerate_all(k, n); GH; ++GH)
+            ++num_subsets;
+        benchmark("SmallBitset/GospersHack" + suffix, num_subsets, [&]() {
+            for (auto GH = m::GospersHack::enumerate_all(k, n); GH; ++GH)
+                do_not_optimize(*GH);
+        });
+        benchmark("SmallBitset/SubsetEnumerator" + suffix, num_subsets, [&]() {
+            for (m::SubsetEnumerator E(All, k); E; ++E)
+                do_not_optimize(*E);
+        });
+    }
+}
+
+
+/*======================================================================================================================
+ * DSVReader
+ *====================================================================================================================*/
+
+void benchmark_DSVReader(m::Diagnostic &diag)
+{
+    constexpr std::size_t NUM_ROWS = 1UL << 16;
+    m::Catalog &C = m::Catalog::Get();
+    auto &DB = C.get_database_in_use();
+
+    auto &tbl = DB.add_table(C.pool("dsv"));
+    tbl.push_back(C.pool("i2"), m::Type::Get_Integer(m::Type::TY_Vector, 2));
+    tbl.push_back(C.pool("i4"), m::Type::Get_Integer(m::Type::TY_Vector, 4));
+    tbl.push_back(C.pool("i8"), m::Type::Get_Integer(m::Type::TY_Vector, 8));
+    tbl.push_back(C.pool("d"),  m::Type::Get_Double(m::Type::TY_Vector));
+    tbl.push_back(C.pool("c"),  m::Type::Get_Char(m::Type::TY_Vector, 20));
+    tbl.layout(C.data_layout());
+
+    if (not must_run("DSVReader/CSV"))
+        return; // skip generating the data
+
+    std::ostringstream oss;
+    std::mt19937_64 g(args.seed);
+    oss << "i2,i4,i8,d,c\n";
+    for (std::size_t i = 0; i != NUM_ROWS; ++i) {
+        oss << int16_t(g()) << ',' << int32_t(g()) << ',' << int64_t(g()) << ','
+            << std::uniform_real_distribution<double>(-1e6, 1e6)(g) << ','
+            << "\"string_" << (g() % 1'000'000'000) << "\"\n";
+    }
+    const std::string csv = oss.str();
+
+    auto config = m::DSVReader::Config::CSV();
+    config.has_header = true;
+    config.skip_header = true;
+
+    std::istringstream in;
+    benchmark("DSVReader/CSV", NUM_ROWS,
+        [&]() { tbl.store(C.create_store(tbl)); in.str(csv); in.clear(); },
+        [&]() {
+            m::DSVReader R(tbl, config, diag);
+            R(in, "microbenchmark");
+        }
+    );
+}
+
+
+/*======================================================================================================================
+ * PlanTable and PlanEnumerator
+ *====================================================================================================================*/
+
+/** Creates `args.num_relations` tables with increasing numbers of rows and returns a query joining these tables in the
+ * given `topology`, i.e. chain, cycle, star, or clique. */
+std::string make_query(const std::string &topology)
+{
+    const unsigned n = args.num_relations;
+    std::ostringstream oss;
+    oss << "SELECT * FROM ";
+    for (unsigned i = 0; i != n; ++i)
+        oss << (i ? ", " : "") << 'T' << i;
+
+    std::vector<std::pair<unsigned, unsigned>> edges;
+    if (topology == "chain" or topology == "cycle") {
+        for (unsigned i = 1; i != n; ++i)
+            edges.emplace_back(i - 1, i);
+        if (topology == "cycle" and n > 2)
+            edges.emplace_back(n - 1, 0);
+    } else if (topology == "star") {
+        for (unsigned i = 1; i != n; ++i)
+            edges.emplace_back(0, i);
+    } else if (topology == "clique") {
+        for (unsigned i = 0; i != n; ++i) {
+            for (unsigned j = i + 1; j != n; ++j)
+                edges.emplace_back(i, j);
+        }
+    } else {
+        M_unreachable("unknown topology");
+    }
+
+    oss << " WHERE ";
+    for (auto it = edges.begin(); it != edges.end(); ++it)
+        oss << (it != edges.begin() ? " AND " : "") << 'T' << it->first << ".id = T" << it->second << ".id";
+    oss << ';';
+    return oss.str();
+}
+
+template<typename PlanTable>
+void init_PT_base_case(const m::QueryGraph &G, PlanTable &PT)
+{
+    auto &CE = m::Catalog::Get().get_database_in_use().cardinality_estimator();
+    for (auto &ds : G.sources()) {
+        Subproblem s = Subproblem::Singleton(ds->id());
+        PT[s].cost = 0;
+        PT[s].model = CE.estimate_scan(G, s);
+    }
+}
+
+void benchmark_PlanEnumerators(m::Diagnostic &diag)
+{
+    m::Catalog &C = m::Catalog::Get();
+    auto &DB = C.get_database_in_use();
+
+    /*----- Create the relations to join. -----*/
+    for (unsigned i = 0; i != args.num_relations; ++i) {
+        auto &tbl = DB.add_table(C.pool(("T" + std::to_string(i)).c_str()));
+        tbl.push_back(C.pool("id"), m::Type::Get_Integer(m::Type::TY_Vector, 4));
+        tbl.store(C.create_store(tbl));
+        tbl.layout(C.data_layout());
+        for (unsigned j = 0; j != 10 * (i + 1); ++j)
+            tbl.store().append();
+    }
+
+    /*----- Collect the plan enumerators in a deterministic order. -----*/
+    std::vector<std::pair<std::string, const m::pe::PlanEnumerator*>> enumerators;
+    for (auto it = C.plan_enumerators_begin(); it != C.plan_enumerators_end(); ++it)
+        enumerators.emplace_back(*it->first, &*it->second);
+    std::sort(enumerators.begin(), enumerators.end());
+
+    const m::CostFunction &CF = C.cost_function();
+    for (auto topology : { "chain", "cycle", "star", "clique" }) {
+        auto stmt = m::statement_from_string(diag, make_query(topology));
+        M_insist(diag.num_errors() == 0);
+        auto G = m::QueryGraph::Build(*stmt);
+        const std::string suffix = std::string("/") + topology + '-' + std::to_string(args.num_relations);
+
+        /*----- PlanTable lookups. -----*/
+        {
+            constexpr std::size_t NUM_LOOKUPS = 1UL << 20;
+            std::vector<Subproblem> subproblems(NUM_LOOKUPS);
+            std::mt19937_64 g(args.seed);
+            const uint64_t all = uint64_t(Subproblem::All(G->num_sources()));
+            for (auto &S : subproblems)
+                S = Subproblem(std::uniform_int_distribution<uint64_t>(1, all)(g));
+
+            auto lookup = [&]<typename PlanTable>(const char *name) {
+                const std::string benchmark_name = std::string("PlanTable/") + name + suffix;
+                if (not must_run(benchmark_name))
+                    return; // skip filling the plan table
+                PlanTable PT(*G);
+                init_PT_base_case(*G, PT);
+                C.plan_enumerator()(*G, CF, PT); // fill the plan table
+                benchmark(benchmark_name, NUM_LOOKUPS, [&]() {
+                    for (auto S : subproblems) {
+                        bool has_plan = PT.has_plan(S);
+                        do_not_optimize(has_plan);
+                    }
+                });
+            };
+            lookup.operator()<m::PlanTableSmallOrDense>("SmallOrDense");
+            lookup.operator()<m::PlanTableLargeAndSparse>("LargeAndSparse");
+        }
+
+        /*----- Plan enumerators. -----*/
+        for (auto &[name, PE] : enumerators) {
+            std::unique_ptr<m::PlanTableSmallOrDense> PT;
+            try {
+                benchmark("PlanEnumerator/" + name + suffix, 1,
+                    [&]() { PT = std::make_unique<m::PlanTableSmallOrDense>(*G); init_PT_base_case(*G, *PT); },
+                    [&]() { (*PE)(*G, CF, *PT); }
+                );
+            } catch (const std::exception &e) {
+                std::cerr << "Skipping plan enumerator " << name << " on " << topology << ": " << e.what() << '\n';
+            }
+        }
+    }
+}
+
+
+/*======================================================================================================================
+ * main
+ *====================================================================================================================*/
+
+void usage(std::ostream &out, const char *name)
+{
+    out << "A microbenchmark suite for operators and data structures of mu*t*able.\n"
+        << "Emits one CSV row per benchmark with the time (median and minimum), allocations, and allocated bytes per "
+           "operation.\n"
+        << "USAGE:\n\t" << name << " [<OPTIONS>]"
+        << std::endl;
+}
+
+int main(int argc, const char **argv)
+{
+    m::Catalog &C = m::Catalog::Get();
+
+    /*----- Parse command line arguments. ----------------------------------------------------------------------------*/
+    m::ArgParser &AP = C.arg_parser();
+#define ADD(TYPE, VAR, INIT, SHORT, LONG, DESCR, CALLBACK)\
+    VAR = INIT;\
+    {\
+        AP.add<TYPE>(SHORT, LONG, DESCR, CALLBACK);\
+    }
+    /*----- Help message ---------------------------------------------------------------------------------------------*/
+    ADD(bool, args.show_help, false,                                        /* Type, Var, Init  */
+        "-h", "--help",                                                     /* Short, Long      */
+        "prints this help message",                                         /* Description      */
+        [&](bool) { args.show_help = true; });                              /* Callback         */
+    /*----- List -----------------------------------------------------------------------------------------------------*/
+    ADD(bool, args.list, false,                                             /* Type, Var, Init  */
+        "-l", "--list",                                                     /* Short, Long      */
+        "list the benchmarks instead of running them",                      /* Description      */
+        [&](bool) { args.list = true; });                                   /* Callback         */
+    /*----- Filter ---------------------------------------------------------------------------------------------------*/
+    ADD(const char*, args.filter, std::regex(""),                           /* Type, Var, Init  */
+        "-f", "--filter",                                                   /* Short, Long      */
+        "only run benchmarks whose name matches the regular expression",    /* Description      */
+        [&](const char *re) { args.filter = std::regex(re); });             /* Callback         */
+    /*----- Repetitions ----------------------------------------------------------------------------------------------*/
+    ADD(unsigned, args.repetitions, 5,                                      /* Type, Var, Init  */
+        "-r", "--repetitions",                                              /* Short, Long      */
+        "the number of measured repetitions of each benchmark",             /* Description      */
+        [&](unsigned n) { args.repetitions = std::max(n, 1U); });           /* Callback         */
+    ADD(unsigned, args.warmup, 1,                                           /* Type, Var, Init  */
+        nullptr, "--warmup",                                                /* Short, Long      */
+        "the number of unmeasured repetitions of each benchmark",           /* Description      */
+        [&](unsigned n) { args.warmup = n; });                              /* Callback         */
+    /*----- Query graphs ---------------------------------------------------------------------------------------------*/
+    ADD(unsigned, args.num_relations, 10,                                   /* Type, Var, Init  */
+        nullptr, "--relations",                                             /* Short, Long      */
+        "the number of relations of the synthetic query graphs",            /* Description      */
+        [&](unsigned n) { args.num_relations = std::clamp(n, 2U, 20U); });  /* Callback         */
+    /*----- Seed -----------------------------------------------------------------------------------------------------*/
+    ADD(unsigned, args.seed, 42,                                            /* Type, Var, Init  */
+        nullptr, "--seed",                                                  /* Short, Long      */
+        "the seed for the PRNG",                                            /* Description      */
+        [&](unsigned s) { args.seed = s; });                                /* Callback         */
+#undef ADD
+    AP.parse_args(argc, argv);
+
+    /*----- Help message. -----*/
+    if (args.show_help) {
+        usage(std::cout, argv[0]);
+        std::cout << "WHERE\n" << AP;
+        std::exit(EXIT_SUCCESS);
+    }
+
+    /*----- Configure mutable. ---------------------------------------------------------------------------------------*/
+    m::Options::Get().quiet = true;
+    m::Diagnostic diag(false, std::cout, std::cerr);
+    auto &DB = C.add_database(C.pool("microbenchmark"));
+    C.set_database_in_use(DB);
+
+    /*----- Run benchmarks. ------------------------------------------------------------------------------------------*/
+    if (not args.list)
+        std::cout << "benchmark,ops,ns_per_op,min_ns_per_op,allocations_per_op,bytes_per_op" << std::endl;
+    benchmark_StackMachine(diag);
+    benchmark_Pool();
+    benchmark_RefCountingHashMap();
+    benchmark_SmallBitset();
+    benchmark_DSVReader(diag);
+    benchmark_PlanEnumerators(diag);
+
+    m::Catalog::Destroy();
+}
@@ -20,6 +20,30 @@ using namespace m;
 using namespace m::ast;
 
 
+namespace {
+
+/** Prints all finished `Measurement`s of `timer` to `out` as `<name>: <milliseconds>`, one per line.  Hardware
+ * performance counters of a `Measurement` are printed on separate lines as `<name> [<counter>]: <value>`, such that
+ * patterns matching the timing of a `Measurement` do not match its counters. */
+void print_times(std::ostream &out, const Timer &timer)
+{
+    using namespace std::chrono;
+    for (const auto &M : timer) {
+        if (not M.is_finished()) continue;
+        out << M.name << ": " << duration_cast<microseconds>(M.duration()).count() / 1e3 << '\n';
+        if (M.has_counters()) {
+            const auto counters = M.counters();
+            for (unsigned i = 0; i != PerfCounters::NUM_COUNTERS; ++i) {
+                if (counters[i] != PerfCounters::UNAVAILABLE)
+                    out << M.name << " [" << PerfCounters::name(PerfCounters::counter_t(i)) << "]: " << counters[i]
+                        << '\n';
+            }
+        }
+    }
+}
+
+}
+
 bool m::init() { return streq(m::version::GIT_REV, m::version::get().GIT_REV); }
 
 std::unique_ptr<Stmt> m::statement_from_string(Diagnostic &diag, const std::string &str)
@@ -80,11 +104,7 @@ void m::process_stream(std::istream &in, const char *filename, Diagnostic diag)
         C.scheduler().autocommit(std::move(ast), diag);
 
         if (Options::Get().times) {
-            using namespace std::chrono;
-            for (const auto &M : timer) {
-                if (M.is_finished())
-                    std::cout << M.name << ": " << duration_cast<microseconds>(M.duration()).count() / 1e3 << '\n';
-            }
+            print_times(std::cout, timer);
             std::cout.flush();
             timer.clear();
         }
@@ -184,8 +204,11 @@ void m::execute_statement(Diagnostic &diag, const ast::Stmt &stmt, const bool is
         if (Options::Get().physplan)
             physical_plan->dump(std::cout);
 
-        if (not Options::Get().dryrun)
+        if (not Options::Get().dryrun) {
             M_TIME_EXPR(backend->execute(*physical_plan), "Execute query", timer);
+            if (auto &CE = C.get_database_in_use().cardinality_estimator(); CE.requests_feedback())
+                CE.feedback(*logical_plan);
+        }
     } else if (auto I = cast<const ast::InsertStmt>(&stmt)) {
         auto &DB = C.get_database_in_use();
         auto &T = DB.get_table(I->table_name.text.assert_not_none());
@@ -193,6 +216,7 @@ void m::execute_statement(Diagnostic &diag, const ast::Stmt &stmt, const bool is
         StoreWriter W(store);
         auto &S = W.schema();
         Tuple tup(S);
+        const std::size_t first_row = store.num_rows();
 
         /* Write all tuples to the store. */
         for (auto &t : I->tuples) {
@@ -219,6 +243,8 @@ void m::execute_statement(Diagnostic &diag, const ast::Stmt &stmt, const bool is
             get_tuple(args);
             W.append(tup);
         }
+
+        DB.rows_appended(T, first_row);
     } else if (auto S = cast<const ast::CreateDatabaseStmt>(&stmt)) {
         C.add_database(S->database_name.text.assert_not_none());
     } else if (auto S = cast<const ast::DropDatabaseStmt>(&stmt)) {
@@ -255,6 +281,8 @@ void m::execute_statement(Diagnostic &diag, const ast::Stmt &stmt, const bool is
                 }, *c, tag<ConstASTConstraintVisitor>{});
             }
         }
+        for (auto &[name, ascending] : S->sort_key)
+            T.add_sort_key(name.text.assert_not_none(), ascending);
 
         T.layout(C.data_layout());
         T.store(C.create_store(T));
@@ -285,7 +313,9 @@ void m::execute_statement(Diagnostic &diag, const ast::Stmt &stmt, const bool is
                     diag.err() << ": " << strerror(errsv);
                 diag.err() << std::endl;
             } else {
+                const std::size_t first_row = T.store().num_rows();
                 M_TIME_EXPR(R(file, *S->path.text), "Read DSV file", timer);
+                DB.rows_appended(T, first_row);
             }
         } catch (m::invalid_argument e) {
             diag.err() << "Error reading DSV file: " << e.what() << "\n";
@@ -293,11 +323,7 @@ void m::execute_statement(Diagnostic &diag, const ast::Stmt &stmt, const bool is
     }
 
     if (Options::Get().times) {
-        using namespace std::chrono;
-        for (const auto &M : timer) {
-            if (M.is_finished())
-                std::cout << M.name << ": " << duration_cast<microseconds>(M.duration()).count() / 1e3 << '\n';
-        }
+        print_times(std::cout, timer);
         std::cout.flush();
         timer.clear();
     }
@@ -400,7 +426,9 @@ void m::load_from_CSV(Diagnostic &diag, Table &table, const std::filesystem::pat
             diag.err() << ": " << strerror(errno);
         diag.err() << std::endl;
     } else {
+        const std::size_t first_row = table.store().num_rows();
         R(file, path.c_str()); // read the file
+        Catalog::Get().get_database_in_use().rows_appended(table, first_row);
     }
 
     if (diag.num_errors() != 0)
@@ -180,6 +180,11 @@ void ASTDot::operator()(Const<ErrorClause> &c)
 
 void ASTDot::operator()(Const<SelectClause> &c)
 {
+    if (c.distinct) {
+        out << '\n';
+        indent() << q(std::hex << c << "DISTINCT") << "[label=\"DISTINCT\"];";
+        indent() << id(c) << EDGE << q(std::hex << c << "DISTINCT") << ';';
+    }
     if (c.select_all) {
         out << '\n';
         indent() << q(std::hex << c << '*') << "[label=\"*\"];";
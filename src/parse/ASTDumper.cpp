@@ -105,6 +105,8 @@ void ASTDumper::operator()(Const<SelectClause> &c)
 {
     indent() << "SelectClause (" << c.tok.pos << ')';
     ++indent_;
+    if (c.distinct)
+        indent() << "DISTINCT (" << c.distinct.pos << ')';
     if (c.select_all)
         indent() << "* (" << c.select_all.pos << ')';
     for (auto &s : c.select) {
@@ -310,6 +312,13 @@ void ASTDumper::operator()(Const<CreateTableStmt> &s)
         --indent_;
     }
     --indent_;
+    if (not s.sort_key.empty()) {
+        indent() << "sort key";
+        ++indent_;
+        for (auto &[name, ascending] : s.sort_key)
+            indent() << name.text << ' ' << (ascending ? "ASC" : "DESC") << " (" << name.pos << ')';
+        --indent_;
+    }
     --indent_;
 }
 
@@ -75,6 +75,7 @@ void ASTPrinter::operator()(Const<ErrorClause>&)
 void ASTPrinter::operator()(Const<SelectClause> &c)
 {
     out << "SELECT ";
+    if (c.distinct) out << "DISTINCT ";
     if (c.select_all) out << '*';
     for (auto it = c.select.cbegin(), end = c.select.cend(); it != end; ++it) {
         if (c.select_all or it != c.select.cbegin()) out << ", ";
@@ -219,7 +220,15 @@ void ASTPrinter::operator()(Const<CreateTableStmt> &s)
             (*this)(*c);
         }
     }
-    out << "\n);";
+    out << "\n)";
+    if (not s.sort_key.empty()) {
+        out << "\nORDER BY ";
+        for (auto it = s.sort_key.cbegin(), end = s.sort_key.cend(); it != end; ++it) {
+            if (it != s.sort_key.cbegin()) out << ", ";
+            out << it->first.text << (it->second ? " ASC" : " DESC");
+        }
+    }
+    out << ';';
 }
 
 void ASTPrinter::operator()(Const<DropTableStmt> &s)
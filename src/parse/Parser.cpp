@@ -356,7 +356,31 @@ exit_constraints:
     if (not expect(TK_RPAR))
         return recover<ErrorStmt>(std::move(start), follow_set_STATEMENT);
 
-    return std::make_unique<CreateTableStmt>(std::move(table_name), std::move(attrs));
+    /* [ 'ORDER' 'BY' ( sort-key-fields | '(' sort-key-fields ')' ) ] */
+    std::vector<CreateTableStmt::sort_key_field> sort_key;
+    if (accept(TK_Order)) {
+        if (not expect(TK_By))
+            return recover<ErrorStmt>(std::move(start), follow_set_STATEMENT);
+        const bool has_parentheses = accept(TK_LPAR);
+
+        /* identifier [ 'ASC' | 'DESC' ] { ',' identifier [ 'ASC' | 'DESC' ] } */
+        do {
+            Token id = token();
+            if (not expect(TK_IDENTIFIER))
+                return recover<ErrorStmt>(std::move(start), follow_set_STATEMENT);
+            if (accept(TK_Descending)) {
+                sort_key.emplace_back(std::move(id), false);
+            } else {
+                accept(TK_Ascending);
+                sort_key.emplace_back(std::move(id), true);
+            }
+        } while (accept(TK_COMMA));
+
+        if (has_parentheses and not expect(TK_RPAR))
+            return recover<ErrorStmt>(std::move(start), follow_set_STATEMENT);
+    }
+
+    return std::make_unique<CreateTableStmt>(std::move(table_name), std::move(attrs), std::move(sort_key));
 }
 
 std::unique_ptr<Stmt> Parser::parse_DropTableStmt()
@@ -757,6 +781,13 @@ std::unique_ptr<Clause> Parser::parse_SelectClause()
         return recover<ErrorClause>(std::move(start), follow_set_SELECT_CLAUSE);
     }
 
+    /* [ 'DISTINCT' ] */
+    Token distinct = Token::CreateArtificial();
+    if (token() == TK_Distinct) {
+        distinct = token();
+        consume();
+    }
+
     /* ( '*' | expression [ [ 'AS' ] identifier ] ) */
     Token select_all = Token::CreateArtificial();
     std::vector<SelectClause::select_type> select;
@@ -792,7 +823,8 @@ std::unique_ptr<Clause> Parser::parse_SelectClause()
         select.emplace_back(std::move(e), std::move(tok));
     }
 
-    return std::make_unique<SelectClause>(std::move(start), std::move(select), std::move(select_all));
+    return std::make_unique<SelectClause>(std::move(start), std::move(select), std::move(select_all),
+                                          std::move(distinct));
 }
 
 std::unique_ptr<Clause> Parser::parse_FromClause()
@@ -1,5 +1,6 @@
 #include "parse/Sema.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/io/Reader.hpp>
@@ -1168,6 +1169,18 @@ void Sema::operator()(SelectClause &c)
 
     if (has_vectorial and has_scalar)
         diag.e(c.tok.pos) << "SELECT clause with mixed scalar and vectorial values is forbidden.\n";
+
+    /* Duplicates are eliminated by grouping by all results, which is not possible for a query that already groups or
+     * for results of nested queries. */
+    if (c.distinct) {
+        auto &stmt = as<const SelectStmt>(Ctx.stmt);
+        if (stmt.group_by or stmt.having)
+            diag.e(c.distinct.pos) << "DISTINCT in combination with GROUP BY or HAVING is not supported.\n";
+        for (auto &s : c.select) {
+            if (is<const QueryExpr>(*s.first))
+                diag.e(s.first->tok.pos) << "DISTINCT with nested queries in the SELECT clause is not supported.\n";
+        }
+    }
 }
 
 void Sema::operator()(FromClause &c)
@@ -1340,6 +1353,30 @@ void Sema::operator()(OrderByClause &c)
     SemaContext &Ctx = get_context();
     Ctx.stage = SemaContext::S_OrderBy;
 
+    auto select = cast<const SelectClause>(as<const SelectStmt>(Ctx.stmt).select.get());
+    const bool is_distinct = select and select->distinct;
+
+    /* Returns `true` iff `e` is a result of the SELECT clause, either by itself or by referencing the result. */
+    auto is_result = [&Ctx](const Expr &e) {
+        auto d = cast<const Designator>(&e);
+        for (auto &[_, result] : Ctx.results) {
+            const Expr &res = result.expr();
+            if (&res == &e or res == e)
+                return true;
+            if (not d)
+                continue;
+            if (auto target = std::get_if<const Expr*>(&d->target()); target and *target == &res)
+                return true;
+            if (auto res_d = cast<const Designator>(&res)) {
+                auto attr = std::get_if<const Attribute*>(&d->target());
+                auto res_attr = std::get_if<const Attribute*>(&res_d->target());
+                if (attr and res_attr and *attr == *res_attr)
+                    return true;
+            }
+        }
+        return false;
+    };
+
     /* Analyze all ordering expressions. */
     for (auto &o : c.order_by) {
         auto &e = o.first;
@@ -1360,6 +1397,11 @@ void Sema::operator()(OrderByClause &c)
             if (pt->is_scalar())
                 diag.e(c.tok.pos) << "Cannot order by " << *e << ", expression must be vectorial.\n";
         }
+
+        /* If we eliminated duplicates, only the results of the SELECT clause remain. */
+        if (is_distinct and not is_result(*e))
+            diag.e(e->tok.pos) << "Cannot order by " << *e << ", expression must appear in the SELECT clause of a "
+                                  "SELECT DISTINCT.\n";
     }
 }
 
@@ -1573,6 +1615,23 @@ void Sema::operator()(CreateTableStmt &s)
         }
     }
 
+    /* Analyze the sort key. */
+    for (auto it = s.sort_key.cbegin(); it != s.sort_key.cend(); ++it) {
+        auto &name = it->first;
+        auto attribute_name = name.text.assert_not_none();
+        if (not T->has_attribute(attribute_name)) {
+            diag.e(name.pos) << "Sort key attribute " << name.text << " not found in table " << table_name << ".\n";
+            continue;
+        }
+        auto is_same = [&](const CreateTableStmt::sort_key_field &f) { return f.first.text == name.text; };
+        if (std::any_of(s.sort_key.cbegin(), it, is_same)) {
+            diag.e(name.pos) << "Attribute " << name.text << " occurs multiple times in the sort key of table "
+                             << table_name << ".\n";
+            continue;
+        }
+        T->add_sort_key(attribute_name, it->second);
+    }
+
     if (not is_nested() and not diag.num_errors())
         command_ = std::make_unique<CreateTable>(std::move(T));
 }
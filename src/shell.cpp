@@ -10,7 +10,9 @@
 #include <mutable/catalog/CostModel.hpp>
 #include <mutable/mutable.hpp>
 #include <mutable/Options.hpp>
+#include <mutable/util/PerfCounters.hpp>
 #include <mutable/util/terminal.hpp>
+#include <mutable/util/Tracer.hpp>
 #include <regex>
 #include <replxx.hxx>
 #include <vector>
@@ -265,6 +267,15 @@ int main(int argc, const char **argv)
         "-t", "--times",                                    /* Short, Long      */
         "report exact timings",                             /* Description      */
         [&](bool) { Options::Get().times = true; });        /* Callback         */
+    ADD(bool, Options::Get().perf_counters, false,                                  /* Type, Var, Init  */
+        nullptr, "--perf-counters",                                                 /* Short, Long      */
+        "record hardware performance counters of the query thread with every timing (see --times); "
+        "worker threads, e.g. of SPN learning or --hs-threads, are not counted",   /* Description      */
+        [&](bool) { Options::Get().perf_counters = true; });                        /* Callback         */
+    ADD(const char*, Options::Get().trace_file, nullptr,                            /* Type, Var, Init  */
+        nullptr, "--trace",                                                         /* Short, Long      */
+        "write the phases of all queries as Chrome trace to the file",              /* Description      */
+        [&](const char *str) { Options::Get().trace_file = str; });                 /* Callback         */
     ADD(bool, Options::Get().statistics, false,             /* Type, Var, Init  */
         "-s", "--statistics",                               /* Short, Long      */
         "show some statistics",                             /* Description      */
@@ -305,6 +316,10 @@ int main(int argc, const char **argv)
         nullptr, "--physplan",                              /* Short, Long      */
         "emit the chosen physical execution covering",      /* Description      */
         [&](bool) { Options::Get().physplan = true; });     /* Callback         */
+    ADD(bool, Options::Get().explain_analyze, false,                                 /* Type, Var, Init  */
+        nullptr, "--explain-analyze",                                                /* Short, Long      */
+        "execute and emit the physical execution covering with runtime statistics",  /* Description      */
+        [&](bool) { Options::Get().explain_analyze = true; });                       /* Callback         */
     ADD(bool, Options::Get().dryrun, false,                 /* Type, Var, Init  */
         nullptr, "--dryrun",                                /* Short, Long      */
         "don't actually execute the query",                 /* Description      */
@@ -539,6 +554,20 @@ Immanuel Haffner\
     /* Create the diagnostics object. */
     Diagnostic diag(Options::Get().has_color, std::cout, std::cerr);
 
+    /* Record hardware performance counters with every timing. */
+    if (Options::Get().perf_counters) {
+        if (not PerfCounters::Get().any_available())
+            std::cerr << "warning: hardware performance counters are unavailable, "
+                         "check /proc/sys/kernel/perf_event_paranoid" << std::endl;
+        C.timer().perf_counters(true);
+    }
+
+    /* Record the phases of all queries as spans. */
+    if (Options::Get().trace_file) {
+        Tracer::Get().enabled(true);
+        Tracer::Get().name_thread("main");
+    }
+
     /* ----- Cost model training -------------------------------------------------------------------------------------*/
     if (Options::Get().train_cost_models) {
         auto CF = CostModelFactory::get_cost_function();
@@ -664,5 +693,19 @@ Immanuel Haffner\
     /* Explicitly destroy the `Catalog` to dispose of all held resources.  This is particularly important as the address
      * sanitizer scans for leaked allocations *before* any `__attribute((destructor))__` annotated functions are run. */
     Catalog::Destroy();
+
+    /* Write the trace after destroying the `Catalog` to include the spans of all of its threads. */
+    if (Options::Get().trace_file) {
+        std::ofstream trace(Options::Get().trace_file);
+        if (not trace) {
+            const auto errsv = errno;
+            diag.err() << "Could not open file '" << Options::Get().trace_file << '\'';
+            if (errsv)
+                diag.err() << ": " << strerror(errsv);
+            diag.err() << '.' << std::endl;
+        } else {
+            Tracer::Get().write_chrome_trace(trace);
+        }
+    }
     std::exit(diag.num_errors() ? EXIT_FAILURE : EXIT_SUCCESS);
 }
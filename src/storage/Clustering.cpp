@@ -0,0 +1,263 @@
+#include "storage/Clustering.hpp"
+
+#include "backend/Interpreter.hpp"
+#include "storage/ZoneMap.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/catalog/Type.hpp>
+#include <mutable/IR/Tuple.hpp>
+#include <mutable/storage/DataLayout.hpp>
+#include <mutable/storage/Store.hpp>
+#include <mutable/util/fn.hpp>
+#include <utility>
+#include <vector>
+
+
+using namespace m;
+using namespace m::storage;
+
+
+namespace {
+
+/** Compares the non-NULL values \p left and \p right of type \p type.  Returns a negative number, zero, or a positive
+ * number if \p left is smaller than, equal to, or greater than \p right, respectively. */
+int compare(const Type &type, const Value &left, const Value &right)
+{
+    auto cmp = [](auto l, auto r) -> int { return (l > r) - (l < r); };
+    return visit(overloaded {
+        [&](const Boolean&) { return cmp(left.as_b(), right.as_b()); },
+        [&](const CharacterSequence &cs) {
+            return std::strncmp(reinterpret_cast<const char*>(left.as_p()),
+                                reinterpret_cast<const char*>(right.as_p()), cs.length);
+        },
+        [&](const Numeric &n) {
+            if (n.kind == Numeric::N_Float)
+                return n.size() <= 32 ? cmp(left.as_f(), right.as_f()) : cmp(left.as_d(), right.as_d());
+            return cmp(left.as_i(), right.as_i());
+        },
+        [&](const Date&) { return cmp(left.as_i(), right.as_i()); },
+        [&](const DateTime&) { return cmp(left.as_i(), right.as_i()); },
+        [](auto&&) -> int { M_unreachable("invalid type"); },
+    }, type);
+}
+
+/** Orders rows of a table, given as `Tuple`s of the table's schema, by the table's sort key. */
+struct row_order
+{
+    private:
+    std::vector<std::pair<const Attribute*, bool>> key_; ///< the attributes of the sort key and whether ascending
+
+    public:
+    explicit row_order(const Table &table) {
+        for (auto [attr, ascending] : table.sort_key())
+            key_.emplace_back(&attr.get(), ascending);
+    }
+
+    /** Returns `true` iff row \p left precedes row \p right. */
+    bool operator()(const Tuple &left, const Tuple &right) const {
+        for (auto [attr, ascending] : key_) {
+            const std::size_t idx = attr->id;
+            int cmp;
+            if (left.is_null(idx) or right.is_null(idx))
+                cmp = int(right.is_null(idx)) - int(left.is_null(idx)); // NULL first
+            else
+                cmp = compare(*attr->type, left.get(idx), right.get(idx));
+            if (cmp != 0)
+                return ascending ? cmp < 0 : cmp > 0;
+        }
+        return false;
+    }
+};
+
+/** Loads rows of a table at arbitrary positions with a single loader, compiled for the first row.  Rows at the same
+ * position within their block of the data layout are accessed alike.  Seeking to the first row of another block hence
+ * only shifts the addresses in the context of the loader by a multiple of the block stride, while rows within a block
+ * are reached by advancing the loader row by row. */
+struct row_loader
+{
+    private:
+    StackMachine loader_;
+    std::size_t rows_per_block_; ///< number of rows of a block of the data layout
+    std::vector<Value> first_block_; ///< the context of the loader at the first row
+    std::vector<int64_t> block_stride_; ///< per context value, the shift of an address from one block to the next
+    std::size_t next_row_ = 0; ///< the row that is loaded by the next invocation of the loader
+    Tuple scratch_; ///< a tuple to load skipped rows into
+
+    public:
+    row_loader(const Table &table, const Schema &schema)
+        : loader_(Interpreter::compile_load(schema, table.store().memory().addr(), table.layout(), schema, 0))
+        , scratch_(schema)
+    {
+        auto inode = cast<const DataLayout::INode>(&table.layout().child());
+        rows_per_block_ = inode ? inode->num_tuples() : 1;
+        for (std::size_t i = 0; i != loader_.num_context_values(); ++i)
+            first_block_.push_back(loader_.get(i));
+    }
+
+    std::size_t rows_per_block() const { return rows_per_block_; }
+
+    /** Loads row \p row into \p tuple. */
+    void operator()(std::size_t row, Tuple &tuple) {
+        if (row < next_row_ or row / rows_per_block_ != next_row_ / rows_per_block_)
+            seek_block(row / rows_per_block_);
+        while (next_row_ != row)
+            advance(scratch_);
+        advance(tuple);
+    }
+
+    private:
+    void advance(Tuple &tuple) {
+        Tuple *args[] = { &tuple };
+        loader_(args);
+        ++next_row_;
+    }
+
+    /** Moves the loader to the first row of block \p block. */
+    void seek_block(std::size_t block) {
+        for (std::size_t i = 0; i != first_block_.size(); ++i)
+            loader_.set(i, first_block_[i]);
+        next_row_ = 0;
+        if (block == 0) return;
+
+        if (block_stride_.empty()) {
+            /* Advance through the first block once to learn which context values are addresses and their stride. */
+            while (next_row_ != rows_per_block_)
+                advance(scratch_);
+            for (std::size_t i = 0; i != first_block_.size(); ++i) {
+                const Value v = loader_.get(i);
+                block_stride_.push_back(v == first_block_[i] ? 0 : static_cast<uint8_t*>(v.as_p()) -
+                                                                     static_cast<uint8_t*>(first_block_[i].as_p()));
+            }
+        }
+
+        for (std::size_t i = 0; i != first_block_.size(); ++i) {
+            if (block_stride_[i])
+                loader_.set(i, static_cast<uint8_t*>(first_block_[i].as_p()) + int64_t(block) * block_stride_[i]);
+            else
+                loader_.set(i, first_block_[i]);
+        }
+        next_row_ = block * rows_per_block_;
+    }
+};
+
+}
+
+std::size_t m::storage::merge_appended_rows(const Table &table, std::size_t first_row)
+{
+    auto &store = table.store();
+    const std::size_t num_rows = store.num_rows();
+    if (table.sort_key().empty() or first_row >= num_rows)
+        return num_rows;
+
+    const Schema schema = table.schema();
+    const row_order less(table);
+    row_loader loader(table, schema);
+
+    /*----- Loads the rows from `begin` to `end` of the store. -----*/
+    auto load = [&](std::size_t begin, std::size_t end) {
+        std::vector<Tuple> rows;
+        rows.reserve(end - begin);
+        for (std::size_t row = begin; row != end; ++row)
+            loader(row, rows.emplace_back(schema));
+        return rows;
+    };
+
+    /*----- Sort the appended run. -----*/
+    std::vector<Tuple> rows = load(first_row, num_rows);
+    const bool is_run_sorted = std::is_sorted(rows.begin(), rows.end(), less);
+    if (not is_run_sorted)
+        std::stable_sort(rows.begin(), rows.end(), less);
+
+    /*----- Find the first sorted row that succeeds the smallest appended row.  In the common case of appending in sort
+     * order, e.g. time-ordered data, no sorted row does and only the last sorted row is loaded.  Otherwise, search
+     * the blocks of the data layout by binary search on their first rows, and then the block found row by row, such
+     * that the loader only seeks to the first rows of blocks. -----*/
+    Tuple probe(schema);
+    auto succeeds_first_appended = [&](std::size_t row) { loader(row, probe); return less(rows.front(), probe); };
+    std::size_t first_written = first_row;
+    if (first_row != 0 and succeeds_first_appended(first_row - 1)) {
+        const std::size_t rows_per_block = loader.rows_per_block();
+        std::size_t lo = 0, hi = (first_row - 1) / rows_per_block + 1; // find the first block whose first row succeeds
+        while (lo < hi) {
+            const std::size_t mid = lo + (hi - lo) / 2;
+            if (succeeds_first_appended(mid * rows_per_block))
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+        if (lo != 0) {
+            /* The first row of the preceding block does not succeed.  Search the remaining rows of that block. */
+            first_written = (lo - 1) * rows_per_block + 1;
+            while (not succeeds_first_appended(first_written))
+                ++first_written;
+        } else {
+            first_written = 0;
+        }
+
+        /* Merge the sorted rows succeeding the smallest appended row with the appended run.  Rows that compare equal
+         * keep their relative order, i.e. sorted rows precede appended rows. */
+        std::vector<Tuple> merged = load(first_written, first_row);
+        const auto num_sorted = merged.size();
+        merged.reserve(num_sorted + rows.size());
+        std::move(rows.begin(), rows.end(), std::back_inserter(merged));
+        std::inplace_merge(merged.begin(), merged.begin() + num_sorted, merged.end(), less);
+        rows = std::move(merged);
+    } else if (is_run_sorted) {
+        return num_rows; // all rows are already in order
+    }
+
+    /*----- Write the rows back to the store, keeping snapshots of the store unaffected. -----*/
+    store.detach_snapshots(first_written);
+    auto writer = Interpreter::compile_store(schema, store.memory().addr(), table.layout(), schema, first_written);
+    for (auto &row : rows) {
+        Tuple *args[] = { &row };
+        writer(args);
+    }
+    store.zone_map().rows_modified(first_written);
+    return first_written;
+}
+
+std::size_t m::storage::restore_sort_order(const Table &table, std::size_t first_row)
+{
+    auto &store = table.store();
+    const std::size_t num_rows = store.num_rows();
+    if (table.sort_key().empty() or first_row >= num_rows)
+        return num_rows;
+
+    const std::size_t num_sorted = store.num_sorted_rows();
+    M_insist(num_sorted <= first_row, "appended rows cannot be sorted already");
+
+    /*----- If no unsorted rows precede the appended run, check whether the run is in order and succeeds the last
+     * sorted row, e.g. for time-ordered data.  Then, it simply extends the sorted prefix. -----*/
+    if (num_sorted == first_row) {
+        const Schema schema = table.schema();
+        const row_order less(table);
+        row_loader loader(table, schema);
+        Tuple prev(schema), next(schema);
+        bool in_order = true;
+        if (first_row != 0)
+            loader(first_row - 1, prev);
+        for (std::size_t row = first_row; row != num_rows; ++row) {
+            loader(row, next);
+            if (row != 0 and less(next, prev)) {
+                in_order = false;
+                break;
+            }
+            swap(prev, next);
+        }
+        if (in_order) {
+            store.num_sorted_rows(num_rows);
+            return num_rows;
+        }
+    }
+
+    /*----- Keep the unsorted runs until they reach the merge threshold. -----*/
+    if ((num_rows - num_sorted) * MERGE_RATIO < num_sorted)
+        return num_rows;
+
+    const std::size_t first_written = merge_appended_rows(table, num_sorted);
+    store.num_sorted_rows(num_rows);
+    return first_written;
+}
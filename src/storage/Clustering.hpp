@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <mutable/mutable-config.hpp>
+
+
+namespace m {
+
+struct Table;
+
+namespace storage {
+
+/** Restores the order of the rows of \p table by its declared sort key (see `Table::sort_key()`) after rows were
+ * appended.  The rows before \p first_row must already be sorted.  The rows from \p first_row on, i.e. the appended
+ * run, are sorted and then merged into the sorted rows.  NULL is considered smaller than any other value, matching the
+ * order produced by sorting operators.  Only the rows from the first row that changes its position on are written back
+ * to the store, and the zone map of the store is notified of them.
+ *
+ * Returns the ID of the first row written back, or the number of rows of \p table if no row was written back, in
+ * particular if \p table has no sort key. */
+std::size_t M_EXPORT merge_appended_rows(const Table &table, std::size_t first_row);
+
+/** The unsorted rows of a table are merged into its sorted rows once there are at least `1 / MERGE_RATIO` as many
+ * unsorted as sorted rows.  Merging rewrites at most all rows, hence the amortized cost of appending a row is at most
+ * `MERGE_RATIO` row writes. */
+constexpr std::size_t MERGE_RATIO = 8;
+
+/** Maintains the sort order of \p table after the rows from \p first_row on were appended.  The store of \p table is
+ * kept as a sorted prefix of `Store::num_sorted_rows()` rows, followed by the unsorted runs appended since.  Rows
+ * appended in order directly after the sorted prefix extend the prefix.  Otherwise, the appended rows are kept as an
+ * unsorted run until the unsorted rows reach the merge threshold (see `MERGE_RATIO`), at which point they are merged
+ * into the sorted prefix by `merge_appended_rows()`.
+ *
+ * Returns the ID of the first row written back, or the number of rows of \p table if no row was written back. */
+std::size_t M_EXPORT restore_sort_order(const Table &table, std::size_t first_row);
+
+}
+
+}
@@ -4,6 +4,7 @@
 #include <mutable/catalog/Catalog.hpp>
 #include <mutable/catalog/Type.hpp>
 #include <numeric>
+#include <unistd.h>
 
 
 using namespace m;
@@ -175,6 +176,22 @@ DataLayout PAXLayoutFactory::make(std::vector<const Type*> types, std::size_t nu
          * a PAX block must be byte aligned) for every possibly not byte-aligned attribute column. Null bitmap column is
          * ignored since it is the last column. */
         num_rows_per_block = std::max<std::size_t>(1, (num_bytes_ * 8 - num_not_byte_aligned * 7) / row_size_in_bits);
+        if (NBytesAligned == option_) {
+            /* Compute the smallest number of rows for which every column, including the NULL bitmap, fills a whole
+             * number of cache lines.  Since the cache line size is a power of 2, this is the maximum over all columns.
+             * Then, round the number of rows within a PAX block down to a multiple of it.  Since every column now
+             * ends at a cache line boundary, no padding is required.  If not even a single multiple fits into the
+             * block, fall back to the unaligned number of rows. */
+            std::size_t granule = 1;
+            for (auto type : types)
+                granule = std::max<std::size_t>(granule, CACHE_LINE_SIZE_IN_BITS / std::gcd(type->size(),
+                                                                                             CACHE_LINE_SIZE_IN_BITS));
+            if (null_bitmap_size_in_bits)
+                granule = std::max<std::size_t>(granule, CACHE_LINE_SIZE_IN_BITS / std::gcd(null_bitmap_size_in_bits,
+                                                                                             CACHE_LINE_SIZE_IN_BITS));
+            if (const std::size_t num_granules = num_bytes_ * 8 / (granule * row_size_in_bits))
+                num_rows_per_block = num_granules * granule;
+        }
         if (num_rows_per_block > num_simd_lanes)
             num_rows_per_block =
                 (num_rows_per_block / num_simd_lanes) * num_simd_lanes; // floor to multiple of possible number of SIMD lanes
@@ -226,6 +243,26 @@ DataLayout PAXLayoutFactory::make(std::vector<const Type*> types, std::size_t nu
     return layout;
 }
 
+/** Returns the size of the L1 data cache in bytes, or 32 KiB if it cannot be determined. */
+static uint64_t get_L1_cache_size()
+{
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+    if (const long size = sysconf(_SC_LEVEL1_DCACHE_SIZE); size > 0)
+        return size;
+#endif
+    return 1UL << 15;
+}
+
+/** Returns the size of the L2 cache in bytes, or 1 MiB if it cannot be determined. */
+static uint64_t get_L2_cache_size()
+{
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    if (const long size = sysconf(_SC_LEVEL2_CACHE_SIZE); size > 0)
+        return size;
+#endif
+    return 1UL << 20;
+}
+
 __attribute__((constructor(202)))
 static void register_data_layouts()
 {
@@ -239,6 +276,15 @@ static void register_data_layouts()
     REGISTER_PAX_BYTES(PAX64K, 1UL << 16, "stores attributes using PAX layout with 64KiB blocks");
     REGISTER_PAX_BYTES(PAX512K, 1UL << 19, "stores attributes using PAX layout with 512KiB blocks");
     REGISTER_PAX_BYTES(PAX64M, 1UL << 26, "stores attributes using PAX layout with 64MiB blocks");
+    C.register_data_layout(C.pool("PAXL1"),
+                           std::make_unique<PAXLayoutFactory>(PAXLayoutFactory::NBytesAligned, get_L1_cache_size()),
+                           "stores attributes using PAX layout with cache line aligned blocks of the L1 data cache size");
+    C.register_data_layout(C.pool("PAXL2"),
+                           std::make_unique<PAXLayoutFactory>(PAXLayoutFactory::NBytesAligned, get_L2_cache_size()),
+                           "stores attributes using PAX layout with cache line aligned blocks of the L2 cache size");
+    C.register_data_layout(C.pool("PAXHuge"),
+                           std::make_unique<PAXLayoutFactory>(PAXLayoutFactory::NBytesAligned, 1UL << 21),
+                           "stores attributes using PAX layout with cache line aligned blocks of a 2MiB huge page");
     REGISTER_PAX_TUPLES(PAX16Tup, 16, "stores attributes using PAX layout with blocks for 16 tuples");
     REGISTER_PAX_TUPLES(PAX128Tup, 128, "stores attributes using PAX layout with blocks for 128 tuples");
     REGISTER_PAX_TUPLES(PAX1024Tup, 1024, "stores attributes using PAX layout with blocks for 1024 tuples");
@@ -0,0 +1,169 @@
+#include "storage/Dictionary.hpp"
+
+#include "backend/Interpreter.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/storage/Store.hpp>
+
+
+using namespace m;
+using namespace m::storage;
+
+
+namespace {
+
+namespace options {
+
+/** Whether to build dictionaries for attributes of character sequence type when importing data. */
+bool string_dictionaries = false;
+
+}
+
+__attribute__((constructor(201)))
+static void add_dictionary_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<bool>(
+        /* group=       */ "Storage",
+        /* short=       */ nullptr,
+        /* long=        */ "--string-dictionaries",
+        /* description= */ "build order-preserving dictionaries for CHAR and VARCHAR attributes when importing data",
+        /* callback=    */ [](bool){ options::string_dictionaries = true; }
+    );
+}
+
+/** Invokes \p callback with every non-NULL value of attribute \p attr of \p table, starting at row \p first_row. */
+template<typename Callback>
+void for_each_value(const Table &table, const Attribute &attr, std::size_t first_row, Callback &&callback)
+{
+    auto &store = table.store();
+    const std::size_t num_rows = store.num_rows();
+    if (first_row >= num_rows)
+        return;
+
+    const std::size_t length = as<const CharacterSequence>(*attr.type).length;
+    Schema tuple_schema;
+    tuple_schema.add(Schema::Identifier(table.name(), attr.name), attr.type);
+    auto loader = Interpreter::compile_load(tuple_schema, store.memory().addr(), table.layout(), table.schema(),
+                                            first_row);
+    Tuple tup(tuple_schema);
+    Tuple *args[] = { &tup };
+    for (std::size_t row = first_row; row != num_rows; ++row) {
+        loader(args);
+        if (not tup.is_null(0)) {
+            auto str = reinterpret_cast<const char*>(tup.get(0).as_p());
+            callback(std::string_view(str, strnlen(str, length)));
+        }
+        tup.clear();
+    }
+}
+
+}
+
+
+/*======================================================================================================================
+ * Dictionary
+ *====================================================================================================================*/
+
+Dictionary::Dictionary(std::vector<std::string> values)
+    : values_(std::move(values))
+{
+    std::sort(values_.begin(), values_.end());
+    values_.erase(std::unique(values_.begin(), values_.end()), values_.end());
+}
+
+std::unique_ptr<Dictionary> Dictionary::Build(const Table &table, const Attribute &attr)
+{
+    M_insist(attr.type->is_character_sequence(), "dictionaries are only supported for character sequences");
+    std::vector<std::string> values;
+    for_each_value(table, attr, 0, [&](std::string_view value) { values.emplace_back(value); });
+    return std::make_unique<Dictionary>(std::move(values));
+}
+
+std::vector<Dictionary::code_type> Dictionary::extend(std::vector<std::string> values)
+{
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    values.erase(std::remove_if(values.begin(), values.end(), [this](const std::string &value) {
+        return encode(value).has_value();
+    }), values.end());
+
+    std::vector<code_type> shift;
+    shift.reserve(size() + 1);
+    for (auto &value : values_)
+        shift.push_back(std::lower_bound(values.begin(), values.end(), value) - values.begin());
+    shift.push_back(values.size());
+
+    if (not values.empty()) {
+        std::vector<std::string> merged;
+        merged.reserve(size() + values.size());
+        std::merge(std::make_move_iterator(values_.begin()), std::make_move_iterator(values_.end()),
+                   std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()),
+                   std::back_inserter(merged));
+        values_ = std::move(merged);
+    }
+    return shift;
+}
+
+std::optional<Dictionary::code_type> Dictionary::encode(std::string_view value) const
+{
+    const code_type code = lower_bound(value);
+    if (code != size() and values_[code] == value)
+        return code;
+    return std::nullopt;
+}
+
+Dictionary::code_type Dictionary::lower_bound(std::string_view value) const
+{
+    return std::lower_bound(values_.begin(), values_.end(), value) - values_.begin();
+}
+
+Dictionary::code_type Dictionary::upper_bound(std::string_view value) const
+{
+    return std::upper_bound(values_.begin(), values_.end(), value) - values_.begin();
+}
+
+M_LCOV_EXCL_START
+void Dictionary::dump(std::ostream &out) const
+{
+    out << "Dictionary with " << size() << " values" << std::endl;
+}
+void Dictionary::dump() const { dump(std::cerr); }
+M_LCOV_EXCL_STOP
+
+
+/*======================================================================================================================
+ * Maintenance
+ *====================================================================================================================*/
+
+bool m::storage::maintain_dictionaries(const Table &table, std::size_t first_row)
+{
+    auto &store = table.store();
+    bool changed = false;
+    for (auto &attr : table) {
+        if (not attr.type->is_character_sequence())
+            continue;
+        if (auto dict = store.dictionary(attr.id)) {
+            /* Collect the appended values missing in the dictionary and extend it by all of them at once. */
+            std::vector<std::string> missing;
+            for_each_value(table, attr, first_row, [&](std::string_view value) {
+                if (not dict->encode(value))
+                    missing.emplace_back(value);
+            });
+            if (missing.empty())
+                continue;
+            store.extend_dictionary(attr.id, std::move(missing));
+        } else if (options::string_dictionaries) {
+            store.dictionary(attr.id, Dictionary::Build(table, attr));
+        } else {
+            continue;
+        }
+        changed = true;
+    }
+    return changed;
+}
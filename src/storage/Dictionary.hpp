@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutable/mutable-config.hpp>
+#include <mutable/util/macro.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace m {
+
+struct Attribute;
+struct Table;
+
+namespace storage {
+
+/** An order-preserving dictionary of the distinct values of a single `CHAR` or `VARCHAR` column.  The values are
+ * assigned dense integer *codes* in ascending lexicographical order of their characters, compared as `unsigned char`,
+ * such that comparing the codes of two values of the dictionary is equivalent to comparing the values themselves.
+ * Hence, equality and range predicates on the column can be evaluated on codes, after translating the constant of the
+ * predicate to a code by `encode()`, `lower_bound()`, or `upper_bound()`.
+ *
+ * Dictionaries are owned by the store of their table, see `Store::dictionary()`, and maintained by
+ * `maintain_dictionaries()`.  Since codes are dense, extending a dictionary by a value assigns new codes to all greater
+ * values. */
+struct M_EXPORT Dictionary
+{
+    using code_type = uint32_t;
+
+    private:
+    std::vector<std::string> values_; ///< the distinct values in ascending order; the code of a value is its index
+
+    public:
+    /** Creates a dictionary of the values in \p values, which may be unsorted and contain duplicates. */
+    explicit Dictionary(std::vector<std::string> values);
+    Dictionary(const Dictionary&) = delete;
+
+    /** Creates a dictionary of the non-NULL values of attribute \p attr of \p table, as currently stored in the store
+     * of \p table. */
+    static std::unique_ptr<Dictionary> Build(const Table &table, const Attribute &attr);
+
+    /** Returns the number of distinct values, i.e. codes. */
+    std::size_t size() const { return values_.size(); }
+
+    /** Adds the values in \p values, which may be unsorted and contain duplicates or values already contained, to
+     * this dictionary.  Returns a vector `shift` with `shift[k]` being the number of added values smaller than the
+     * value of code `k`, such that the value of code `k` has code `k + shift[k]` after the extension.  The vector has
+     * one more entry than the dictionary had codes, holding the number of added values. */
+    std::vector<code_type> extend(std::vector<std::string> values);
+
+    /** Returns the code of \p value, or `std::nullopt` if \p value is not contained in this dictionary. */
+    std::optional<code_type> encode(std::string_view value) const;
+    /** Returns the code of the first value that is not smaller than \p value, or `size()` if there is none. */
+    code_type lower_bound(std::string_view value) const;
+    /** Returns the code of the first value that is greater than \p value, or `size()` if there is none. */
+    code_type upper_bound(std::string_view value) const;
+
+    /** Returns the value of \p code. */
+    const std::string & decode(code_type code) const {
+        M_insist(code < size(), "code out of bounds");
+        return values_[code];
+    }
+
+    void dump(std::ostream &out) const;
+    void dump() const;
+};
+
+/** Maintains the dictionaries of the store of \p table after rows were appended, starting at row \p first_row, and
+ * must be called before the appended rows are moved, e.g. by `merge_appended_rows()`.  Extends every dictionary by the
+ * values of the appended rows it lacks, reading only the appended rows.  If enabled by the CLI option
+ * `--string-dictionaries`, additionally builds a dictionary for every attribute of character sequence type without
+ * one, such that importing data into a table builds its dictionaries.  Returns `true` iff any dictionary was built
+ * or extended. */
+bool M_EXPORT maintain_dictionaries(const Table &table, std::size_t first_row);
+
+}
+
+}
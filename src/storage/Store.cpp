@@ -1,15 +1,131 @@
 #include "storage/Store.hpp"
 
+#include "storage/Dictionary.hpp"
+#include "storage/ZoneMap.hpp"
+#include <algorithm>
 #include <cmath>
+#include <mutable/catalog/Schema.hpp>
+#include <mutable/util/fn.hpp>
 
 
 using namespace m;
+using namespace m::storage;
+
+
+namespace {
+
+/** Returns the number of bytes of the memory of \p store occupied by the first \p num_rows rows, i.e. by all instances
+ * of the store's layout containing these rows, rounded up to whole pages. */
+std::size_t bytes_of_rows(const Store &store, std::size_t num_rows)
+{
+    auto &layout = store.table().layout();
+    const std::size_t num_rows_per_instance = layout.child().num_tuples();
+    const std::size_t num_instances = (num_rows + num_rows_per_instance - 1) / num_rows_per_instance;
+    return Ceil_To_Next_Page(num_instances * (layout.stride_in_bits() / 8U));
+}
+
+}
+
+
+/*======================================================================================================================
+ * Snapshot
+ *====================================================================================================================*/
+
+Snapshot::Snapshot(const Store &store, std::size_t num_rows, std::size_t size, std::optional<memory::AddressSpace> vm,
+                   void *addr)
+    : store_(store)
+    , vm_(std::move(vm))
+    , addr_(addr)
+    , size_(size)
+    , num_rows_(num_rows)
+{
+    std::lock_guard<std::mutex> lock(store_.snapshots_mutex_);
+    store_.snapshots_.push_back(this);
+}
+
+Snapshot::~Snapshot()
+{
+    std::lock_guard<std::mutex> lock(store_.snapshots_mutex_);
+    auto it = std::find(store_.snapshots_.begin(), store_.snapshots_.end(), this);
+    M_insist(it != store_.snapshots_.end(), "snapshot not registered at its store");
+    store_.snapshots_.erase(it);
+}
+
+void Snapshot::detach(std::size_t offset, std::size_t size)
+{
+    M_insist(Is_Page_Aligned(offset));
+    if (offset >= size_)
+        return;
+    memory::make_private(static_cast<uint8_t*>(addr_) + offset, std::min(size, size_ - offset));
+}
 
 
 /*======================================================================================================================
  * Store
  *====================================================================================================================*/
 
+Store::Store(const Table &table)
+    : table_(table)
+    , zone_map_(std::make_unique<storage::ZoneMap>(*this))
+{ }
+
+Store::~Store()
+{
+    M_insist(snapshots_.empty(), "store must not be destroyed while snapshots of it are alive");
+}
+
+std::unique_ptr<Snapshot> Store::snapshot() const
+{
+    const std::size_t num_rows = this->num_rows();
+    const std::size_t size = bytes_of_rows(*this, num_rows);
+    memory::AddressSpace vm(std::max(size, get_pagesize())); // reserve at least one page
+    if (size)
+        memory().map_private(size, 0, vm, 0);
+    void *addr = vm.addr();
+    return std::unique_ptr<Snapshot>(new Snapshot(*this, num_rows, size, std::move(vm), addr));
+}
+
+std::unique_ptr<Snapshot> Store::snapshot(const memory::AddressSpace &vm, std::size_t offset) const
+{
+    const std::size_t num_rows = this->num_rows();
+    const std::size_t size = bytes_of_rows(*this, num_rows);
+    if (size)
+        memory().map_private(size, 0, vm, offset);
+    return std::unique_ptr<Snapshot>(
+        new Snapshot(*this, num_rows, size, std::nullopt, vm.as<uint8_t*>() + offset)
+    );
+}
+
+void Store::detach_snapshots(std::size_t first_row) const
+{
+    std::lock_guard<std::mutex> lock(snapshots_mutex_);
+    if (snapshots_.empty())
+        return;
+    /* Detach from the page containing the first byte of the layout instance that contains `first_row`. */
+    auto &layout = table().layout();
+    const std::size_t first_instance = first_row / layout.child().num_tuples();
+    const std::size_t offset = (first_instance * (layout.stride_in_bits() / 8U)) & ~(get_pagesize() - 1UL);
+    for (auto snapshot : snapshots_)
+        snapshot->detach(offset, snapshot->size());
+}
+
+void Store::dictionary(std::size_t attr_id, std::unique_ptr<storage::Dictionary> dictionary)
+{
+    if (dictionary)
+        dictionaries_[attr_id] = std::move(dictionary);
+    else
+        dictionaries_.erase(attr_id);
+    zone_map_->invalidate();
+}
+
+void Store::extend_dictionary(std::size_t attr_id, std::vector<std::string> values)
+{
+    auto it = dictionaries_.find(attr_id);
+    M_insist(it != dictionaries_.end(), "attribute has no dictionary");
+    const auto shift = it->second->extend(std::move(values));
+    zone_map_->dictionary_extended(*it->second, shift);
+}
+
 M_LCOV_EXCL_START
 void Store::dump() const { dump(std::cerr); }
 M_LCOV_EXCL_STOP
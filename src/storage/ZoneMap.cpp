@@ -0,0 +1,323 @@
+#include "storage/ZoneMap.hpp"
+
+#include "backend/Interpreter.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/parse/AST.hpp>
+#include <mutable/storage/Store.hpp>
+#include <mutable/util/fn.hpp>
+#include <optional>
+#include <string_view>
+
+
+using namespace m;
+using namespace m::ast;
+using namespace m::storage;
+
+
+namespace {
+
+namespace options {
+
+/** The maximum number of rows per zone. */
+std::size_t zone_size = 1024;
+
+}
+
+__attribute__((constructor(201)))
+static void add_zone_map_args()
+{
+    Catalog &C = Catalog::Get();
+
+    /*----- Command-line arguments -----*/
+    C.arg_parser().add<std::size_t>(
+        /* group=       */ "Storage",
+        /* short=       */ nullptr,
+        /* long=        */ "--zone-size",
+        /* description= */ "the maximum number of rows per zone of a zone map (0 to disable zone maps)",
+        /* callback=    */ [](std::size_t size){ options::zone_size = size; }
+    );
+}
+
+/** Returns `true` iff the zone map summarizes attributes of type \p type. */
+bool is_summarizable(const Type &type)
+{
+    return type.is_integral() or type.is_floating_point() or type.is_date() or type.is_date_time() or
+           type.is_character_sequence();
+}
+
+/** Returns the comparison equivalent to the comparison \p tok with swapped operands, e.g. `>` for `<`. */
+TokenType mirror(TokenType tok)
+{
+    switch (tok) {
+        default:                return tok;
+        case TK_LESS:           return TK_GREATER;
+        case TK_LESS_EQUAL:     return TK_GREATER_EQUAL;
+        case TK_GREATER:        return TK_LESS;
+        case TK_GREATER_EQUAL:  return TK_LESS_EQUAL;
+    }
+}
+
+/** Returns the comparison equivalent to the negation of comparison \p tok, e.g. `>=` for `<`.  Negating a comparison
+ * involving NULL yields NULL, just as the negated comparison does, hence this is sound for zones with NULL values. */
+TokenType negate(TokenType tok)
+{
+    switch (tok) {
+        default:                return TK_EOF;
+        case TK_EQUAL:          return TK_BANG_EQUAL;
+        case TK_BANG_EQUAL:     return TK_EQUAL;
+        case TK_LESS:           return TK_GREATER_EQUAL;
+        case TK_LESS_EQUAL:     return TK_GREATER;
+        case TK_GREATER:        return TK_LESS_EQUAL;
+        case TK_GREATER_EQUAL:  return TK_LESS;
+    }
+}
+
+/** Returns `true` iff some value in the range from \p min to \p max may satisfy the comparison \p tok with \p c. */
+template<typename T>
+bool may_compare(TokenType tok, T min, T max, T c)
+{
+    switch (tok) {
+        default:                return true;
+        case TK_EQUAL:          return min <= c and c <= max;
+        case TK_BANG_EQUAL:     return not (min == c and max == c);
+        case TK_LESS:           return min < c;
+        case TK_LESS_EQUAL:     return min <= c;
+        case TK_GREATER:        return max > c;
+        case TK_GREATER_EQUAL:  return max >= c;
+    }
+}
+
+}
+
+
+std::size_t ZoneMap::zone_size() const
+{
+    auto &layout = store_.table().layout();
+    if (not layout)
+        return 0;
+    if (auto block = cast<const DataLayout::INode>(&layout.child()); block and block->num_tuples() > 1)
+        return std::min<std::size_t>(block->num_tuples(), options::zone_size);
+    return options::zone_size;
+}
+
+void ZoneMap::update()
+{
+    auto &table = store_.table();
+    const Schema schema = table.schema();
+
+    /*----- Recompute all zones if the layout changed or the zone map was invalidated. -----*/
+    if (const std::size_t zone_size = this->zone_size(); zone_size != zone_size_) {
+        zone_size_ = zone_size;
+        num_rows_ = 0;
+        summaries_.clear();
+        columns_.clear();
+        for (auto &e : schema) {
+            if (is_summarizable(*e.type))
+                columns_.push_back({ e.id.name, e.type });
+        }
+    }
+    if (zone_size_ == 0 or columns_.empty())
+        return;
+
+    /*----- Resummarize the last zone if it was not completely summarized or if rows were dropped from it. -----*/
+    const std::size_t num_rows = store_.num_rows();
+    if (num_rows == num_rows_)
+        return;
+    const std::size_t first_zone = std::min(num_rows, num_rows_) / zone_size_;
+    const std::size_t first_row = first_zone * zone_size_;
+    summaries_.resize(first_zone * columns_.size());
+
+    /*----- Load the summarized attributes of all rows not yet summarized. -----*/
+    Schema tuple_schema;
+    for (auto &column : columns_)
+        tuple_schema.add(Schema::Identifier(table.name(), column.name), column.type);
+    auto loader = Interpreter::compile_load(tuple_schema, store_.memory().addr(), table.layout(), schema, first_row);
+    Tuple tup(tuple_schema);
+    Tuple *args[] = { &tup };
+
+    for (std::size_t row = first_row; row != num_rows; ++row) {
+        if (row % zone_size_ == 0) { // start a new zone
+            for (auto &column : columns_) {
+                summary_type &s = summaries_.emplace_back();
+                s.num_nulls = 0;
+                if (column.type->is_floating_point()) {
+                    s.min.d = std::numeric_limits<double>::infinity();
+                    s.max.d = -std::numeric_limits<double>::infinity();
+                } else {
+                    s.min.i = std::numeric_limits<int64_t>::max();
+                    s.max.i = std::numeric_limits<int64_t>::min();
+                }
+            }
+        }
+
+        loader(args);
+        const std::size_t zone = row / zone_size_;
+        for (std::size_t idx = 0; idx != columns_.size(); ++idx) {
+            summary_type &s = summary(zone, idx);
+            if (tup.is_null(idx)) {
+                ++s.num_nulls;
+            } else if (auto cs = cast<const CharacterSequence>(columns_[idx].type)) {
+                auto str = reinterpret_cast<const char*>(tup.get(idx).as_p());
+                const std::string_view value(str, strnlen(str, cs->length));
+                if (s.num_nulls == row % zone_size_) { // first non-NULL value of the zone
+                    s.min_str = s.max_str = value;
+                } else if (value < s.min_str) {
+                    s.min_str = value;
+                } else if (value > s.max_str) {
+                    s.max_str = value;
+                }
+            } else if (columns_[idx].type->is_floating_point()) {
+                const double d = columns_[idx].type->is_float() ? tup.get(idx).as_f() : tup.get(idx).as_d();
+                s.min.d = std::min(s.min.d, d);
+                s.max.d = std::max(s.max.d, d);
+            } else {
+                const int64_t i = tup.get(idx).as_i();
+                s.min.i = std::min(s.min.i, i);
+                s.max.i = std::max(s.max.i, i);
+            }
+        }
+        tup.clear();
+    }
+    num_rows_ = num_rows;
+}
+
+void ZoneMap::rows_appended()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    update();
+}
+
+std::vector<ZoneMap::range_type> ZoneMap::qualifying_ranges(const cnf::CNF &cnf)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    update();
+
+    const std::size_t num_rows = store_.num_rows();
+    if (zone_size_ == 0 or columns_.empty())
+        return { { 0, num_rows } };
+
+    std::vector<range_type> ranges;
+    for (std::size_t zone = 0, num_zones = (num_rows + zone_size_ - 1) / zone_size_; zone != num_zones; ++zone) {
+        if (not may_satisfy(zone, cnf))
+            continue;
+        const std::size_t begin = zone * zone_size_;
+        const std::size_t end = std::min(begin + zone_size_, num_rows);
+        if (not ranges.empty() and ranges.back().second == begin)
+            ranges.back().second = end; // extend range of previous zone
+        else
+            ranges.emplace_back(begin, end);
+    }
+    return ranges;
+}
+
+bool ZoneMap::may_satisfy(std::size_t zone, const cnf::CNF &cnf) const
+{
+    return std::all_of(cnf.cbegin(), cnf.cend(), [&](const cnf::Clause &clause) {
+        return std::any_of(clause.cbegin(), clause.cend(), [&](const cnf::Predicate &pred) {
+            return may_satisfy(zone, pred);
+        });
+    });
+}
+
+bool ZoneMap::may_satisfy(std::size_t zone, const cnf::Predicate &pred) const
+{
+    /*----- Returns the index of the summarized column referenced by `expr`, if any. -----*/
+    auto find_column = [this](const Expr &expr) -> std::optional<std::size_t> {
+        auto d = cast<const Designator>(&expr);
+        if (not d)
+            return std::nullopt;
+        auto attr = std::get_if<const Attribute*>(&d->target());
+        if (not attr or (*attr)->table.name() != store_.table().name())
+            return std::nullopt;
+        for (std::size_t idx = 0; idx != columns_.size(); ++idx) {
+            if (columns_[idx].name == (*attr)->name)
+                return idx;
+        }
+        return std::nullopt;
+    };
+
+    /*----- Handle `ISNULL(x)` by the number of NULL values. -----*/
+    if (auto fn = cast<const FnApplicationExpr>(&pred.expr());
+        fn and fn->has_function() and fn->get_function().fnid == Function::FN_ISNULL)
+    {
+        M_insist(fn->args.size() == 1);
+        auto column = find_column(*fn->args[0]);
+        if (not column)
+            return true;
+        const uint32_t num_nulls = summary(zone, *column).num_nulls;
+        return pred.negative() ? num_nulls != num_rows_in_zone(zone) : num_nulls != 0;
+    }
+
+    /*----- Handle comparisons of an attribute with a constant by the minimum and maximum value. -----*/
+    auto binary = cast<const BinaryExpr>(&pred.expr());
+    if (not binary)
+        return true;
+    const bool has_attribute_left = is<const Designator>(binary->lhs);
+    auto column = find_column(has_attribute_left ? *binary->lhs : *binary->rhs);
+    if (not column)
+        return true;
+
+    /* Extract the constant, possibly preceded by an unary minus or plus. */
+    const Expr *bound = has_attribute_left ? binary->rhs.get() : binary->lhs.get();
+    bool is_negative = false;
+    if (auto u = cast<const UnaryExpr>(bound); u and (u->op().type == TK_MINUS or u->op().type == TK_PLUS)) {
+        is_negative = u->op().type == TK_MINUS;
+        bound = u->expr.get();
+    }
+    auto constant = cast<const Constant>(bound);
+    if (not constant)
+        return true;
+
+    /* Normalize the comparison to the form `attribute <op> constant`. */
+    TokenType tok = binary->tok.type;
+    if (not has_attribute_left)
+        tok = mirror(tok);
+    if (pred.negative())
+        tok = negate(tok);
+
+    const column_type &col = columns_[*column];
+    const summary_type &s = summary(zone, *column);
+    const bool is_integral_constant = constant->tok.type == TK_DEC_INT or constant->tok.type == TK_OCT_INT or
+                                      constant->tok.type == TK_HEX_INT;
+    if (col.type->is_character_sequence()) {
+        if (constant->tok.type != TK_STRING_LITERAL or is_negative)
+            return true;
+        const std::string c = interpret(*constant->tok.text);
+        return s.num_nulls != num_rows_in_zone(zone) and
+               may_compare<std::string_view>(tok, s.min_str, s.max_str, c);
+    } else if (col.type->is_floating_point()) {
+        if (not is_integral_constant and constant->tok.type != TK_DEC_FLOAT)
+            return true;
+        const Value v = Interpreter::eval(*constant);
+        double c = is_integral_constant ? double(v.as_i()) : v.as_d();
+        if (is_negative) c = -c;
+        return s.min.d <= s.max.d and may_compare(tok, s.min.d, s.max.d, c);
+    } else {
+        if (col.type->is_integral() ? not is_integral_constant
+                                    : constant->tok.type != (col.type->is_date() ? TK_DATE : TK_DATE_TIME))
+            return true;
+        if (is_negative and not col.type->is_integral())
+            return true;
+        const Value v = Interpreter::eval(*constant);
+        const int64_t c = is_negative ? -v.as_i() : v.as_i();
+        return s.min.i <= s.max.i and may_compare(tok, s.min.i, s.max.i, c);
+    }
+}
+
+M_LCOV_EXCL_START
+void ZoneMap::dump(std::ostream &out) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    out << "ZoneMap for table \"" << store_.table().name() << "\": " << num_rows_ << " rows, " << zone_size_
+        << " rows per zone, attributes [";
+    for (auto it = columns_.cbegin(); it != columns_.cend(); ++it) {
+        if (it != columns_.cbegin()) out << ", ";
+        out << it->name;
+    }
+    out << ']' << std::endl;
+}
+void ZoneMap::dump() const { dump(std::cerr); }
+M_LCOV_EXCL_STOP
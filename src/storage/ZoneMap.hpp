@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <mutable/IR/CNF.hpp>
+#include <mutable/util/macro.hpp>
+#include <mutable/util/Pool.hpp>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace m {
+
+struct Store;
+struct Type;
+
+namespace storage {
+
+/** A `ZoneMap` summarizes the rows of a `Store` in *zones*, i.e. ranges of consecutive rows.  For a PAX layout, a zone
+ * spans one block of the layout.  For layouts without blocks of multiple rows, e.g. row layouts, and for blocks larger
+ * than the CLI option `--zone-size`, a zone spans that many rows.  For every zone and every attribute of integral,
+ * floating-point, date, datetime, or character sequence type, the zone map records the minimum and the maximum value
+ * and the number of NULL values.  Scans use the zone map to skip entire zones that cannot contain a row satisfying a
+ * filter condition.
+ *
+ * Since `Store::append()` does not see the values of a row, statements appending rows report them by
+ * `rows_appended()`.  Rows appended otherwise are summarized lazily on the next use of the zone map.  Rows modified in
+ * place require an explicit `invalidate()`. */
+struct M_EXPORT ZoneMap
+{
+    /** A half-open range `[first, second)` of row IDs. */
+    using range_type = std::pair<std::size_t, std::size_t>;
+
+    private:
+    /** The minimum or the maximum value of an attribute within a zone. */
+    union bound_type
+    {
+        int64_t i;
+        double d;
+    };
+
+    /** The summary of a single attribute within a single zone.  For a zone without any non-NULL value of the
+     * attribute, `min` is greater than `max`.  Attributes of character sequence type are summarized by `min_str` and
+     * `max_str` instead, which are only valid if the zone has a non-NULL value of the attribute. */
+    struct summary_type
+    {
+        bound_type min;
+        bound_type max;
+        uint32_t num_nulls;
+        std::string min_str;
+        std::string max_str;
+    };
+
+    /** An attribute that is summarized by this zone map. */
+    struct column_type
+    {
+        ThreadSafePooledString name; ///< the name of the attribute
+        const Type *type; ///< the type of the attribute; bounds of floating-point types are stored as `double`
+    };
+
+    const Store &store_; ///< the summarized store
+    mutable std::mutex mutex_; ///< protects all following fields
+    std::vector<column_type> columns_; ///< the summarized attributes
+    std::size_t zone_size_ = 0; ///< the number of rows per zone; 0 iff the zones must be recomputed
+    std::size_t num_rows_ = 0; ///< the number of rows summarized
+    std::vector<summary_type> summaries_; ///< the summaries in zone-major order
+
+    public:
+    explicit ZoneMap(const Store &store) : store_(store) { }
+    ZoneMap(const ZoneMap&) = delete;
+
+    /** Returns the number of rows per zone for the current data layout of the store's table, or 0 if zone maps are
+     * disabled. */
+    std::size_t zone_size() const;
+
+    /** Summarizes the rows appended to the store since the last update of the zone map. */
+    void rows_appended();
+
+    /** Returns the ranges of rows of the store that may contain a row satisfying \p cnf, in ascending order.  Adjacent
+     * qualifying zones are merged into a single range.  The zone map is brought up to date with the store first, such
+     * that the ranges cover all rows of the store. */
+    std::vector<range_type> qualifying_ranges(const cnf::CNF &cnf);
+
+    /** Discards the summaries of all zones with rows from \p first_row on, e.g. after these rows were modified in
+     * place. */
+    void rows_modified(std::size_t first_row) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        num_rows_ = std::min(num_rows_, first_row);
+    }
+
+    /** Discards all summaries, e.g. after rows of the store were modified in place. */
+    void invalidate() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        zone_size_ = 0;
+    }
+
+    void dump(std::ostream &out) const;
+    void dump() const;
+
+    private:
+    /** Brings the summaries up to date with the rows of the store.  Must be called with `mutex_` held. */
+    void update();
+
+    /** Returns `true` iff zone \p zone may contain a row satisfying \p cnf. */
+    bool may_satisfy(std::size_t zone, const cnf::CNF &cnf) const;
+    /** Returns `true` iff zone \p zone may contain a row satisfying \p pred. */
+    bool may_satisfy(std::size_t zone, const cnf::Predicate &pred) const;
+
+    /** Returns the number of rows of zone \p zone. */
+    std::size_t num_rows_in_zone(std::size_t zone) const { return std::min(zone_size_, num_rows_ - zone * zone_size_); }
+
+    const summary_type & summary(std::size_t zone, std::size_t column) const {
+        return summaries_[zone * columns_.size() + column];
+    }
+    summary_type & summary(std::size_t zone, std::size_t column) {
+        return summaries_[zone * columns_.size() + column];
+    }
+};
+
+}
+
+}
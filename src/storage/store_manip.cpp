@@ -3,13 +3,17 @@
 #include "storage/ColumnStore.hpp"
 #include "util/datagen.hpp"
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstring>
 #include <limits>
+#include <mutable/catalog/Catalog.hpp>
 #include <mutable/catalog/Schema.hpp>
 #include <mutable/Options.hpp>
+#include <mutable/storage/DataLayoutFactory.hpp>
 #include <mutable/util/fn.hpp>
 #include <random>
+#include <thread>
 #include <unordered_set>
 
 
@@ -160,6 +164,168 @@ exit_right:
     }
 }
 
+/** Returns the offset in bytes of the `idx`-th column in the `DataLayout` `layout` which is considered to represent a
+ * **PAX**-layout with a single block. */
+uint64_t get_column_offset_in_bytes(const storage::DataLayout &layout, std::size_t idx)
+{
+    auto &child = as<const storage::DataLayout::INode>(layout.child()).at(idx);
+    M_insist(as<const storage::DataLayout::Leaf>(child.ptr.get())->index() == idx,
+             "index of entry must match index in leaf");
+    M_insist(child.offset_in_bits % 8 == 0, "column must be byte-aligned");
+    return child.offset_in_bits / 8;
+}
+
+/** Number of rows generated at once by a single thread.  Must be a multiple of 8 such that no two chunks share a byte
+ * of the NULL bitmap.  Each chunk has its own PRNG, seeded by the chunk's index, which makes the generated data
+ * independent of the number of threads. */
+constexpr std::size_t CHUNK_SIZE = 1UL << 16;
+static_assert(CHUNK_SIZE % 8 == 0);
+
+/** A foreign key column of a table to generate. */
+struct foreign_key_info
+{
+    void *column_ptr;
+    const Type *type;
+    datagen::zipf_distribution<int64_t> dist;
+};
+
+/** Fills the `begin`-th row (including) to the `end`-th row (excluding) of the table described by `spec`. */
+void generate_chunk(const table_spec &spec, const storage::DataLayout &layout, uint8_t *mem_ptr,
+                    const Attribute &id, const std::vector<foreign_key_info> &fks, std::size_t first_attr,
+                    std::size_t num_all_attrs, uint64_t seed, std::size_t begin, std::size_t end)
+{
+    std::mt19937_64 g(seed);
+
+    /* Clear the NULL bitmap of this chunk.  The bytes are not shared with any other chunk. */
+    uint8_t *null_bitmap = mem_ptr + get_column_offset_in_bytes(layout, num_all_attrs);
+    const auto begin_byte = (begin * num_all_attrs) / 8U;
+    const auto end_byte = (end * num_all_attrs + 7U) / 8U;
+    std::memset(null_bitmap + begin_byte, 0, end_byte - begin_byte);
+
+    /* Keys. */
+    generate_primary_keys(mem_ptr + get_column_offset_in_bytes(layout, id.id), *id.type, begin, end);
+    for (auto &fk : fks) {
+        if (as<const Numeric>(fk.type)->size() == 32) {
+            auto ptr = reinterpret_cast<int32_t*>(fk.column_ptr);
+            for (auto i = begin; i != end; ++i)
+                ptr[i] = int32_t(fk.dist(g));
+        } else {
+            auto ptr = reinterpret_cast<int64_t*>(fk.column_ptr);
+            for (auto i = begin; i != end; ++i)
+                ptr[i] = fk.dist(g);
+        }
+    }
+
+    if (spec.num_attrs == 0) return;
+
+    /* Non-key attributes. */
+    std::vector<int32_t*> columns;
+    columns.reserve(spec.num_attrs);
+    for (std::size_t i = 0; i != spec.num_attrs; ++i)
+        columns.push_back(reinterpret_cast<int32_t*>(mem_ptr + get_column_offset_in_bytes(layout, first_attr + i)));
+
+    datagen::zipf_distribution<int32_t> dist(spec.num_distinct_values, spec.zipf);
+    std::bernoulli_distribution is_correlated(spec.correlation);
+    std::bernoulli_distribution is_null(spec.null_rate);
+    const bool has_correlation = spec.correlation > 0;
+    const bool has_nulls = spec.null_rate > 0;
+
+    for (auto row = begin; row != end; ++row) {
+        const int32_t a0 = dist(g);
+        columns[0][row] = a0;
+        for (std::size_t i = 1; i != spec.num_attrs; ++i)
+            columns[i][row] = has_correlation and is_correlated(g) ? a0 : dist(g);
+        if (has_nulls) {
+            for (std::size_t i = 0; i != spec.num_attrs; ++i) {
+                if (is_null(g)) {
+                    const auto bit = row * num_all_attrs + first_attr + i;
+                    null_bitmap[bit / 8U] |= 1U << (bit % 8U);
+                    columns[i][row] = 0;
+                }
+            }
+        }
+    }
+}
+
+/** Creates and fills the table described by `spec` after recursively creating and filling its dimensions.
+ * `table_idx` enumerates the tables in creation order to derive a distinct seed per table. */
+Table & generate_table(Database &DB, const table_spec &spec, uint64_t seed, unsigned num_threads,
+                       std::size_t &table_idx)
+{
+    auto &C = Catalog::Get();
+    M_insist(spec.num_rows > 0, "table must have at least one row");
+    M_insist(spec.num_distinct_values > 0, "attributes must have at least one distinct value");
+    M_insist(spec.num_distinct_values <= std::size_t(std::numeric_limits<int32_t>::max()) + 1,
+             "attribute values must fit into INT(4)");
+
+    auto key_type = [](std::size_t num_rows) {
+        return num_rows > std::size_t(std::numeric_limits<int32_t>::max()) ? Type::Get_Integer(Type::TY_Vector, 8)
+                                                                           : Type::Get_Integer(Type::TY_Vector, 4);
+    };
+
+    std::vector<std::reference_wrapper<Table>> dimensions;
+    for (auto &dim : spec.dimensions)
+        dimensions.emplace_back(generate_table(DB, dim, seed, num_threads, table_idx));
+    const uint64_t table_seed = murmur3_64(seed + table_idx++);
+
+    /*----- Create the table. ----------------------------------------------------------------------------------------*/
+    auto &table = DB.add_table(C.pool(spec.name));
+    table.push_back(C.pool("id"), key_type(spec.num_rows));
+    table.add_primary_key(C.pool("id"));
+    table.at(C.pool("id")).not_nullable = true;
+    for (std::size_t i = 0; i != spec.dimensions.size(); ++i) {
+        auto name = C.pool(spec.dimensions[i].name + "_id");
+        table.push_back(name, key_type(spec.dimensions[i].num_rows));
+        auto &fk = table.at(name);
+        fk.not_nullable = true;
+        fk.reference = &dimensions[i].get().at(C.pool("id"));
+    }
+    const std::size_t first_attr = table.num_attrs();
+    for (std::size_t i = 0; i != spec.num_attrs; ++i)
+        table.push_back(C.pool("a" + std::to_string(i)), Type::Get_Integer(Type::TY_Vector, 4));
+
+    /* Use a single PAX block, such that every column is contiguous in memory.  Round up the number of rows to a
+     * multiple of 16 since `PAXLayoutFactory` floors it to a multiple of the number of SIMD lanes. */
+    table.store(C.create_store(C.pool("PaxStore"), table));
+    storage::PAXLayoutFactory factory(storage::PAXLayoutFactory::NTuples, (spec.num_rows + 15U) & ~15UL);
+    table.layout(factory);
+    for (std::size_t i = 0; i != spec.num_rows; ++i)
+        table.store().append();
+
+    /*----- Fill the table in parallel. ------------------------------------------------------------------------------*/
+    uint8_t *mem_ptr = reinterpret_cast<uint8_t*>(table.store().memory().addr());
+    std::vector<foreign_key_info> fks;
+    for (std::size_t i = 0; i != spec.dimensions.size(); ++i) {
+        auto &fk = table[i + 1];
+        fks.push_back(foreign_key_info {
+            .column_ptr = mem_ptr + get_column_offset_in_bytes(table.layout(), fk.id),
+            .type = fk.type,
+            .dist = datagen::zipf_distribution<int64_t>(spec.dimensions[i].num_rows, spec.dimensions[i].fk_zipf),
+        });
+    }
+
+    const std::size_t num_chunks = (spec.num_rows + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    std::atomic_size_t next_chunk(0);
+    auto worker = [&]() {
+        for (std::size_t chunk; (chunk = next_chunk.fetch_add(1)) < num_chunks; ) {
+            const auto begin = chunk * CHUNK_SIZE;
+            const auto end = std::min(begin + CHUNK_SIZE, spec.num_rows);
+            generate_chunk(spec, table.layout(), mem_ptr, table[0], fks, first_attr, table.num_attrs(),
+                           murmur3_64(table_seed ^ chunk), begin, end);
+        }
+    };
+
+    num_threads = std::min<std::size_t>(num_threads, num_chunks);
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < num_threads; ++i)
+        threads.emplace_back(worker);
+    worker(); // the calling thread participates as well
+    for (auto &t : threads)
+        t.join();
+
+    return table;
+}
+
 }
 
 void m::set_all_null(uint8_t *column_ptr, std::size_t num_attrs, std::size_t begin, std::size_t end)
@@ -303,3 +469,11 @@ void m::generate_correlated_column_data(void *left_ptr, void *right_ptr, const A
         M_unreachable("unsupported type");
     }
 }
+
+Table & m::generate_schema(Database &DB, const table_spec &spec, uint64_t seed, unsigned num_threads)
+{
+    if (num_threads == 0)
+        num_threads = std::max(1U, std::thread::hardware_concurrency());
+    std::size_t table_idx = 0;
+    return generate_table(DB, spec, seed, num_threads, table_idx);
+}
@@ -3,6 +3,7 @@
 #include "storage/ColumnStore.hpp"
 #include <mutable/catalog/Schema.hpp>
 #include <random>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -60,4 +61,29 @@ void generate_correlated_column_data(void *left_ptr, void *right_ptr, const Attr
                                      std::size_t count_left, std::size_t count_right,
                                      std::size_t num_distinct_values_matching);
 
+/** Specification of a synthetic table to be generated by `generate_schema()`.  Every table has the primary key `id`,
+ * one foreign key `<dimension>_id` per entry of `dimensions`, and `num_attrs` many attributes `a0`, `a1`, ... of type
+ * `INT(4)`.  Dimensions may themselves have dimensions, hence a fact table with leaf dimensions forms a star schema
+ * and nesting dimensions further forms a snowflake schema. */
+struct M_EXPORT table_spec
+{
+    std::string name; ///< the name of the table
+    std::size_t num_rows = 0; ///< the number of rows
+    std::size_t num_attrs = 1; ///< the number of non-key attributes
+    std::size_t num_distinct_values = 100; ///< the number of distinct values of each non-key attribute
+    double zipf = 0; ///< the Zipf exponent of the non-key attributes' values; 0 is uniform
+    ///> the probability that a value of attribute `a<i>`, `i` > 0, is copied from `a0` rather than drawn independently
+    double correlation = 0;
+    double null_rate = 0; ///< the probability that a value of a non-key attribute is NULL; keys are never NULL
+    ///> the Zipf exponent of the foreign keys *referencing this table*, i.e. the skew of the fanout; 0 is uniform
+    double fk_zipf = 0;
+    std::vector<table_spec> dimensions; ///< the tables referenced by this table
+};
+
+/** Creates the tables specified by `spec` and all its (transitive) dimensions in `DB` and fills them with data.  Each
+ * table is backed by a `PaxStore` with a single PAX block and its data is written directly to memory by
+ * `num_threads` threads in parallel, where 0 means one thread per hardware thread.  The data is deterministic for
+ * a fixed `seed`, independent of `num_threads`.  Returns the table specified by `spec`. */
+Table & generate_schema(Database &DB, const table_spec &spec, uint64_t seed = 42, unsigned num_threads = 0);
+
 }
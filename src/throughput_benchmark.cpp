@@ -0,0 +1,342 @@
+#include "catalog/SerialScheduler.hpp"
+#include "lex/Lexer.hpp"
+#include "parse/Parser.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/mutable.hpp>
+#include <mutable/Options.hpp>
+#include <mutable/util/ArgParser.hpp>
+#include <mutable/util/Diagnostic.hpp>
+#include <mutable/util/reader_writer_lock.hpp>
+#include <mutable/util/Tracer.hpp>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+using namespace std::chrono;
+using clock_type = steady_clock;
+
+
+namespace {
+
+/** The command line arguments. */
+struct
+{
+    ///> whether to show a help message
+    bool show_help;
+    ///> the numbers of concurrent clients, one run per number
+    std::vector<unsigned> clients;
+    ///> the duration of the measurement of a single run, in seconds
+    double duration;
+    ///> the duration of the unmeasured warm-up of a single run, in seconds
+    double warmup;
+    ///> the files that are executed once before the benchmark, e.g. to create and load the database
+    std::vector<std::filesystem::path> setup;
+    ///> the seed for the PRNG of the clients
+    unsigned seed;
+    ///> the file to write a Chrome trace of all executions to, if any
+    const char *trace;
+} args;
+
+/** A query of the workload, i.e. the contents of a file, which may consist of several statements. */
+struct query
+{
+    std::string name; ///< the name of the file
+    std::string sql; ///< the statements of the query
+};
+
+/** A single completed execution of a query by a client. */
+struct sample
+{
+    std::size_t query; ///< the index of the executed query
+    clock_type::duration latency; ///< the time from scheduling the first to completing the last statement
+};
+
+/** The result of a single client. */
+struct client_result
+{
+    std::vector<sample> samples; ///< the executions that started and completed within the measurement
+    std::size_t num_failed = 0; ///< the number of failed executions
+    std::string first_error; ///< the error message of the first failed execution
+};
+
+std::string read_file(const std::filesystem::path &path)
+{
+    errno = 0;
+    std::ifstream in(path);
+    if (not in) {
+        std::cerr << "Could not open file " << path;
+        if (const auto errsv = errno)
+            std::cerr << ": " << strerror(errsv);
+        std::cerr << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+    return std::string(std::istreambuf_iterator<char>(in), {});
+}
+
+/** Parses the statements of `Q` on the calling thread and passes them one after another to the scheduler of the
+ * catalog.  Returns `true` iff all statements were executed successfully. */
+bool execute(const query &Q, m::Diagnostic &diag)
+{
+    auto &C = m::Catalog::Get();
+    std::istringstream in(Q.sql);
+    m::ast::Lexer lexer(diag, C.get_pool(), Q.name.c_str(), in);
+    m::ast::Parser parser(lexer);
+    bool success = true;
+    while (parser.token()) {
+        diag.clear();
+        auto cmd = parser.parse();
+        success &= C.scheduler().autocommit(std::move(cmd), diag) and diag.num_errors() == 0;
+    }
+    return success;
+}
+
+/** Repeatedly executes randomly chosen queries of `queries` until `end`.  Only executions that start no earlier than
+ * `begin` and complete no later than `end` are recorded. */
+client_result run_client(unsigned id, const std::vector<query> &queries, clock_type::time_point begin,
+                         clock_type::time_point end)
+{
+    client_result result;
+    std::ostringstream out, err;
+    m::Diagnostic diag(false, out, err);
+    std::mt19937_64 g(args.seed + id);
+    std::uniform_int_distribution<std::size_t> pick(0, queries.size() - 1);
+    m::Tracer::Get().name_thread("client " + std::to_string(id));
+
+    for (;;) {
+        const auto q = pick(g);
+        const auto start = clock_type::now();
+        if (start >= end) break;
+        auto span = m::Tracer::Get().span(queries[q].name, "client");
+        const bool success = execute(queries[q], diag);
+        const auto stop = clock_type::now();
+        span.end();
+        if (not success) {
+            if (result.num_failed++ == 0)
+                result.first_error = queries[q].name + ": " + err.str();
+        } else if (start >= begin and stop <= end) {
+            result.samples.push_back(sample { .query = q, .latency = stop - start });
+        }
+        out.str("");
+        err.str("");
+    }
+    return result;
+}
+
+/** Returns the `p`-quantile of the sorted `latencies` in milliseconds, using the nearest-rank method. */
+double quantile_ms(const std::vector<clock_type::duration> &latencies, double p)
+{
+    if (latencies.empty()) return NAN;
+    const std::size_t rank = std::clamp<std::size_t>(std::ceil(p * latencies.size()), 1, latencies.size());
+    return duration_cast<nanoseconds>(latencies[rank - 1]).count() / 1e6;
+}
+
+void print_latencies(unsigned num_clients, const std::string &name, std::vector<clock_type::duration> latencies,
+                     std::size_t num_failed)
+{
+    std::sort(latencies.begin(), latencies.end());
+    std::cout << num_clients << ',' << name << ',' << latencies.size() << ','
+              << latencies.size() / args.duration << ','
+              << quantile_ms(latencies, .5) << ','
+              << quantile_ms(latencies, .99) << ','
+              << quantile_ms(latencies, .999) << ','
+              << (latencies.empty() ? NAN : duration_cast<nanoseconds>(latencies.back()).count() / 1e6) << ','
+              << num_failed << '\n';
+}
+
+void print_contention(unsigned num_clients, const char *lock, const m::lock_contention &C)
+{
+    std::cerr << num_clients << ',' << lock << ',' << C.num_acquisitions << ',' << C.num_contended << ','
+              << duration_cast<nanoseconds>(C.wait_time).count() / 1e6 << '\n';
+}
+
+/** Performs a single run with `num_clients` concurrent clients. */
+void run(unsigned num_clients, const std::vector<query> &queries)
+{
+    auto &C = m::Catalog::Get();
+    auto *serial_scheduler = dynamic_cast<m::SerialScheduler*>(&C.scheduler());
+
+    const auto begin = clock_type::now() + duration_cast<clock_type::duration>(duration<double>(args.warmup));
+    const auto end = begin + duration_cast<clock_type::duration>(duration<double>(args.duration));
+
+    std::vector<client_result> results(num_clients);
+    std::vector<std::thread> clients;
+    for (unsigned i = 0; i != num_clients; ++i)
+        clients.emplace_back([&, i]() { results[i] = run_client(i, queries, begin, end); });
+
+    /* Only record contention during the measurement. */
+    std::this_thread::sleep_until(begin);
+    C.get_pool().reset_contention();
+    if (serial_scheduler) serial_scheduler->reset_queue_contention();
+    std::this_thread::sleep_until(end);
+    const auto pool_contention = C.get_pool().contention();
+    const auto queue_contention = serial_scheduler ? serial_scheduler->queue_contention() : m::lock_contention();
+
+    for (auto &t : clients)
+        t.join();
+
+    /*----- Report latencies, overall and per query. -----*/
+    std::vector<clock_type::duration> all;
+    std::vector<std::vector<clock_type::duration>> per_query(queries.size());
+    std::size_t num_failed = 0;
+    for (auto &R : results) {
+        for (auto &S : R.samples) {
+            all.push_back(S.latency);
+            per_query[S.query].push_back(S.latency);
+        }
+        num_failed += R.num_failed;
+        if (R.num_failed)
+            std::cerr << "Query failed: " << R.first_error << std::endl;
+    }
+    print_latencies(num_clients, "all", std::move(all), num_failed);
+    for (std::size_t q = 0; q != queries.size(); ++q)
+        print_latencies(num_clients, queries[q].name, std::move(per_query[q]), 0);
+    std::cout.flush();
+
+    /*----- Report contention. -----*/
+    print_contention(num_clients, "string pool", pool_contention);
+    if (serial_scheduler)
+        print_contention(num_clients, "scheduler queue", queue_contention);
+    std::cerr.flush();
+}
+
+void usage(std::ostream &out, const char *name)
+{
+    out << "A throughput benchmark that executes the queries of the given files concurrently by several clients.\n"
+        << "Every client repeatedly executes a randomly chosen file through the scheduler and waits for its "
+           "completion.\n"
+        << "Emits one CSV row per run and file to stdout with the throughput in queries per second and the latencies "
+           "in milliseconds,\nand one CSV row per run and lock to stderr with the number of acquisitions, the number "
+           "of contended acquisitions,\nand the time spent waiting in milliseconds.\n"
+        << "USAGE:\n\t" << name << " [<OPTIONS>] <QUERY.sql>..."
+        << std::endl;
+}
+
+}
+
+
+/*======================================================================================================================
+ * main
+ *====================================================================================================================*/
+
+int main(int argc, const char **argv)
+{
+    m::Catalog &C = m::Catalog::Get();
+
+    /*----- Parse command line arguments. ----------------------------------------------------------------------------*/
+    m::ArgParser &AP = C.arg_parser();
+#define ADD(TYPE, VAR, INIT, SHORT, LONG, DESCR, CALLBACK)\
+    VAR = INIT;\
+    {\
+        AP.add<TYPE>(SHORT, LONG, DESCR, CALLBACK);\
+    }
+    /*----- Help message ---------------------------------------------------------------------------------------------*/
+    ADD(bool, args.show_help, false,                                            /* Type, Var, Init  */
+        "-h", "--help",                                                         /* Short, Long      */
+        "prints this help message",                                             /* Description      */
+        [&](bool) { args.show_help = true; });                                  /* Callback         */
+    /*----- Workload -------------------------------------------------------------------------------------------------*/
+    ADD(std::vector<std::string_view>, args.clients, std::vector<unsigned>{ 1 }, /* Type, Var, Init  */
+        "-c", "--clients",                                                      /* Short, Long      */
+        "a comma separated list of numbers of concurrent clients",              /* Description      */
+        [&](std::vector<std::string_view> list) {                               /* Callback         */
+            args.clients.clear();
+            for (auto n : list)
+                args.clients.push_back(std::max(1, std::stoi(std::string(n))));
+        });
+    ADD(double, args.duration, 10.,                                             /* Type, Var, Init  */
+        "-d", "--duration",                                                     /* Short, Long      */
+        "the measured duration of each run in seconds",                         /* Description      */
+        [&](double d) { args.duration = std::max(d, 1e-3); });                  /* Callback         */
+    ADD(double, args.warmup, 1.,                                                /* Type, Var, Init  */
+        nullptr, "--warmup",                                                    /* Short, Long      */
+        "the unmeasured duration before each run in seconds",                   /* Description      */
+        [&](double d) { args.warmup = std::max(d, 0.); });                      /* Callback         */
+    ADD(const char*, args.setup, std::vector<std::filesystem::path>(),          /* Type, Var, Init  */
+        "-s", "--setup",                                                        /* Short, Long      */
+        "a file to execute once before the benchmark, e.g. to load data",       /* Description      */
+        [&](const char *path) { args.setup.emplace_back(path); });             /* Callback         */
+    ADD(unsigned, args.seed, 42,                                                /* Type, Var, Init  */
+        nullptr, "--seed",                                                      /* Short, Long      */
+        "the seed for the PRNG",                                                /* Description      */
+        [&](unsigned s) { args.seed = s; });                                    /* Callback         */
+    ADD(const char*, args.trace, nullptr,                                       /* Type, Var, Init  */
+        nullptr, "--trace",                                                     /* Short, Long      */
+        "write a Chrome trace of all query executions to the file",             /* Description      */
+        [&](const char *path) { args.trace = path; });                          /* Callback         */
+#undef ADD
+    AP.parse_args(argc, argv);
+
+    /*----- Help message. -----*/
+    if (args.show_help) {
+        usage(std::cout, argv[0]);
+        std::cout << "WHERE\n" << AP;
+        std::exit(EXIT_SUCCESS);
+    }
+
+    /*----- Validate command line arguments. -------------------------------------------------------------------------*/
+    if (AP.args().empty()) {
+        usage(std::cerr, argv[0]);
+        std::exit(EXIT_FAILURE);
+    }
+
+    /*----- Configure mutable. ---------------------------------------------------------------------------------------*/
+    m::Options::Get().quiet = true;
+    m::Options::Get().benchmark = true; // drop results
+    if (args.trace) {
+        m::Tracer::Get().enabled(true);
+        m::Tracer::Get().name_thread("main");
+    }
+
+    /*----- Set up the database. -------------------------------------------------------------------------------------*/
+    m::Diagnostic diag(false, std::cout, std::cerr);
+    for (auto &path : args.setup) {
+        m::execute_file(diag, path);
+        if (diag.num_errors()) {
+            std::cerr << "Setup " << path << " failed." << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+    }
+
+    /*----- Read the queries and execute each once, to validate and warm up. -----------------------------------------*/
+    std::vector<query> queries;
+    for (auto arg : AP.args()) {
+        std::filesystem::path path(arg);
+        auto &Q = queries.emplace_back(query { .name = path.filename().string(), .sql = read_file(path) });
+        if (not execute(Q, diag)) {
+            std::cerr << "Query " << path << " failed." << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+    }
+
+    /*----- Run the benchmark. ---------------------------------------------------------------------------------------*/
+    std::cout << "clients,query,count,qps,p50_ms,p99_ms,p999_ms,max_ms,failed" << std::endl;
+    std::cerr << "clients,lock,acquisitions,contended,wait_ms" << std::endl;
+    for (auto num_clients : args.clients)
+        run(num_clients, queries);
+
+    m::Catalog::Destroy();
+
+    /*----- Write the trace, including the spans of the threads of the catalog. -----*/
+    if (args.trace) {
+        std::ofstream out(args.trace);
+        if (not out) {
+            std::cerr << "Could not open file " << args.trace << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+        m::Tracer::Get().write_chrome_trace(out);
+    }
+}
@@ -0,0 +1,83 @@
+#include <mutable/util/PerfCounters.hpp>
+
+#if __linux
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+using namespace m;
+
+
+#if __linux
+namespace {
+
+/** Opens the counter of `type` and `config` for the calling thread on any CPU, counting user space only.  Returns
+ * the file descriptor or -1 on failure. */
+int open_counter(uint32_t type, uint64_t config)
+{
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return syscall(SYS_perf_event_open, &attr, /* pid= */ 0, /* cpu= */ -1, /* group_fd= */ -1, PERF_FLAG_FD_CLOEXEC);
+}
+
+/** Returns the `config` of a cache event of `cache` and a read miss. */
+constexpr uint64_t cache_read_miss(uint64_t cache)
+{
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+}
+#endif
+
+PerfCounters::PerfCounters()
+{
+    fds_.fill(-1);
+#if __linux
+    fds_[CYCLES]        = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    fds_[INSTRUCTIONS]  = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    fds_[LLC_MISSES]    = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    fds_[BRANCH_MISSES] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    fds_[DTLB_MISSES]   = open_counter(PERF_TYPE_HW_CACHE, cache_read_miss(PERF_COUNT_HW_CACHE_DTLB));
+#endif
+}
+
+PerfCounters::~PerfCounters()
+{
+#if __linux
+    for (auto fd : fds_)
+        if (fd >= 0) close(fd);
+#endif
+}
+
+PerfCounters & PerfCounters::Get()
+{
+    static thread_local PerfCounters the_counters;
+    return the_counters;
+}
+
+PerfCounters::values_type PerfCounters::read() const
+{
+    values_type values;
+    values.fill(UNAVAILABLE);
+#if __linux
+    for (unsigned i = 0; i != NUM_COUNTERS; ++i) {
+        if (fds_[i] < 0) continue;
+        struct { uint64_t value, time_enabled, time_running; } data;
+        if (::read(fds_[i], &data, sizeof(data)) != sizeof(data) or data.time_running == 0)
+            continue;
+        if (data.time_running == data.time_enabled)
+            values[i] = data.value;
+        else // counter was multiplexed, extrapolate
+            values[i] = uint64_t(double(data.value) * double(data.time_enabled) / double(data.time_running));
+    }
+#endif
+    return values;
+}
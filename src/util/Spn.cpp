@@ -1,8 +1,11 @@
 #include "Spn.hpp"
 
+#include <bit>
+#include <exception>
 #include <iomanip>
 #include "mutable/util/AdjacencyMatrix.hpp"
 #include <mutable/util/fn.hpp>
+#include <thread>
 #include "util/Kmeans.hpp"
 #include "util/RDC.hpp"
 
@@ -13,46 +16,107 @@ using namespace Eigen;
 
 namespace {
 
-std::size_t MIN_INSTANCE_SLICE = 0;
 const int MAX_K = 7;
 const float RDC_THRESHOLD = 0.3f;
 
-MatrixXf normalize_minmax(const MatrixXf &data)
+/** Normalizes each column of \p data to [0, 1] given its minimum in \p mins and its range in \p ranges. */
+MatrixXf normalize_minmax(const MatrixXf &data, const RowVectorXf &mins, const RowVectorXf &ranges)
 {
-    const RowVectorXf mins = data.colwise().minCoeff();
-    const RowVectorXf maxs = data.colwise().maxCoeff() - mins;
-
     MatrixXf normalized(data.rows(), data.cols());
     for (unsigned i = 0; i != data.cols(); ++i) {
-        if (maxs.array()[i] == 0) // min == max  =>  empty range [min, max)
+        if (ranges.array()[i] == 0) // min == max  =>  empty range [min, max)
             normalized.col(i) = VectorXf::Zero(data.rows());
         else
-            normalized.col(i) = (data.col(i).array() - mins.array()[i]) / maxs.array()[i];
+            normalized.col(i) = (data.col(i).array() - mins.array()[i]) / ranges.array()[i];
     }
     return normalized;
 }
 
+/** Replaces NULL in \p data, as given by \p null_matrix, with the mean of the attribute. */
+void impute_nulls(MatrixXf &data, const MatrixXi &null_matrix)
+{
+    for (std::size_t col_id = 0; col_id < data.cols(); col_id++) {
+        if (null_matrix.col(col_id).maxCoeff() == 0) { continue; } // there is no NULL
+        if (null_matrix.col(col_id).minCoeff() == 1) { continue; } // there is only NULL
+        float mean = 0;
+        int num_not_null = 0;
+        for (std::size_t row_id = 0; row_id < data.rows(); row_id++) {
+            if (null_matrix(row_id, col_id) == 1) { continue; }
+            mean += (data(row_id, col_id) - mean) / ++num_not_null; // iterative mean
+        }
+        for (std::size_t row_id = 0; row_id < data.rows(); row_id++) {
+            if (null_matrix(row_id, col_id) == 1) { data(row_id, col_id) = mean; }
+        }
+    }
+}
+
+/** Invokes `fn(i)` for every `i` in [0, `num_tasks`) and returns once all invocations completed.  As long as \p
+ * spare_threads permits, tasks are run on newly spawned threads, each of which returns its token to \p spare_threads
+ * when done.  All other tasks, and always the last one, are run on the calling thread.  Since tasks may recursively
+ * fork and join themselves, the total number of threads never exceeds the initial number of spare threads plus one. */
+template<typename Fn>
+void fork_join(std::atomic<unsigned> &spare_threads, std::size_t num_tasks, Fn &&fn)
+{
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> exceptions(num_tasks);
+    std::vector<std::size_t> inline_tasks;
+
+    for (std::size_t i = 0; i != num_tasks; ++i) {
+        bool acquired = false;
+        if (i + 1 != num_tasks) {
+            unsigned spare = spare_threads.load(std::memory_order_relaxed);
+            while (spare and not (acquired = spare_threads.compare_exchange_weak(spare, spare - 1))) { }
+        }
+        if (acquired) {
+            threads.emplace_back([&fn, &spare_threads, &exceptions, i]() {
+                try { fn(i); } catch (...) { exceptions[i] = std::current_exception(); }
+                spare_threads.fetch_add(1);
+            });
+        } else {
+            inline_tasks.push_back(i);
+        }
+    }
+
+    for (auto i : inline_tasks) {
+        try { fn(i); } catch (...) { exceptions[i] = std::current_exception(); }
+    }
+    for (auto &t : threads) t.join();
+
+    for (auto &e : exceptions) {
+        if (e) std::rethrow_exception(e);
+    }
+}
+
 /** Compute the splitting of the columns (attributes) of the given data with the RDC algorithm.
  *
  * @param data the data to be split
  * @param variables the variable scope of the data
+ * @param spare_threads the threads that may be spawned to compute the pairwise RDC values in parallel
  * @return the variable id and column id splitting candidates
  */
-std::pair<std::vector<SmallBitset>, std::vector<SmallBitset>>rdc_split(const MatrixXf &data, SmallBitset variables)
+std::pair<std::vector<SmallBitset>, std::vector<SmallBitset>>rdc_split(const MatrixXf &data, SmallBitset variables,
+                                                                       std::atomic<unsigned> &spare_threads)
 {
     const auto num_cols = data.cols();
     AdjacencyMatrix adjacency_matrix(num_cols);
     std::vector<MatrixXf> CDF_matrices(num_cols);
 
     /* precompute CDF matrices */
-    for (int i = 0; i < num_cols; i++) { CDF_matrices[i] = create_CDF_matrix(data.col(i)); }
+    fork_join(spare_threads, num_cols, [&](std::size_t i) { CDF_matrices[i] = create_CDF_matrix(data.col(i)); });
+
+    /* compute the RDC values of all pairs of columns (attributes), one row of the upper triangle per task */
+    std::vector<std::vector<float>> rdc_values(num_cols);
+    fork_join(spare_threads, num_cols - 1, [&](std::size_t i) {
+        rdc_values[i].reserve(num_cols - i - 1);
+        for (unsigned j = i+1; j < num_cols; j++)
+            rdc_values[i].push_back(rdc_precomputed_CDF(CDF_matrices[i], CDF_matrices[j]));
+    });
 
     /* build a graph with edges between correlated columns (attributes) */
     for (unsigned i = 0; i < num_cols - 1; i++) {
         for (unsigned j = i+1; j < num_cols; j++) {
-            const float rdc_value = rdc_precomputed_CDF(CDF_matrices[i], CDF_matrices[j]);
             /* if the rdc value is greater or equal to the threshold, consider columns dependent */
-            if (rdc_value >= RDC_THRESHOLD) {
+            if (rdc_values[i][j - i - 1] >= RDC_THRESHOLD) {
                 adjacency_matrix(i,j) = true;
                 adjacency_matrix(j,i) = true;
             }
@@ -110,29 +174,49 @@ std::pair<float, float> Spn::Sum::evaluate(const Filter &filter, unsigned leaf_i
     return { expectation_result, likelihood_result };
 }
 
-void Spn::Sum::update(VectorXf &row, SmallBitset variables, Spn::UpdateType update_type)
+std::pair<std::size_t, float> Spn::Sum::nearest_centroid(const VectorXf &normalized) const
 {
-    /* compute nearest cluster */
-    unsigned nearest_centroid = 0;
-    std::size_t num_clusters = children.size();
-    float delta = (children[0]->centroid - row).squaredNorm();
-    for (std::size_t i = 1; i < num_clusters; i++) {
-        float next_delta = (children[i]->centroid - row).squaredNorm();
+    std::size_t nearest = 0;
+    float delta = (children[0]->centroid - normalized).squaredNorm();
+    for (std::size_t i = 1; i < children.size(); i++) {
+        float next_delta = (children[i]->centroid - normalized).squaredNorm();
         if (next_delta < delta) {
             delta = next_delta;
-            nearest_centroid = i;
+            nearest = i;
         }
     }
+    return { nearest, delta };
+}
 
-    /* adjust weights of the sum nodes */
-    children[nearest_centroid]->child->num_rows++;
-    num_rows++;
+void Spn::Sum::update(VectorXf &row, VectorXf &normalized, SmallBitset variables, Spn::UpdateType update_type)
+{
+    /* route the row to the nearest cluster, in the normalized space the clusters were computed in */
+    auto [nearest, delta] = nearest_centroid(normalized);
+    children[nearest]->child->update(row, normalized, variables, update_type);
 
-    for (std::size_t i = 0; i < num_clusters; i++) {
-        children[i]->weight = children[i]->child->num_rows / float(num_rows);
+    if (update_type == INSERT) {
+        inserted_distance += delta;
+        ++num_inserted;
     }
 
-    children[nearest_centroid]->child->update(row, variables, update_type);
+    /* adjust weights of the sum nodes */
+    num_rows = 0;
+    for (auto &child : children) { num_rows += child->child->num_rows; }
+    for (auto &child : children) { child->weight = child->child->num_rows / float(num_rows); }
+}
+
+bool Spn::Sum::clustering_drifted() const
+{
+    const std::size_t num_learned = num_rows > num_inserted ? num_rows - num_inserted : 0;
+    return num_inserted >= std::max<std::size_t>(DRIFT_MIN_ROWS, DRIFT_MIN_FRACTION * num_learned) and
+           inserted_distance / num_inserted > DRIFT_FACTOR * std::max(learned_distance, DRIFT_EPSILON);
+}
+
+bool Spn::Sum::has_drifted() const
+{
+    if (clustering_drifted()) return true;
+    for (auto &child : children) { if (child->child->has_drifted()) return true; }
+    return false;
 }
 
 std::size_t Spn::Sum::estimate_number_distinct_values(unsigned id) const
@@ -177,7 +261,7 @@ std::pair<float, float> Spn::Product::evaluate(const Filter &filter, unsigned le
     return {expectation_result, likelihood_result };
 }
 
-void Spn::Product::update(VectorXf &row, SmallBitset variables, UpdateType update_type)
+void Spn::Product::update(VectorXf &row, VectorXf &normalized, SmallBitset variables, UpdateType update_type)
 {
     std::unordered_map<unsigned, unsigned> variable_to_index;
     unsigned index = 0;
@@ -187,13 +271,18 @@ void Spn::Product::update(VectorXf &row, SmallBitset variables, UpdateType updat
     for (auto &child : children) {
         std::size_t num_cols = child->variables.size();
         VectorXf proj_row(num_cols);
+        VectorXf proj_normalized(num_cols);
         auto it = child->variables.begin();
         for (std::size_t i = 0; i < num_cols; ++i) {
             proj_row(i) = row(variable_to_index[*it]);
+            proj_normalized(i) = normalized(variable_to_index[*it]);
             ++it;
         }
-        child->child->update(proj_row, child->variables, update_type);
+        child->child->update(proj_row, proj_normalized, child->variables, update_type);
     }
+
+    if (update_type == INSERT) num_rows++;
+    else if (num_rows) num_rows--;
 }
 
 std::size_t Spn::Product::estimate_number_distinct_values(unsigned id) const
@@ -227,6 +316,11 @@ void Spn::Product::print(std::ostream &out, std::size_t num_tabs) const
 std::pair<float, float> Spn::DiscreteLeaf::evaluate(const Filter &filter, unsigned leaf_id, EvalType eval_type) const
 {
     auto [spn_operator, value] = filter.at(leaf_id);
+    return evaluate(spn_operator, value, eval_type);
+}
+
+std::pair<float, float> Spn::DiscreteLeaf::evaluate(SpnOperator spn_operator, float value, EvalType eval_type) const
+{
 
     if (spn_operator == IS_NULL) { return { null_probability, null_probability }; }
 
@@ -296,7 +390,7 @@ std::pair<float, float> Spn::DiscreteLeaf::evaluate(const Filter &filter, unsign
     return { 0.f, 0.f };
 }
 
-void Spn::DiscreteLeaf::update(VectorXf &row, SmallBitset variables, Spn::UpdateType update_type)
+void Spn::DiscreteLeaf::update(VectorXf &row, VectorXf&, SmallBitset variables, Spn::UpdateType update_type)
 {
     const float value = row(0);
 
@@ -375,6 +469,11 @@ void Spn::DiscreteLeaf::print(std::ostream &out, std::size_t num_tabs) const
 std::pair<float, float> Spn::ContinuousLeaf::evaluate(const Filter &filter, unsigned leaf_id, EvalType eval_type) const
 {
     auto [spn_operator, value] = filter.at(leaf_id);
+    return evaluate(spn_operator, value, eval_type);
+}
+
+std::pair<float, float> Spn::ContinuousLeaf::evaluate(SpnOperator spn_operator, float value, EvalType eval_type) const
+{
     float probability = 0.f;
     if (spn_operator == IS_NULL) { return { null_probability, null_probability }; }
     if (bins.empty()) { return { 0.f, 0.f }; }
@@ -475,7 +574,7 @@ std::pair<float, float> Spn::ContinuousLeaf::evaluate(const Filter &filter, unsi
     return { 0.f, 0.f };
 }
 
-void Spn::ContinuousLeaf::update(VectorXf &row, SmallBitset variables, Spn::UpdateType update_type)
+void Spn::ContinuousLeaf::update(VectorXf &row, VectorXf&, SmallBitset variables, Spn::UpdateType update_type)
 {
     const float value = row(0);
 
@@ -568,6 +667,144 @@ void Spn::ContinuousLeaf::print(std::ostream &out, std::size_t num_tabs) const
     out << "\n";
 }
 
+/*======================================================================================================================
+ * Compiled
+ *====================================================================================================================*/
+
+Spn::Compiled::Compiled(const Node &root)
+{
+    /* compute the scope of the root; a leaf only occurs as root if the SPN has a single variable */
+    auto scope_of = [](const Node &node, auto &scope_of) -> SmallBitset {
+        if (auto sum = cast<const Sum>(&node))
+            return scope_of(*sum->children[0]->child, scope_of);
+        if (auto product = cast<const Product>(&node)) {
+            SmallBitset scope;
+            for (auto &child : product->children) scope |= child->variables;
+            return scope;
+        }
+        return SmallBitset(1);
+    };
+    const SmallBitset scope = scope_of(root, scope_of);
+    flatten(root, scope);
+
+    /* estimate the number of distinct values of each variable once, as it does not depend on a filter */
+    for (auto it = scope.begin(); it != scope.end(); ++it) {
+        if (*it >= distinct_values.size()) distinct_values.resize(*it + 1, 0);
+        distinct_values[*it] = root.estimate_number_distinct_values(*it);
+    }
+}
+
+uint32_t Spn::Compiled::flatten(const Node &node, SmallBitset scope)
+{
+    std::vector<uint32_t> node_children;
+    std::vector<float> node_weights;
+    kind_t kind;
+    const Node *leaf = nullptr;
+
+    if (auto sum = cast<const Sum>(&node)) {
+        kind = SUM;
+        for (auto &child : sum->children) {
+            node_children.push_back(flatten(*child->child, scope));
+            node_weights.push_back(child->weight);
+        }
+    } else if (auto product = cast<const Product>(&node)) {
+        kind = PRODUCT;
+        for (auto &child : product->children) {
+            node_children.push_back(flatten(*child->child, child->variables));
+            node_weights.push_back(1.f);
+        }
+    } else {
+        M_insist(scope.size() == 1, "a leaf must have exactly one variable");
+        kind = is<const DiscreteLeaf>(&node) ? DISCRETE_LEAF : CONTINUOUS_LEAF;
+        leaf = &node;
+    }
+
+    /* the children precede their parent */
+    const uint32_t begin_child = children.size();
+    children.insert(children.end(), node_children.begin(), node_children.end());
+    weights.insert(weights.end(), node_weights.begin(), node_weights.end());
+    nodes.push_back(node_t{ kind, begin_child, uint32_t(children.size()), scope, leaf });
+    return nodes.size() - 1;
+}
+
+std::vector<float> Spn::Compiled::evaluate(const std::vector<const Filter*> &filters, EvalType eval_type) const
+{
+    const auto num_filters = filters.size();
+    const auto num_variables = distinct_values.size();
+
+    /* scratch space, reused across calls since evaluating few filters is dominated by allocations otherwise */
+    thread_local std::vector<SmallBitset> constrained;
+    thread_local std::vector<const std::pair<SpnOperator, float>*> predicates;
+    thread_local ArrayXXf values;
+    thread_local Array<bool, Dynamic, 1> relevant;
+
+    /* the variables constrained by each filter and the predicates on each variable, for all filters contiguously */
+    constrained.assign(num_filters, SmallBitset());
+    predicates.assign(num_variables * num_filters, nullptr);
+    SmallBitset any_constrained;
+    for (std::size_t i = 0; i != num_filters; ++i) {
+        for (auto &[attribute_id, predicate] : *filters[i]) {
+            if (attribute_id >= num_variables) continue; // not in the scope of the SPN
+            constrained[i][attribute_id] = true;
+            predicates[attribute_id * num_filters + i] = &predicate;
+        }
+        any_constrained |= constrained[i];
+    }
+
+    /* the values of all nodes for all filters; the values of a single node are contiguous */
+    values.resize(num_filters, nodes.size());
+    relevant.resize(num_filters);
+
+    for (std::size_t n = 0; n != nodes.size(); ++n) {
+        const node_t &node = nodes[n];
+        /* skip subtrees that no filter constrains; products ignore them and sum nodes have no such children */
+        if ((node.scope & any_constrained).empty()) continue;
+
+        auto result = values.col(n);
+        switch (node.kind) {
+            case SUM:
+                result.setZero();
+                for (auto c = node.begin_child; c != node.end_child; ++c)
+                    result += weights[c] * values.col(children[c]);
+                break;
+
+            case PRODUCT:
+                /* children without a constrained variable do not contribute to the product */
+                result.setOnes();
+                for (auto c = node.begin_child; c != node.end_child; ++c) {
+                    const SmallBitset child_scope = nodes[children[c]].scope;
+                    if ((child_scope & any_constrained).empty()) continue;
+                    for (std::size_t i = 0; i != num_filters; ++i)
+                        relevant(i) = not (child_scope & constrained[i]).empty();
+                    result *= relevant.select(values.col(children[c]), 1.f);
+                }
+                break;
+
+            case DISCRETE_LEAF:
+            case CONTINUOUS_LEAF: {
+                auto leaf_predicates = predicates.begin() + *node.scope.begin() * num_filters;
+                for (std::size_t i = 0; i != num_filters; ++i) {
+                    if (not leaf_predicates[i]) {
+                        result(i) = 1.f;
+                        continue;
+                    }
+                    auto [spn_operator, value] = *leaf_predicates[i];
+                    result(i) = node.kind == DISCRETE_LEAF
+                        ? as<const DiscreteLeaf>(*node.leaf).evaluate(spn_operator, value, eval_type).second
+                        : as<const ContinuousLeaf>(*node.leaf).evaluate(spn_operator, value, eval_type).second;
+                }
+                break;
+            }
+        }
+    }
+
+    std::vector<float> likelihoods(num_filters, 1.f);
+    if (not nodes.empty() and not (nodes.back().scope & any_constrained).empty())
+        std::copy(values.col(nodes.size() - 1).begin(), values.col(nodes.size() - 1).end(), likelihoods.begin());
+    return likelihoods;
+}
+
+
 /*======================================================================================================================
  * Spn
  *====================================================================================================================*/
@@ -576,25 +813,27 @@ void Spn::ContinuousLeaf::print(std::ostream &out, std::size_t num_tabs) const
 
 std::unique_ptr<Spn::Product> Spn::create_product_min_slice(LearningData &ld)
 {
-    std::vector<std::unique_ptr<Product::ChildWithVariables>> children;
-    auto variable_it = ld.variables.begin();
-    for (auto i = 0; i < ld.data.cols(); i++) {
+    std::vector<SmallBitset> split_variables;
+    split_variables.reserve(ld.data.cols());
+    for (auto it = ld.variables.begin(); it != ld.variables.end(); ++it) { split_variables.emplace_back(it.as_set()); }
+
+    /* learn the children independently of each other */
+    std::vector<std::unique_ptr<Product::ChildWithVariables>> children(ld.data.cols());
+    fork_join(ld.context.spare_threads, ld.data.cols(), [&](std::size_t i) {
         const MatrixXf &data = ld.data.col(i);
         const MatrixXf &normalized = ld.normalized.col(i);
         const MatrixXi &null_matrix = ld.null_matrix.col(i);
-        SmallBitset variables(variable_it.as_set());
-        ++variable_it;
         std::vector<LeafType> split_leaf_types{ld.leaf_types[i]};
         LearningData split_data(
+            ld.context,
             data,
             normalized,
             null_matrix,
-            variables,
+            split_variables[i],
             split_leaf_types
         );
-        auto child = std::make_unique<Product::ChildWithVariables>(learn_node(split_data), variables);
-        children.push_back(std::move(child));
-    }
+        children[i] = std::make_unique<Product::ChildWithVariables>(learn_node(split_data), split_variables[i]);
+    });
     return std::make_unique<Product>(std::move(children), ld.data.rows());
 }
 
@@ -605,8 +844,9 @@ std::unique_ptr<Spn::Product> Spn::create_product_rdc(
     std::vector<SmallBitset> &variable_candidates
 )
 {
-    std::vector<std::unique_ptr<Product::ChildWithVariables>> children;
-    for (std::size_t current_split = 0; current_split < column_candidates.size(); current_split++) {
+    /* learn the children independently of each other */
+    std::vector<std::unique_ptr<Product::ChildWithVariables>> children(column_candidates.size());
+    fork_join(ld.context.spare_threads, column_candidates.size(), [&](std::size_t current_split) {
         std::size_t split_size = column_candidates[current_split].size();
         std::vector<LeafType> split_leaf_types;
         split_leaf_types.reserve(split_size);
@@ -620,13 +860,19 @@ std::unique_ptr<Spn::Product> Spn::create_product_rdc(
         const MatrixXf &data = ld.data(all, column_index);
         const MatrixXf &normalized = ld.normalized(all, column_index);
         const MatrixXi &null_matrix = ld.null_matrix(all, column_index);
-        LearningData split_data(data, normalized, null_matrix, variable_candidates[current_split], split_leaf_types);
-        auto child = std::make_unique<Product::ChildWithVariables>(
+        LearningData split_data(
+            ld.context,
+            data,
+            normalized,
+            null_matrix,
+            variable_candidates[current_split],
+            split_leaf_types
+        );
+        children[current_split] = std::make_unique<Product::ChildWithVariables>(
             learn_node(split_data),
             variable_candidates[current_split]
         );
-        children.push_back(std::move(child));
-    }
+    });
     return std::make_unique<Product>(std::move(children), ld.data.rows());
 }
 
@@ -644,8 +890,6 @@ std::unique_ptr<Spn::Sum> Spn::create_sum(Spn::LearningData &ld)
 
     /* increment k of Kmeans until we get a good clustering according to RDC splits in the clusters */
     while (true) {
-        unsigned num_split_nodes = 0;
-
         auto [labels, centroids] = kmeans_with_centroids(ld.normalized, k);
 
         std::vector<std::vector<SmallBitset>> cluster_column_candidates(k);
@@ -680,36 +924,39 @@ std::unique_ptr<Spn::Sum> Spn::create_sum(Spn::LearningData &ld)
             cluster_row_ids = std::move(new_cluster_row_ids);
         }
 
-        /* check the splitting of attributes in each cluster */
-        for (unsigned label_id = 0; label_id < k; label_id++) {
+        /* check the splitting of attributes in each cluster, independently of each other */
+        std::vector<char> is_split(k, false);
+        fork_join(ld.context.spare_threads, k, [&](std::size_t label_id) {
             std::size_t cluster_size = cluster_row_ids[label_id].size();
-            if (cluster_size == 0) { continue; }
+            if (cluster_size == 0) { return; }
 
-            const MatrixXf &data = ld.data(cluster_row_ids[label_id], all);
-
-            if (cluster_size <= MIN_INSTANCE_SLICE) {
-                num_split_nodes++;
+            if (cluster_size <= ld.context.min_instance_slice) {
+                is_split[label_id] = true;
                 cluster_column_candidates[label_id] = std::vector<SmallBitset>();
                 cluster_variable_candidates[label_id] = std::vector<SmallBitset>();
             } else {
-                auto [current_column_candidates, current_variable_candidates] = rdc_split(data, ld.variables);
-                if (current_column_candidates.size() > 1) { num_split_nodes++; }
+                const MatrixXf &data = ld.data(cluster_row_ids[label_id], all);
+                auto [current_column_candidates, current_variable_candidates] =
+                    rdc_split(data, ld.variables, ld.context.spare_threads);
+                is_split[label_id] = current_column_candidates.size() > 1;
                 cluster_column_candidates[label_id] = std::move(current_column_candidates);
                 cluster_variable_candidates[label_id] = std::move(current_variable_candidates);
             }
-        }
+        });
+        const unsigned num_split_nodes = std::count(is_split.begin(), is_split.end(), true);
 
         /* if the number of split attributes does not increase or if there is a split in each cluster, build sum node */
         if (
             ((num_split_nodes <= prev_num_split_nodes or prev_num_split_nodes == prev_cluster_row_ids.size())
              and prev_num_split_nodes != 0) or k >= MAX_K
         ) {
-            std::vector<std::unique_ptr<Sum::ChildWithWeight>> children;
-            for (std::size_t cluster_id = 0; cluster_id < k - 1; cluster_id++) {
+            /* learn the children independently of each other */
+            std::vector<std::unique_ptr<Sum::ChildWithWeight>> children(k - 1);
+            fork_join(ld.context.spare_threads, k - 1, [&](std::size_t cluster_id) {
                 const MatrixXf &data = ld.data(prev_cluster_row_ids[cluster_id], all);
                 const MatrixXf &normalized = ld.normalized(prev_cluster_row_ids[cluster_id], all);
                 const MatrixXi &null_matrix = ld.null_matrix(prev_cluster_row_ids[cluster_id], all);
-                LearningData cluster_data(data, normalized, null_matrix, ld.variables, ld.leaf_types);
+                LearningData cluster_data(ld.context, data, normalized, null_matrix, ld.variables, ld.leaf_types);
                 const float weight = float(data.rows())/float(num_rows);
                 std::size_t cluster_vertical_partitions = prev_cluster_column_candidates[cluster_id].size();
 
@@ -727,16 +974,20 @@ std::unique_ptr<Spn::Sum> Spn::create_sum(Spn::LearningData &ld)
                         prev_cluster_variable_candidates[cluster_id]
                     );
                 }
-                std::unique_ptr<Sum::ChildWithWeight> child = std::make_unique<Sum::ChildWithWeight>(
+                children[cluster_id] = std::make_unique<Sum::ChildWithWeight>(
                     std::move(child_node),
                     weight,
                     prev_centroids.row(cluster_id)
                 );
-
-                children.push_back(std::move(child));
-            }
-
-            return std::make_unique<Sum>(std::move(children), num_rows);
+            });
+
+            /* record how well the clusters fit the learned rows to detect drift of inserted rows */
+            auto sum = std::make_unique<Sum>(std::move(children), num_rows);
+            double distance = 0.;
+            for (unsigned current_row = 0; current_row < num_rows; current_row++)
+                distance += sum->nearest_centroid(ld.normalized.row(current_row).transpose()).second;
+            sum->learned_distance = distance / num_rows;
+            return sum;
         }
         prev_num_split_nodes = num_split_nodes;
         prev_cluster_column_candidates = std::move(cluster_column_candidates);
@@ -814,6 +1065,7 @@ std::unique_ptr<Spn::Node> Spn::learn_node(LearningData &ld)
                     continue;
                 }
                 auto std_lower_bound = std::lower_bound(bins.begin(), bins.end(), current_value);
+                if (std_lower_bound == bins.end()) --std_lower_bound; // the maximum, beyond the last bin due to rounding
                 std_lower_bound->cumulative_probability++;
             }
 
@@ -836,10 +1088,10 @@ std::unique_ptr<Spn::Node> Spn::learn_node(LearningData &ld)
     }
 
     /* build product node with the minimum instance slice */
-    if (num_rows <= MIN_INSTANCE_SLICE) { return create_product_min_slice(ld); }
+    if (num_rows <= ld.context.min_instance_slice) { return create_product_min_slice(ld); }
 
     /* build product node with the RDC algorithm */
-    auto [column_candidates, variable_candidates] = rdc_split(ld.data, ld.variables);
+    auto [column_candidates, variable_candidates] = rdc_split(ld.data, ld.variables, ld.context.spare_threads);
     if (column_candidates.size() != 1) { return create_product_rdc(ld, column_candidates, variable_candidates); }
 
     /* build sum node */
@@ -848,35 +1100,33 @@ std::unique_ptr<Spn::Node> Spn::learn_node(LearningData &ld)
 
 /*----- Learning -----------------------------------------------------------------------------------------------------*/
 
-Spn Spn::learn_spn(Eigen::MatrixXf &data, Eigen::MatrixXi &null_matrix, std::vector<LeafType> &leaf_types)
+Spn Spn::learn_spn(Eigen::MatrixXf &data, Eigen::MatrixXi &null_matrix, std::vector<LeafType> &leaf_types,
+                   std::size_t num_rows, unsigned num_threads)
 {
-    std::size_t num_rows = data.rows();
-    MIN_INSTANCE_SLICE = std::max<std::size_t>((0.1 * num_rows), 1);
+    const std::size_t num_sampled_rows = data.rows();
+    if (num_rows == 0) num_rows = num_sampled_rows;
+    M_insist(num_rows >= num_sampled_rows, "the data cannot have more rows than the relation");
 
-    if (num_rows == 0) {
+    if (num_sampled_rows == 0) {
         std::vector<DiscreteLeaf::Bin> bins;
-        return Spn(0, std::make_unique<DiscreteLeaf>(std::move(bins), 0, 0));
+        Spn spn(num_rows, std::make_unique<DiscreteLeaf>(std::move(bins), 0, num_rows));
+        spn.mins_ = spn.ranges_ = RowVectorXf::Zero(data.cols());
+        spn.leaf_types_ = leaf_types;
+        return spn;
     }
 
     /* replace NULL in the data matrix with the mean of the attribute */
-    for (std::size_t col_id = 0; col_id < data.cols(); col_id++) {
-        if (null_matrix.col(col_id).maxCoeff() == 0) { continue; } // there is no NULL
-        if (null_matrix.col(col_id).minCoeff() == 1) { continue; } // there is only NULL
-        float mean = 0;
-        int num_not_null = 0;
-        for (std::size_t row_id = 0; row_id < data.rows(); row_id++) {
-            if (null_matrix(row_id, col_id) == 1) { continue; }
-            mean += (data(row_id, col_id) - mean) / ++num_not_null; // iterative mean
-        }
-        for (std::size_t row_id = 0; row_id < data.rows(); row_id++) {
-            if (null_matrix(row_id, col_id) == 1) { data(row_id, col_id) = mean; }
-        }
-    }
+    impute_nulls(data, null_matrix);
 
     SmallBitset variables = SmallBitset::All(data.cols());
 
-    auto normalized = normalize_minmax(data);
+    const RowVectorXf mins = data.colwise().minCoeff();
+    const RowVectorXf ranges = data.colwise().maxCoeff() - mins;
+    auto normalized = normalize_minmax(data, mins, ranges);
+    std::vector<LeafType> spn_leaf_types(leaf_types);
+    LearningContext context(std::max<std::size_t>((0.1 * num_sampled_rows), 1), std::max(num_threads, 1U) - 1);
     LearningData ld(
+        context,
         data,
         normalized,
         null_matrix,
@@ -884,32 +1134,186 @@ Spn Spn::learn_spn(Eigen::MatrixXf &data, Eigen::MatrixXi &null_matrix, std::vec
         std::move(leaf_types)
     );
 
-    return Spn(num_rows, learn_node(ld));
+    auto root = learn_node(ld);
+    if (num_rows != num_sampled_rows)
+        root->scale(double(num_rows) / num_sampled_rows);
+    Spn spn(num_rows, std::move(root));
+    spn.mins_ = mins;
+    spn.ranges_ = ranges;
+    spn.leaf_types_ = std::move(spn_leaf_types);
+    return spn;
+}
+
+void Spn::relearn_drifted(std::unique_ptr<Node> &node, LearningData &ld, double factor)
+{
+    const auto num_rows = ld.data.rows();
+
+    if (auto sum = dynamic_cast<Sum*>(node.get())) {
+        /* relearn the sum node itself if its clustering no longer fits the data */
+        if (num_rows != 0 and sum->clustering_drifted()) {
+            node = learn_node(ld);
+            node->scale(factor);
+            return;
+        }
+
+        /* route the rows to the nearest cluster and relearn the drifted children */
+        std::vector<std::vector<unsigned>> cluster_row_ids(sum->children.size());
+        for (unsigned current_row = 0; current_row < num_rows; current_row++) {
+            auto [nearest, _] = sum->nearest_centroid(ld.normalized.row(current_row).transpose());
+            cluster_row_ids[nearest].push_back(current_row);
+        }
+        fork_join(ld.context.spare_threads, sum->children.size(), [&](std::size_t cluster_id) {
+            auto &child = sum->children[cluster_id]->child;
+            if (not child->has_drifted()) return;
+            const MatrixXf &data = ld.data(cluster_row_ids[cluster_id], all);
+            const MatrixXf &normalized = ld.normalized(cluster_row_ids[cluster_id], all);
+            const MatrixXi &null_matrix = ld.null_matrix(cluster_row_ids[cluster_id], all);
+            LearningData cluster_data(ld.context, data, normalized, null_matrix, ld.variables, ld.leaf_types);
+            relearn_drifted(child, cluster_data, factor);
+        });
+
+        sum->num_rows = 0;
+        for (auto &child : sum->children) { sum->num_rows += child->child->num_rows; }
+        for (auto &child : sum->children) { child->weight = child->child->num_rows / float(sum->num_rows); }
+    } else if (auto product = dynamic_cast<Product*>(node.get())) {
+        /* project the columns of each drifted child */
+        fork_join(ld.context.spare_threads, product->children.size(), [&](std::size_t child_id) {
+            auto &child = product->children[child_id];
+            if (not child->child->has_drifted()) return;
+            std::vector<LeafType> split_leaf_types;
+            std::vector<unsigned> column_index;
+            unsigned index = 0;
+            for (auto it = ld.variables.begin(); it != ld.variables.end(); ++it, ++index) {
+                if (not child->variables[*it]) continue;
+                split_leaf_types.push_back(ld.leaf_types[index]);
+                column_index.push_back(index);
+            }
+            const MatrixXf &data = ld.data(all, column_index);
+            const MatrixXf &normalized = ld.normalized(all, column_index);
+            const MatrixXi &null_matrix = ld.null_matrix(all, column_index);
+            LearningData split_data(ld.context, data, normalized, null_matrix, child->variables, split_leaf_types);
+            relearn_drifted(child->child, split_data, factor);
+        });
+        product->num_rows = std::llround(num_rows * factor);
+    }
+}
+
+void Spn::relearn_drifted(MatrixXf &data, MatrixXi &null_matrix, std::size_t num_rows, unsigned num_threads)
+{
+    const std::size_t num_sampled_rows = data.rows();
+    if (num_rows == 0) num_rows = num_sampled_rows;
+    M_insist(num_rows >= num_sampled_rows, "the data cannot have more rows than the relation");
+    M_insist(data.cols() == mins_.size(), "the data must have the attributes the SPN was learned on");
+
+    if (num_sampled_rows != 0) {
+        impute_nulls(data, null_matrix);
+        /* normalize like the learned data, such that rows are routed to the same clusters as updates */
+        auto normalized = normalize_minmax(data, mins_, ranges_);
+        LearningContext context(std::max<std::size_t>((0.1 * num_sampled_rows), 1), std::max(num_threads, 1U) - 1);
+        LearningData ld(context, data, normalized, null_matrix, SmallBitset::All(data.cols()), leaf_types_);
+        relearn_drifted(root_, ld, double(num_rows) / num_sampled_rows);
+    }
+    num_rows_ = num_rows;
+    invalidate_cache();
 }
 
 /*----- Inference ----------------------------------------------------------------------------------------------------*/
 
-void Spn::update(VectorXf &row, UpdateType update_type)
+std::shared_ptr<const Spn::Compiled> Spn::compiled() const
 {
-    SmallBitset variables((1 << row.size()) - 1);
-    root_->update(row, variables, update_type);
+    std::lock_guard<std::mutex> lock(cache_->mutex);
+    if (not cache_->compiled)
+        cache_->compiled = std::make_shared<const Compiled>(*root_);
+    return cache_->compiled;
 }
 
-float Spn::likelihood(const Filter &filter) const
+std::size_t Spn::InferenceCache::key_hash::operator()(const key_type &key) const
 {
-    return root_->evaluate(filter, filter.begin()->first, APPROXIMATE).second;
+    uint64_t hash = key.second;
+    for (auto [attribute_id, spn_operator, value] : key.first) {
+        const uint64_t predicate =
+            uint64_t(attribute_id) << 40 | uint64_t(spn_operator) << 32 | std::bit_cast<uint32_t>(value);
+        hash = murmur3_64(hash ^ predicate);
+    }
+    return hash;
 }
 
-float Spn::upper_bound(const Filter &filter) const
+std::vector<float> Spn::evaluate(const std::vector<const Filter*> &filters, EvalType eval_type) const
 {
-    return root_->evaluate(filter, filter.begin()->first, UPPER_BOUND).second;
+    using key_type = InferenceCache::key_type;
+
+    std::vector<float> results(filters.size());
+    std::vector<key_type> keys;
+    keys.reserve(filters.size());
+    for (auto filter : filters) {
+        key_type key;
+        key.first.reserve(filter->size());
+        for (auto &[attribute_id, predicate] : *filter)
+            key.first.emplace_back(attribute_id, predicate.first, predicate.second);
+        std::sort(key.first.begin(), key.first.end());
+        key.second = eval_type;
+        keys.push_back(std::move(key));
+    }
+
+    /* look up memoized results and collect the distinct filters that remain to be evaluated */
+    std::vector<const Filter*> pending;
+    std::vector<std::size_t> pending_ids(filters.size(), -1UL); // index into `pending` of each unresolved filter
+    {
+        std::unordered_map<std::reference_wrapper<const key_type>, std::size_t, InferenceCache::key_hash,
+                           std::equal_to<key_type>> pending_keys;
+        std::lock_guard<std::mutex> lock(cache_->mutex);
+        for (std::size_t i = 0; i != filters.size(); ++i) {
+            if (auto it = cache_->likelihoods.find(keys[i]); it != cache_->likelihoods.end()) {
+                results[i] = it->second;
+            } else {
+                auto [pending_it, inserted] = pending_keys.emplace(std::cref(keys[i]), pending.size());
+                if (inserted) pending.push_back(filters[i]);
+                pending_ids[i] = pending_it->second;
+            }
+        }
+    }
+    if (pending.empty()) return results;
+
+    auto likelihoods = compiled()->evaluate(pending, eval_type);
+
+    std::lock_guard<std::mutex> lock(cache_->mutex);
+    if (cache_->likelihoods.size() + pending.size() > InferenceCache::MAX_ENTRIES)
+        cache_->likelihoods.clear();
+    for (std::size_t i = 0; i != filters.size(); ++i) {
+        if (pending_ids[i] == -1UL) continue;
+        results[i] = likelihoods[pending_ids[i]];
+        cache_->likelihoods.emplace(std::move(keys[i]), results[i]);
+    }
+    return results;
+}
+
+void Spn::invalidate_cache()
+{
+    std::lock_guard<std::mutex> lock(cache_->mutex);
+    cache_->compiled.reset();
+    cache_->likelihoods.clear();
 }
 
-float Spn::lower_bound(const Filter &filter) const
+void Spn::update(VectorXf &row, UpdateType update_type)
 {
-    return root_->evaluate(filter, filter.begin()->first, LOWER_BOUND).second;
+    SmallBitset variables((1 << row.size()) - 1);
+    VectorXf normalized(row.size());
+    for (unsigned i = 0; i != row.size(); ++i) {
+        if (i >= ranges_.size() or ranges_[i] == 0) normalized[i] = 0.f;
+        else normalized[i] = (row[i] - mins_[i]) / ranges_[i];
+    }
+    root_->update(row, normalized, variables, update_type);
+
+    /* the compiled SPN and memoized results are outdated */
+    invalidate_cache();
 }
 
+float Spn::likelihood(const Filter &filter) const { return evaluate({ &filter }, APPROXIMATE)[0]; }
+
+float Spn::upper_bound(const Filter &filter) const { return evaluate({ &filter }, UPPER_BOUND)[0]; }
+
+float Spn::lower_bound(const Filter &filter) const { return evaluate({ &filter }, LOWER_BOUND)[0]; }
+
 float Spn::expectation(unsigned attribute_id, const Filter &filter) const
 {
     auto filter_copy = filter;
@@ -945,6 +1349,8 @@ void Spn::delete_row(VectorXf &row)
 
 std::size_t Spn::estimate_number_distinct_values(unsigned attribute_id) const
 {
+    auto C = compiled();
+    if (attribute_id < C->distinct_values.size()) return C->distinct_values[attribute_id];
     return root_->estimate_number_distinct_values(attribute_id);
 }
 
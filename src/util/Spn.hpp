@@ -1,11 +1,15 @@
 #pragma once
 
+#include <atomic>
+#include <cmath>
 #include <Eigen/Core>
 #include <iostream>
 #include <map>
 #include <memory>
 #include "mutable/util/ADT.hpp"
+#include <mutex>
 #include <set>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
@@ -48,8 +52,23 @@ struct Spn
 
     private:
 
+    /** State shared by all nodes learned by a single invocation of `learn_spn()`. */
+    struct LearningContext
+    {
+        ///> the number of rows up to which a node is split into its single columns rather than clustered
+        std::size_t min_instance_slice;
+        ///> the number of threads that may still be spawned to learn children of a node in parallel
+        std::atomic<unsigned> spare_threads;
+
+        LearningContext(std::size_t min_instance_slice, unsigned spare_threads)
+            : min_instance_slice(min_instance_slice)
+            , spare_threads(spare_threads)
+        { }
+    };
+
     struct LearningData
     {
+        LearningContext &context;
         const Eigen::MatrixXf &data;
         const Eigen::MatrixXf &normalized;
         const Eigen::MatrixXi &null_matrix;
@@ -57,13 +76,15 @@ struct Spn
         std::vector<LeafType> leaf_types;
 
         LearningData(
+            LearningContext &context,
             const Eigen::MatrixXf &data,
             const Eigen::MatrixXf &normalized,
             const Eigen::MatrixXi &null_matrix,
             SmallBitset variables,
             std::vector<LeafType> leaf_types
         )
-            : data(data)
+            : context(context)
+            , data(data)
             , normalized(normalized)
             , null_matrix(null_matrix)
             , variables(variables)
@@ -90,10 +111,27 @@ struct Spn
          */
         virtual std::pair<float, float> evaluate(const Filter &filter, unsigned leaf_id, EvalType eval_type) const = 0;
 
-        virtual void update(Eigen::VectorXf &row, SmallBitset variables, UpdateType update_type) = 0;
+        /** Update the node and its descendants with a single row.
+         *
+         * @param row           the row, projected to the \p variables of this node
+         * @param normalized    the row min-max normalized like the data the SPN was learned on, used to route the row
+         *                      to the nearest cluster of a sum node
+         * @param variables     the variables in the scope of this node
+         * @param update_type   the type of update (insert or delete)
+         */
+        virtual void update(Eigen::VectorXf &row, Eigen::VectorXf &normalized, SmallBitset variables,
+                            UpdateType update_type) = 0;
+
+        /** Returns `true` iff the rows inserted into this node or any of its descendants deviate too much from the data
+         * the node was learned on, see `Sum::has_drifted()`. */
+        virtual bool has_drifted() const { return false; }
 
         virtual std::size_t estimate_number_distinct_values(unsigned id) const = 0;
 
+        /** Scales the number of rows of this node and all its descendants by \p factor, e.g. to extrapolate an SPN
+         * learned on a sample to the entire relation. */
+        virtual void scale(double factor) { num_rows = std::llround(num_rows * factor); }
+
         virtual unsigned height() const = 0;
         virtual unsigned breadth() const = 0;
         virtual unsigned degree() const = 0;
@@ -119,17 +157,50 @@ struct Spn
 
         std::vector<std::unique_ptr<ChildWithWeight>> children;
 
-        Sum(std::vector<std::unique_ptr<ChildWithWeight>> children, std::size_t num_rows)
+        /*----- Drift detection --------------------------------------------------------------------------------------*/
+        ///> the factor by which the mean distance of inserted rows to their centroids must exceed the mean distance of
+        ///> the learned rows to indicate drift
+        static constexpr float DRIFT_FACTOR = 2.f;
+        ///> the minimum number of inserted rows, relative to the number of learned rows, to detect drift
+        static constexpr float DRIFT_MIN_FRACTION = .1f;
+        ///> the minimum absolute number of inserted rows to detect drift
+        static constexpr std::size_t DRIFT_MIN_ROWS = 16;
+        ///> the minimum mean squared distance, such that drift is not detected due to rounding on tight clusters
+        static constexpr float DRIFT_EPSILON = 1e-3f;
+
+        float learned_distance = 0.f; ///< mean squared distance of the learned rows to their nearest centroid
+        double inserted_distance = 0.; ///< sum of squared distances of the inserted rows to their nearest centroid
+        std::size_t num_inserted = 0; ///< number of rows inserted since this node was learned
+
+        Sum(std::vector<std::unique_ptr<ChildWithWeight>> children, std::size_t num_rows, float learned_distance = 0.f)
             : Node(num_rows)
             , children(std::move(children))
+            , learned_distance(learned_distance)
         { }
 
+        /** Returns the index of the child whose centroid is nearest to the \p normalized row and the squared distance
+         * to it. */
+        std::pair<std::size_t, float> nearest_centroid(const Eigen::VectorXf &normalized) const;
+
         std::pair<float, float> evaluate(const Filter &filter, unsigned leaf_id, EvalType eval_type) const override;
 
-        void update(Eigen::VectorXf &row, SmallBitset variables, UpdateType update_type) override;
+        void update(Eigen::VectorXf &row, Eigen::VectorXf &normalized, SmallBitset variables,
+                    UpdateType update_type) override;
+
+        /** Returns `true` iff sufficiently many rows were inserted into this node and their mean squared distance to
+         * the nearest centroid exceeds the mean squared distance of the learned rows by `DRIFT_FACTOR`, i.e. the
+         * clustering no longer reflects the data. */
+        bool clustering_drifted() const;
+
+        bool has_drifted() const override;
 
         std::size_t estimate_number_distinct_values(unsigned id) const override;
 
+        void scale(double factor) override {
+            Node::scale(factor);
+            for (auto &child : children) { child->child->scale(factor); }
+        }
+
         unsigned height() const override {
             unsigned max_height = 0;
             for (auto &child : children) { max_height = std::max(max_height, child->child->height()); }
@@ -179,10 +250,21 @@ struct Spn
 
         std::pair<float, float> evaluate(const Filter &filter, unsigned leaf_id, EvalType eval_type) const override;
 
-        void update(Eigen::VectorXf &row, SmallBitset variables, UpdateType update_type) override;
+        void update(Eigen::VectorXf &row, Eigen::VectorXf &normalized, SmallBitset variables,
+                    UpdateType update_type) override;
+
+        bool has_drifted() const override {
+            for (auto &child : children) { if (child->child->has_drifted()) return true; }
+            return false;
+        }
 
         std::size_t estimate_number_distinct_values(unsigned id) const override;
 
+        void scale(double factor) override {
+            Node::scale(factor);
+            for (auto &child : children) { child->child->scale(factor); }
+        }
+
         unsigned height() const override {
             unsigned max_height = 0;
             for (auto &child : children) { max_height = std::max(max_height, child->child->height()); }
@@ -238,8 +320,11 @@ struct Spn
         { }
 
         std::pair<float, float> evaluate(const Filter &bin_value, unsigned leaf_id, EvalType eval_type) const override;
+        /** Evaluate the single predicate `spn_operator` `value` on this leaf. */
+        std::pair<float, float> evaluate(SpnOperator spn_operator, float value, EvalType eval_type) const;
 
-        void update(Eigen::VectorXf &row, SmallBitset variables, UpdateType update_type) override;
+        void update(Eigen::VectorXf &row, Eigen::VectorXf &normalized, SmallBitset variables,
+                    UpdateType update_type) override;
 
         std::size_t estimate_number_distinct_values(unsigned id) const override;
 
@@ -289,8 +374,11 @@ struct Spn
         { }
 
         std::pair<float, float> evaluate(const Filter &filter, unsigned leaf_id, EvalType eval_type) const override;
+        /** Evaluate the single predicate `spn_operator` `value` on this leaf. */
+        std::pair<float, float> evaluate(SpnOperator spn_operator, float value, EvalType eval_type) const;
 
-        void update(Eigen::VectorXf &row, SmallBitset variables, UpdateType update_type) override;
+        void update(Eigen::VectorXf &row, Eigen::VectorXf &normalized, SmallBitset variables,
+                    UpdateType update_type) override;
 
         std::size_t estimate_number_distinct_values(unsigned id) const override;
 
@@ -303,10 +391,73 @@ struct Spn
         void print(std::ostream &out, std::size_t num_tabs) const override;
     };
 
+    /** A flat, array-based form of the node tree used for inference.  The nodes are stored in post-order, i.e. every
+     * node succeeds its children and the root is the last node, such that a single pass over the nodes evaluates the
+     * SPN bottom up without recursion or virtual calls.  Many filters are evaluated in one pass, with the values of a
+     * node for all filters stored contiguously to vectorize the arithmetic of sum and product nodes. */
+    struct Compiled
+    {
+        enum kind_t : uint8_t { SUM, PRODUCT, DISCRETE_LEAF, CONTINUOUS_LEAF };
+
+        struct node_t
+        {
+            kind_t kind;
+            uint32_t begin_child, end_child; ///< range of this node's children in `children` and `weights`
+            SmallBitset scope; ///< the variables in the scope of this node
+            const Node *leaf; ///< the leaf in the tree if this node is a leaf, `nullptr` otherwise
+        };
+
+        std::vector<node_t> nodes; ///< the nodes in post-order
+        std::vector<uint32_t> children; ///< the indices of the children of all nodes in `nodes`
+        std::vector<float> weights; ///< the weights of the children of sum nodes, 1 for children of product nodes
+        std::vector<std::size_t> distinct_values; ///< the estimated number of distinct values of each variable
+
+        /** Flattens the tree rooted in \p root. */
+        explicit Compiled(const Node &root);
+
+        /** Evaluates the likelihood of each of the \p filters. */
+        std::vector<float> evaluate(const std::vector<const Filter*> &filters, EvalType eval_type) const;
+
+        private:
+        uint32_t flatten(const Node &node, SmallBitset scope);
+    };
+
+    /** The compiled form of the SPN and memoized results of inference.  Both are discarded on updates. */
+    struct InferenceCache
+    {
+        ///> a filter in canonical form, i.e. the triples (attribute, operator, value) sorted by attribute, and the
+        ///> evaluation type
+        using key_type = std::pair<std::vector<std::tuple<unsigned, SpnOperator, float>>, EvalType>;
+        struct key_hash { std::size_t operator()(const key_type &key) const; };
+        static constexpr std::size_t MAX_ENTRIES = 1UL << 16; ///< the maximum number of memoized results
+
+        std::mutex mutex; ///< protects the cache from concurrent estimations
+        std::shared_ptr<const Compiled> compiled;
+        std::unordered_map<key_type, float, key_hash> likelihoods;
+    };
+
     std::size_t num_rows_;
     std::unique_ptr<Node> root_;
+    std::unique_ptr<InferenceCache> cache_;
+    Eigen::RowVectorXf mins_; ///< the minimum of each attribute in the learned data, used to normalize updates
+    Eigen::RowVectorXf ranges_; ///< the range of each attribute in the learned data, used to normalize updates
+    std::vector<LeafType> leaf_types_; ///< the leaf types the SPN was learned with, used to relearn subtrees
 
-    Spn(std::size_t num_rows, std::unique_ptr<Node> root) : num_rows_(num_rows), root_(std::move(root)) { }
+    Spn(std::size_t num_rows, std::unique_ptr<Node> root)
+        : num_rows_(num_rows)
+        , root_(std::move(root))
+        , cache_(std::make_unique<InferenceCache>())
+    { }
+
+    /** Discards the compiled form of this SPN and all memoized results, e.g. after an update. */
+    void invalidate_cache();
+
+    /** Returns the compiled form of this SPN, compiling it if necessary. */
+    std::shared_ptr<const Compiled> compiled() const;
+
+    /** Compute the likelihoods of the given \p filters with evaluation type \p eval_type.  Repeated filters are
+     * evaluated only once and results are memoized across calls. */
+    std::vector<float> evaluate(const std::vector<const Filter*> &filters, EvalType eval_type) const;
 
     public:
 
@@ -335,6 +486,11 @@ struct Spn
     /** Recursively learns the nodes of an SPN. */
     static std::unique_ptr<Node> learn_node(LearningData &learning_data);
 
+    /** Relearns all drifted sum nodes in the subtree rooted in \p node from the rows of \p learning_data that are
+     * routed to them.  The row counts of all nodes on the path to a relearned node are set to the number of routed rows
+     * times \p factor. */
+    static void relearn_drifted(std::unique_ptr<Node> &node, LearningData &learning_data, double factor);
+
     public:
 
     /** Learn an SPN over the given data.
@@ -343,9 +499,31 @@ struct Spn
      * @param null_matrix       the NULL values of the data as a matrix
      * @param attribute_to_id   a map from the attributes (random variables) to internal id
      * @param leaf_types        the types of a leaf for a non-primary key attribute
+     * @param num_rows          the number of rows of the relation if \p data is a sample of it, 0 if \p data is the
+     *                          entire relation; the row counts of all nodes are extrapolated to this number of rows
+     * @param num_threads       the maximum number of threads to learn with; independent children of a node are learned
+     *                          in parallel
      * @return                  the learned SPN
      */
-    static Spn learn_spn(Eigen::MatrixXf &data, Eigen::MatrixXi &null_matrix, std::vector<LeafType> &leaf_types);
+    static Spn learn_spn(Eigen::MatrixXf &data, Eigen::MatrixXi &null_matrix, std::vector<LeafType> &leaf_types,
+                         std::size_t num_rows = 0, unsigned num_threads = 1);
+
+    /** Returns `true` iff the rows inserted since learning deviate so much from the learned data that some sum nodes
+     * should be relearned, see `relearn_drifted()`. */
+    bool has_drifted() const { return root_->has_drifted(); }
+
+    /** Relearn the drifted sum nodes of this SPN, i.e. the subtrees whose clustering no longer reflects the data, from
+     * the current data of the relation.  Rows are routed from the root to the drifted nodes like updates.  The rest of
+     * the SPN is retained.
+     *
+     * @param data              the current data, with the same attributes as the data the SPN was learned on
+     * @param null_matrix       the NULL values of the data as a matrix
+     * @param num_rows          the number of rows of the relation if \p data is a sample of it, 0 if \p data is the
+     *                          entire relation
+     * @param num_threads       the maximum number of threads to learn with
+     */
+    void relearn_drifted(Eigen::MatrixXf &data, Eigen::MatrixXi &null_matrix, std::size_t num_rows = 0,
+                         unsigned num_threads = 1);
 
     /*==================================================================================================================
      * Inference
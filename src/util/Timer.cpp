@@ -4,6 +4,24 @@
 using namespace m;
 
 
+void Timer::trace(const Measurement &M)
+{
+    M_insist(M.is_finished());
+    /* Strip the tree decoration of names of nested measurements, e.g. "|- " or " ` ", since the trace viewer
+     * nests spans by time. */
+    const auto pos = M.name.find_first_not_of(" |`-");
+    Tracer::args_type args;
+    if (M.has_counters()) {
+        const auto counters = M.counters();
+        for (unsigned i = 0; i != PerfCounters::NUM_COUNTERS; ++i) {
+            if (counters[i] != PerfCounters::UNAVAILABLE)
+                args.emplace_back(PerfCounters::name(PerfCounters::counter_t(i)), counters[i]);
+        }
+    }
+    Tracer::Get().add(pos == std::string::npos ? M.name : M.name.substr(pos), "timer", M.begin, M.end,
+                      std::move(args));
+}
+
 M_LCOV_EXCL_START
 std::ostream & m::operator<<(std::ostream &out, const Timer::Measurement &M)
 {
@@ -16,6 +34,13 @@ std::ostream & m::operator<<(std::ostream &out, const Timer::Measurement &M)
         M_insist(M.is_finished());
         using namespace std::chrono;
         out << " took " << duration_cast<microseconds>(M.duration()).count() / 1e3 << " ms";
+        if (M.has_counters()) {
+            const auto counters = M.counters();
+            for (unsigned i = 0; i != PerfCounters::NUM_COUNTERS; ++i) {
+                if (counters[i] != PerfCounters::UNAVAILABLE)
+                    out << ", " << counters[i] << ' ' << PerfCounters::name(PerfCounters::counter_t(i));
+            }
+        }
     }
     return out;
 }
@@ -0,0 +1,101 @@
+#include <mutable/util/Tracer.hpp>
+
+#include <mutable/util/fn.hpp>
+#include <algorithm>
+#include <iomanip>
+
+
+using namespace m;
+
+
+Tracer::Span::Span(std::string name, const char *category)
+    : name_(std::move(name))
+    , category_(category)
+    , begin_(Tracer::Get().enabled() ? clock::now() : time_point())
+{ }
+
+void Tracer::Span::end(args_type args)
+{
+    if (begin_ == time_point()) return; // tracing was disabled or span has already ended
+    Tracer::Get().add(std::move(name_), category_, std::exchange(begin_, time_point()), clock::now(), std::move(args));
+}
+
+Tracer & Tracer::Get()
+{
+    static Tracer the_tracer;
+    return the_tracer;
+}
+
+unsigned Tracer::thread_id()
+{
+    static std::atomic<unsigned> next_id = 1;
+    static thread_local const unsigned id = next_id.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+void Tracer::add(std::string name, const char *category, time_point begin, time_point end, args_type args)
+{
+    if (not enabled()) return;
+    event e{ std::move(name), category, thread_id(), begin, end, std::move(args) };
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.push_back(std::move(e));
+}
+
+void Tracer::name_thread(std::string name)
+{
+    const auto tid = thread_id();
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::find_if(thread_names_.begin(), thread_names_.end(), [tid](auto &p) { return p.first == tid; });
+    if (it == thread_names_.end())
+        thread_names_.emplace_back(tid, std::move(name));
+    else
+        it->second = std::move(name);
+}
+
+std::vector<Tracer::event> Tracer::events() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return events_;
+}
+
+void Tracer::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.clear();
+}
+
+void Tracer::write_chrome_trace(std::ostream &out) const
+{
+    /* Timestamps and durations are given in microseconds. */
+    auto us = [](clock::duration d) { return std::chrono::duration<double, std::micro>(d).count(); };
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto old_precision = out.precision(3);
+    const auto old_flags = out.setf(std::ios::fixed, std::ios::floatfield);
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto delim = [&]() -> std::ostream & { out << (first ? "\n" : ",\n"); first = false; return out; };
+    delim() << "{\"ph\":\"M\",\"pid\":1,\"tid\":0,\"name\":\"process_name\",\"args\":{\"name\":\"mutable\"}}";
+    for (auto &[tid, name] : thread_names_) {
+        delim() << "{\"ph\":\"M\",\"pid\":1,\"tid\":" << tid << ",\"name\":\"thread_name\",\"args\":{\"name\":\""
+                << escape(name) << "\"}}";
+    }
+    for (auto &e : events_) {
+        delim() << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << e.tid << ",\"cat\":\"" << e.category << "\",\"name\":\""
+                << escape(e.name) << "\",\"ts\":" << us(e.begin - origin_) << ",\"dur\":" << us(e.end - e.begin);
+        if (not e.args.empty()) {
+            out << ",\"args\":{";
+            for (auto it = e.args.begin(); it != e.args.end(); ++it) {
+                if (it != e.args.begin()) out << ',';
+                out << '"' << escape(it->first) << "\":" << it->second;
+            }
+            out << '}';
+        }
+        out << '}';
+    }
+    out << "\n]}" << std::endl;
+
+    out.flags(old_flags);
+    out.precision(old_precision);
+}
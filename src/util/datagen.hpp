@@ -1,6 +1,9 @@
 #pragma once
 
 #include "util/GridSearch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 #include <random>
 #include <type_traits>
 #include <utility>
@@ -29,6 +32,100 @@ std::vector<T> generate_uniform_distinct_numbers(const T min, const T max, const
     return values;
 }
 
+/** Draws a uniform random sample of `k` distinct indices from the range [0, `n`) and returns them in ascending order.
+ * If `k` is at least `n`, all indices are returned.  Uses reservoir sampling with Li's *Algorithm L*, which computes how
+ * many indices to skip rather than drawing a random number per index, and hence runs in time O(k (1 + log(n/k))).  Uses
+ * generator `g` for randomness.  */
+template<typename Generator = std::mt19937_64>
+std::vector<std::size_t> reservoir_sample(const std::size_t n, const std::size_t k, Generator &&g = Generator())
+{
+    std::vector<std::size_t> sample(std::min(n, k));
+    std::iota(sample.begin(), sample.end(), 0);
+    if (k == 0 or k >= n) return sample;
+
+    std::uniform_real_distribution<double> dist(0., 1.);
+    std::uniform_int_distribution<std::size_t> slot(0, k - 1);
+    /* Draws from the open interval (0, 1) to keep the logarithms finite. */
+    auto u = [&]() { double x; do x = dist(g); while (x == 0.); return x; };
+
+    double w = std::exp(std::log(u()) / k);
+    std::size_t i = k - 1;
+    for (;;) {
+        const double skip = std::floor(std::log(u()) / std::log1p(-w));
+        if (skip >= double(n - i - 1)) break; // skipped past the last index
+        i += std::size_t(skip) + 1;
+        sample[slot(g)] = i;
+        w *= std::exp(std::log(u()) / k);
+    }
+
+    std::sort(sample.begin(), sample.end());
+    return sample;
+}
+
+/** A Zipfian distribution over the integers [0, `n`), where the integer `k` is drawn with probability proportional
+ * to 1 / (`k` + 1)^`s`.  Hence, 0 is the most frequent value.  An exponent `s` of 0 yields the uniform distribution.
+ * Sampling takes expected constant time and no precomputed tables, using the rejection-inversion method by Hörmann
+ * and Derflinger. */
+template<typename T = uint64_t>
+struct zipf_distribution
+{
+    static_assert(std::is_integral_v<T>, "T must be an integral type");
+    using result_type = T;
+
+    private:
+    uint64_t n_; ///< number of distinct values
+    double s_; ///< the exponent
+    double h_integral_x1_;
+    double h_integral_n_;
+    double threshold_;
+
+    public:
+    zipf_distribution(uint64_t n, double s)
+        : n_(n)
+        , s_(s)
+    {
+        M_insist(n >= 1, "distribution requires at least one value");
+        M_insist(s >= 0, "exponent must not be negative");
+        h_integral_x1_ = h_integral(1.5) - 1.;
+        h_integral_n_ = h_integral(n + .5);
+        threshold_ = 2. - h_integral_inverse(h_integral(2.5) - h(2.));
+    }
+
+    uint64_t n() const { return n_; }
+    double s() const { return s_; }
+
+    template<typename Generator>
+    T operator()(Generator &&g) const {
+        std::uniform_real_distribution<double> dist(0., 1.);
+        for (;;) {
+            const double u = h_integral_n_ + dist(g) * (h_integral_x1_ - h_integral_n_);
+            const double x = h_integral_inverse(u);
+            uint64_t k = std::clamp<double>(x + .5, 1., n_);
+            if (k - x <= threshold_ or u >= h_integral(k + .5) - h(k))
+                return T(k - 1);
+        }
+    }
+
+    private:
+    double h(double x) const { return std::exp(-s_ * std::log(x)); }
+    double h_integral(double x) const {
+        const double log_x = std::log(x);
+        return helper2((1. - s_) * log_x) * log_x;
+    }
+    double h_integral_inverse(double x) const {
+        const double t = std::max(-1., x * (1. - s_));
+        return std::exp(helper1(t) * x);
+    }
+    /** Computes `log1p(x) / x` and is numerically stable for `x` close to 0. */
+    static double helper1(double x) {
+        return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1. - x * (.5 - x * (1. / 3. - .25 * x));
+    }
+    /** Computes `expm1(x) / x` and is numerically stable for `x` close to 0. */
+    static double helper2(double x) {
+        return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1. + x * .5 * (1. + x / 3. * (1. + .25 * x));
+    }
+};
+
 }
 
 }
@@ -5,16 +5,21 @@
 #include <climits>
 #include <cstring>
 #include <exception>
+#include <fstream>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 #if __linux
 #include <sys/mman.h>
+#include <sys/resource.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 #elif __APPLE__
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/resource.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #endif
@@ -103,6 +108,27 @@ void Memory::map(std::size_t size, std::size_t offset_src, const AddressSpace &v
         throw std::runtime_error("MAP_FIXED failed");
 }
 
+void Memory::map_private(std::size_t size, std::size_t offset_src, const AddressSpace &vm, std::size_t offset_dst) const
+{
+    M_insist(size <= this->size(), "size exceeds memory size");
+    M_insist(offset_src < this->size(), "source offset out of bounds");
+    M_insist(Is_Page_Aligned(offset_src), "source offset is not page aligned");
+    M_insist(offset_src + size <= this->size(), "source range out of bounds");
+
+    M_insist(size <= vm.size(), "size exceeds address space");
+    M_insist(offset_dst < vm.size(), "destination offset out of bounds");
+    M_insist(Is_Page_Aligned(offset_dst), "destination offset is not page aligned");
+    M_insist(offset_dst + size <= vm.size(), "destination range out of bounds");
+
+    void *dst_addr = vm.as<uint8_t*>() + offset_dst;
+    void *addr = mmap(dst_addr, size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_FIXED, allocator().fd(),
+                      this->offset() + offset_src);
+    if (addr == MAP_FAILED)
+        throw std::runtime_error(strerror(errno));
+    if (addr != dst_addr)
+        throw std::runtime_error("MAP_FIXED failed");
+}
+
 M_LCOV_EXCL_START
 void Memory::dump(std::ostream &out) const
 {
@@ -198,3 +224,67 @@ void LinearAllocator::deallocate(Memory &&mem)
      * Memory has been preallocated because resizing with `ftruncate()` is not supported on macOS.  */
 #endif
 }
+
+
+/*======================================================================================================================
+ * Copy-on-write
+ *====================================================================================================================*/
+
+void m::memory::make_private(void *addr, std::size_t size)
+{
+    M_insist(Is_Page_Aligned(reinterpret_cast<uintptr_t>(addr)), "address must be page aligned");
+    /* Writing to a page of a private mapping makes the kernel copy the page.  Write back the value just read, such
+     * that concurrent readers of the mapping never observe a different value. */
+    const std::size_t page_size = get_pagesize();
+    for (auto page = reinterpret_cast<volatile uint8_t*>(addr), end = page + size; page < end; page += page_size)
+        *page = *page;
+}
+
+
+/*======================================================================================================================
+ * Memory usage
+ *====================================================================================================================*/
+
+std::size_t m::memory::resident_bytes(const void *addr, std::size_t size)
+{
+    if (size == 0) return 0;
+    M_insist(Is_Page_Aligned(reinterpret_cast<uintptr_t>(addr)), "address must be page aligned");
+    const std::size_t num_pages = Ceil_To_Next_Page(size) / get_pagesize();
+#if __linux
+    std::vector<unsigned char> vec(num_pages);
+#elif __APPLE__
+    std::vector<char> vec(num_pages);
+#endif
+    if (mincore(const_cast<void*>(addr), size, vec.data()))
+        throw std::runtime_error(strerror(errno));
+    std::size_t num_resident = 0;
+    for (auto v : vec)
+        num_resident += v & 0x1; // least significant bit indicates residency, others are undefined
+    return num_resident * get_pagesize();
+}
+
+usage_t usage_t::Get()
+{
+    usage_t usage;
+#if __linux
+    /* `/proc/self/status` reports both current and peak resident set size in kB. */
+    std::ifstream status("/proc/self/status");
+    for (std::string line; std::getline(status, line); ) {
+        if (line.starts_with("VmRSS:"))
+            usage.resident = std::stoul(line.substr(6)) * 1024UL;
+        else if (line.starts_with("VmHWM:"))
+            usage.peak_resident = std::stoul(line.substr(6)) * 1024UL;
+    }
+#endif
+    if (usage.peak_resident == 0) {
+        struct rusage ru;
+        if (getrusage(RUSAGE_SELF, &ru) == 0) {
+#if __APPLE__
+            usage.peak_resident = ru.ru_maxrss; // in bytes
+#else
+            usage.peak_resident = ru.ru_maxrss * 1024UL; // in kB
+#endif
+        }
+    }
+    return usage;
+}
@@ -646,6 +646,44 @@ TEST_CASE("AStar_Clique_TopDown_sum", "[core][IR]")
         CHECK(SM.num_regular_to_beam() == 0);
         CHECK(SM.num_none_to_beam() == 0);
     }
+
+    SECTION("TopDown_sum_parallel")
+    {
+        /* Run heuristic search with multiple threads. */
+        using H = heuristics::sum<PlanTable, State, expansions::TopDownComplete>;
+
+        using SearchAlgorithm = ai::genericAStar<
+            State, expansions::TopDownComplete, H, config::AStar,
+            /*----- context -----*/
+            PlanTable&,
+            const QueryGraph&,
+            const AdjacencyMatrix&,
+            const CostFunction&,
+            const CardinalityEstimator&
+        >;
+
+        SearchAlgorithm S(plan_table, G, M, C_out, db.cardinality_estimator());
+        ai::SearchConfiguration<config::AStar> config = {};
+        config.num_threads = 4;
+
+        bool search_result = heuristic_search<PlanTable,
+                                              search_states::SubproblemsArray,
+                                              expansions::TopDownComplete,
+                                              SearchAlgorithm,
+                                              heuristics::sum,
+                                              config::AStar
+                                              >(plan_table, G, M, C_out, db.cardinality_estimator(), S, config);
+
+        /* Fill `expected` with the anticipated plan. */
+        expected.update(G, db.cardinality_estimator(), C_out, R0, R2, condition);
+        expected.update(G, db.cardinality_estimator(), C_out, R1, R3, condition);
+        expected.update(G, db.cardinality_estimator(), C_out, R0|R2, R1|R3, condition);
+
+        /* With an admissible heuristic, expanding states in parallel must still find the optimal plan. */
+        CHECK(search_result == true);
+        CHECK(expected == plan_table);
+        CHECK(plan_table[All].cost == 4130);
+    }
 }
 
 
@@ -2818,6 +2856,44 @@ TEST_CASE("AnytimeAStar_BottomUp_path_completion", "[core][IR]")
         CHECK(SM.num_regular_to_beam() == 0);
         CHECK(SM.num_none_to_beam() == 0);
     }
+
+    SECTION("BottomUp_zero_parallel")
+    {
+        /* Run heuristic search with multiple threads. */
+        using H = heuristics::zero<PlanTable, State, expansions::BottomUpComplete>;
+
+        using SearchAlgorithm = ai::genericAStar<
+            State, expansions::BottomUpComplete, H, config::AStar,
+            /*----- context -----*/
+            PlanTable&,
+            const QueryGraph&,
+            const AdjacencyMatrix&,
+            const CostFunction&,
+            const CardinalityEstimator&
+        >;
+
+        SearchAlgorithm S(plan_table, G, M, C_out, db.cardinality_estimator());
+        ai::SearchConfiguration<config::AStar> config = {};
+        config.num_threads = 4;
+
+        bool search_result = heuristic_search<PlanTable,
+                                              search_states::SubproblemsArray,
+                                              expansions::BottomUpComplete,
+                                              SearchAlgorithm,
+                                              heuristics::zero,
+                                              config::AStar
+                                              >(plan_table, G, M, C_out, db.cardinality_estimator(), S, config);
+
+        /* Fill `expected` with the anticipated plan. */
+        expected.update(G, db.cardinality_estimator(), C_out, R1, R2, condition);
+        expected.update(G, db.cardinality_estimator(), C_out, R0 , R3, condition);
+        expected.update(G, db.cardinality_estimator(), C_out, R1|R2 , R0|R3 , condition);
+
+        /* With an admissible heuristic, expanding states in parallel must still find the optimal plan. */
+        CHECK(search_result == true);
+        CHECK(expected == plan_table);
+        CHECK(plan_table[All].cost == 15250);
+    }
 }
 
 
@@ -1111,6 +1111,36 @@ TEST_CASE("GraphBuilder/SelectStmt", "[core][IR][unit]")
             REQUIRE(aggregates.empty());
         }
 
+        SECTION("test distinct groups by results")
+        {
+            const char *query = "SELECT DISTINCT A.val \
+                                 FROM A;";
+            auto stmt = as<SelectStmt>(m::statement_from_string(diag, query));
+            auto graph = QueryGraph::Build(*stmt);
+
+            auto group_by = graph->group_by();
+
+            REQUIRE(graph->projections().size() == 1);
+            REQUIRE(group_by.size() == 1);
+            REQUIRE(find_Expr(group_by, *A_val));
+            REQUIRE(graph->aggregates().empty());
+        }
+
+        SECTION("test distinct groups by equal results once")
+        {
+            const char *query = "SELECT DISTINCT A.val, A.val \
+                                 FROM A;";
+            auto stmt = as<SelectStmt>(m::statement_from_string(diag, query));
+            auto graph = QueryGraph::Build(*stmt);
+
+            auto group_by = graph->group_by();
+
+            REQUIRE(graph->projections().size() == 2);
+            REQUIRE(group_by.size() == 1);
+            REQUIRE(find_Expr(group_by, *A_val));
+            REQUIRE(graph->aggregates().empty());
+        }
+
         SECTION("test grouping with aggregate")
         {
             const char *query = "SELECT AVG(A.id) \
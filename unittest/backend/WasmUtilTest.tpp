@@ -1,5 +1,8 @@
 /* vim: set filetype=cpp: */
+#include "backend/WasmAlgo.hpp"
 #include "backend/WasmUtil.hpp"
+#include <cstring>
+#include <mutable/catalog/Catalog.hpp>
 
 #ifndef BACKEND_NAME
 #error "must define BACKEND_NAME before including this file"
@@ -423,6 +426,206 @@ TEST_CASE("Wasm/" BACKEND_NAME "/string comparison", "[core][wasm]")
         }
     }
 
+    SECTION("strcmp with long chars")
+    {
+        /* Strings spanning multiple chunks of 16 characters, compared chunk-wise. */
+        auto cs = m::Type::Get_Char(m::Type::TY_Scalar, 40);
+        auto cs_varchar = m::Type::Get_Varchar(m::Type::TY_Scalar, 40);
+        const char *str = "The quick brown fox jumps over the lazy";
+
+        auto check = [](const char *str_left, const char *str_right, const m::CharacterSequence *cs, cmp_op op) {
+            FUNCTION(test, void(void)) {
+                auto left = Module::Allocator().malloc<char>(40);
+                auto right = Module::Allocator().malloc<char>(40);
+                for (int32_t i = 0; i != 40; ++i) {
+                    *(left + i) = str_left[i];
+                    *(right + i) = str_right[i];
+                }
+                auto res = strcmp(NChar(left, false, cs), NChar(right, false, cs), op);
+                WASM_CHECK(res.is_true_and_not_null(), "result mismatch");
+            }
+            REQUIRE_NOTHROW(INVOKE(test));
+        };
+
+        SECTION("equal")
+        {
+            check(str, str, cs, EQ);
+            check(str, str, cs_varchar, EQ);
+        }
+
+        SECTION("differ in first chunk")
+        {
+            check("The quick brown Fox jumps over the lazy", str, cs, LT);
+            check(str, "The quick brown Fox jumps over the lazy", cs, GT);
+        }
+
+        SECTION("differ in last chunk")
+        {
+            check(str, "The quick brown fox jumps over the lazY", cs, GT);
+            check("The quick brown fox jumps over the lazY", str, cs_varchar, LT);
+        }
+
+        SECTION("equal up to terminating NUL byte")
+        {
+            check("The quick brown fox jumps\0over the lazy", "The quick brown fox jumps\0OVER THE LAZY", cs_varchar,
+                  EQ);
+            check("The quick brown fox jumps\0over the lazy", str, cs_varchar, LT);
+        }
+    }
+
+    CodeGenContext::Dispose();
+    Module::Dispose();
+}
+
+TEST_CASE("Wasm/" BACKEND_NAME "/like_contains", "[core][wasm]")
+{
+    Module::Init();
+    CodeGenContext::Init();
+
+    auto cs = m::Type::Get_Varchar(m::Type::TY_Scalar, 48);
+    const char *str = "The quick brown fox jumps over the lazy dog";
+    const int32_t len = strlen(str);
+
+    auto check = [&](const char *pattern, bool expected) {
+        FUNCTION(test, void(void)) {
+            auto s = Module::Allocator().malloc<char>(48);
+            for (int32_t i = 0; i != 48; ++i)
+                *(s + i) = i < len ? str[i] : '\0';
+            auto res = like_contains(NChar(s, false, cs), m::Catalog::Get().pool(pattern));
+            WASM_CHECK(expected ? res.is_true_and_not_null() : res.is_false_and_not_null(), "result mismatch");
+        }
+        REQUIRE_NOTHROW(INVOKE(test));
+    };
+
+    SECTION("found in first chunk") { check("%quick%", true); }
+    SECTION("found in second chunk") { check("%fox jumps over%", true); }
+    SECTION("found in remainder") { check("%lazy dog%", true); }
+    SECTION("single character") { check("%z%", true); }
+    SECTION("candidate without match") { check("%fax%", false); }
+    SECTION("not found") { check("%cat%", false); }
+
+    CodeGenContext::Dispose();
+    Module::Dispose();
+}
+
+TEST_CASE("Wasm/" BACKEND_NAME "/str_hash", "[core][wasm]")
+{
+    Module::Init();
+    CodeGenContext::Init();
+
+    auto cs = m::Type::Get_Char(m::Type::TY_Scalar, 21);
+
+    /* Hashes `str` stored in a buffer of 21 characters filled with `fill` after the terminating NUL byte. */
+    auto hash = [&](const char *str, char fill) {
+        const int32_t len = strlen(str);
+        auto s = Module::Allocator().malloc<char>(21);
+        for (int32_t i = 0; i != 21; ++i)
+            *(s + i) = i < len ? str[i] : (i == len ? '\0' : fill);
+        return str_hash(NChar(s, false, cs));
+    };
+
+    SECTION("characters after NUL byte are ignored")
+    {
+        FUNCTION(test, void(void)) {
+            WASM_CHECK(hash("The quick brown", '\0') == hash("The quick brown", 'x'), "hash mismatch");
+            WASM_CHECK(hash("quick", '\0') == hash("quick", 'x'), "hash mismatch");
+            WASM_CHECK(hash("", '\0') == hash("", 'x'), "hash mismatch");
+        }
+        REQUIRE_NOTHROW(INVOKE(test));
+    }
+
+    SECTION("declared length is ignored")
+    {
+        auto cs_short = m::Type::Get_Char(m::Type::TY_Scalar, 12);
+
+        /* Hashes `str` stored in a zero-filled buffer of 12 characters. */
+        auto hash_short = [&](const char *str) {
+            const int32_t len = strlen(str);
+            auto s = Module::Allocator().malloc<char>(12);
+            for (int32_t i = 0; i != 12; ++i)
+                *(s + i) = i < len ? str[i] : '\0';
+            return str_hash(NChar(s, false, cs_short));
+        };
+
+        FUNCTION(test, void(void)) {
+            WASM_CHECK(hash("The quick", '\0') == hash_short("The quick"), "hash mismatch");
+            WASM_CHECK(hash("The quic", '\0') == hash_short("The quic"), "hash mismatch");
+            WASM_CHECK(hash("quick", '\0') == hash_short("quick"), "hash mismatch");
+            WASM_CHECK(hash("The quick br", '\0') == hash_short("The quick br"), "hash mismatch");
+            WASM_CHECK(hash("", '\0') == hash_short(""), "hash mismatch");
+        }
+        REQUIRE_NOTHROW(INVOKE(test));
+    }
+
+    SECTION("unaligned strings")
+    {
+        /* Hashes `str` stored at an odd address, such that complete words are loaded unaligned. */
+        auto hash_unaligned = [&](const char *str) {
+            const int32_t len = strlen(str);
+            Var<Ptr<Charx1>> s(Module::Allocator().malloc<char>(22) + 1);
+            for (int32_t i = 0; i != 21; ++i)
+                *(s + i) = i < len ? str[i] : '\0';
+            return str_hash(NChar(s, false, cs));
+        };
+
+        FUNCTION(test, void(void)) {
+            WASM_CHECK(hash("The quick brown", '\0') == hash_unaligned("The quick brown"), "hash mismatch");
+            WASM_CHECK(hash("The quick brown fox", '\0') == hash_unaligned("The quick brown fox"), "hash mismatch");
+            WASM_CHECK(hash("quick", '\0') == hash_unaligned("quick"), "hash mismatch");
+        }
+        REQUIRE_NOTHROW(INVOKE(test));
+    }
+
+    SECTION("distinct strings")
+    {
+        FUNCTION(test, void(void)) {
+            WASM_CHECK(hash("The quick brown", '\0') != hash("The quick browm", '\0'), "hash collision");
+            WASM_CHECK(hash("The quick brown fox", '\0') != hash("The quick brown fix", '\0'), "hash collision");
+            WASM_CHECK(hash("quick", '\0') != hash("quick brown", '\0'), "hash collision");
+        }
+        REQUIRE_NOTHROW(INVOKE(test));
+    }
+
+    CodeGenContext::Dispose();
+    Module::Dispose();
+}
+
+TEST_CASE("Wasm/" BACKEND_NAME "/murmur3_64a_hash", "[core][wasm]")
+{
+    Module::Init();
+    CodeGenContext::Init();
+
+    auto i4 = m::Type::Get_Integer(m::Type::TY_Scalar, 4);
+
+    /* Hashes the composite key of four `INT(4)` values, which are packed into two words. */
+    auto hash = [&](int32_t a, int32_t b, int32_t c, int32_t d) {
+        std::vector<std::pair<const m::Type*, SQL_t>> values;
+        for (int32_t v : { a, b, c, d })
+            values.emplace_back(i4, _I32x1(v));
+        return murmur3_64a_hash(std::move(values));
+    };
+
+    SECTION("equal keys")
+    {
+        FUNCTION(test, void(void)) {
+            WASM_CHECK(hash(1, 2, 3, 4) == hash(1, 2, 3, 4), "hash mismatch");
+            WASM_CHECK(hash(0, 0, 0, 0) == hash(0, 0, 0, 0), "hash mismatch");
+        }
+        REQUIRE_NOTHROW(INVOKE(test));
+    }
+
+    SECTION("keys differing in a single field")
+    {
+        FUNCTION(test, void(void)) {
+            WASM_CHECK(hash(1, 2, 3, 4) != hash(0, 2, 3, 4), "hash collision");
+            WASM_CHECK(hash(1, 2, 3, 4) != hash(1, 0, 3, 4), "hash collision");
+            WASM_CHECK(hash(1, 2, 3, 4) != hash(1, 2, 0, 4), "hash collision");
+            WASM_CHECK(hash(1, 2, 3, 4) != hash(1, 2, 3, 0), "hash collision");
+            WASM_CHECK(hash(1, 2, 3, 4) != hash(2, 1, 3, 4), "hash collision");
+        }
+        REQUIRE_NOTHROW(INVOKE(test));
+    }
+
     CodeGenContext::Dispose();
     Module::Dispose();
 }
@@ -1,10 +1,14 @@
 #include "catch2/catch.hpp"
 
+#include "backend/Interpreter.hpp"
 #include "parse/Parser.hpp"
 #include "parse/Sema.hpp"
 #include <cstring>
 #include <mutable/catalog/CardinalityEstimator.hpp>
 #include <mutable/catalog/Catalog.hpp>
+#include <mutable/catalog/CostFunctionCout.hpp>
+#include <mutable/IR/PlanEnumerator.hpp>
+#include <mutable/IR/PlanTable.hpp>
 #include <mutable/mutable.hpp>
 #include <mutable/util/ADT.hpp>
 #include <sstream>
@@ -267,3 +271,282 @@ TEST_CASE("Cartesian estimator estimates", "[core][catalog][cardinality]")
         CHECK(CE.predict_cardinality(*join_model) == 50);
     }
 }
+
+TEST_CASE("Feedback estimator estimates", "[core][catalog][cardinality]")
+{
+    using Subproblem = SmallBitset;
+    /* Get Catalog and create new database to use for unit testing. */
+    Catalog::Clear();
+    Catalog &Cat = Catalog::Get();
+    auto &db = Cat.add_database(Cat.pool("db"));
+    Cat.set_database_in_use(db);
+
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+
+    /* Create pooled strings. */
+    ThreadSafePooledString str_A = Cat.pool("A");
+    ThreadSafePooledString str_B = Cat.pool("B");
+    ThreadSafePooledString str_C = Cat.pool("C");
+
+    ThreadSafePooledString col_id  = Cat.pool("id");
+    ThreadSafePooledString col_aid = Cat.pool("aid");
+
+    /* Create tables. */
+    Table &tbl_A = db.add_table(str_A);
+    Table &tbl_B = db.add_table(str_B);
+    Table &tbl_C = db.add_table(str_C);
+
+    /* Add columns to tables. */
+    tbl_A.push_back(col_id, Type::Get_Integer(Type::TY_Vector, 4));
+    tbl_B.push_back(col_id, Type::Get_Integer(Type::TY_Vector, 4));
+    tbl_B.push_back(col_aid, Type::Get_Integer(Type::TY_Vector, 4));
+    tbl_C.push_back(col_id, Type::Get_Integer(Type::TY_Vector, 4));
+    tbl_C.push_back(col_aid, Type::Get_Integer(Type::TY_Vector, 4));
+
+    /* Add data to tables. */
+    std::size_t num_rows_A = 5;
+    std::size_t num_rows_B = 10;
+    std::size_t num_rows_C = 8;
+    tbl_A.store(Cat.create_store(tbl_A));
+    tbl_B.store(Cat.create_store(tbl_B));
+    tbl_C.store(Cat.create_store(tbl_C));
+    tbl_A.layout(Cat.data_layout());
+    tbl_B.layout(Cat.data_layout());
+    tbl_C.layout(Cat.data_layout());
+    for (std::size_t i = 0; i < num_rows_A; ++i) { tbl_A.store().append(); }
+    for (std::size_t i = 0; i < num_rows_B; ++i) { tbl_B.store().append(); }
+    for (std::size_t i = 0; i < num_rows_C; ++i) { tbl_C.store().append(); }
+
+    /* Define query:
+     *
+     * A -- B -- C
+     */
+    const char *query = "SELECT * \
+                         FROM A, B, C \
+                         WHERE A.id = C.aid AND A.id = B.aid;";
+    auto S = m::statement_from_string(diag, query);
+    M_insist(diag.num_errors() == 0);
+    auto G = QueryGraph::Build(*S);
+    FeedbackCardinalityEstimator CE(Cat.pool("db"), std::make_unique<CartesianProductEstimator>());
+    CE.observe({ "A" }, 2);
+
+    SECTION("estimate_scan")
+    {
+        auto scan_model_one = CE.estimate_scan(*G, Subproblem::Singleton(0));
+        auto scan_model_two = CE.estimate_scan(*G, Subproblem::Singleton(1));
+        CHECK(CE.predict_cardinality(*scan_model_one) == 2); // observed
+        CHECK(CE.predict_cardinality(*scan_model_two) == 10); // estimated
+    }
+
+    SECTION("estimate_filter")
+    {
+        auto scan_model = CE.estimate_scan(*G, Subproblem::Singleton(1));
+        cnf::CNF filter;
+        auto filter_model = CE.estimate_filter(*G, *scan_model, filter);
+        CHECK(CE.predict_cardinality(*filter_model) == 10);
+
+        CE.observe({ "B" }, 4);
+        filter_model = CE.estimate_filter(*G, *scan_model, filter);
+        CHECK(CE.predict_cardinality(*filter_model) == 4);
+    }
+
+    SECTION("estimate_limit")
+    {
+        auto scan_model = CE.estimate_scan(*G, Subproblem::Singleton(0));
+        auto limit_model_high = CE.estimate_limit(*G, *scan_model, 5000, 0);
+        auto limit_model_low = CE.estimate_limit(*G, *scan_model, 1, 0);
+        auto limit_model_offset = CE.estimate_limit(*G, *scan_model, 5000, 3);
+        CHECK(CE.predict_cardinality(*limit_model_high) == 2);
+        CHECK(CE.predict_cardinality(*limit_model_low) == 1);
+        CHECK(CE.predict_cardinality(*limit_model_offset) == 0);
+    }
+
+    SECTION("estimate_join")
+    {
+        auto scan_model_one = CE.estimate_scan(*G, Subproblem::Singleton(0));
+        auto scan_model_two = CE.estimate_scan(*G, Subproblem::Singleton(1));
+        cnf::CNF condition;
+
+        /* The estimate is corrected by the factor by which the estimate of A was off, i.e. 2/5. */
+        auto join_model = CE.estimate_join(*G, *scan_model_one, *scan_model_two, condition);
+        CHECK(CE.predict_cardinality(*join_model) == 20);
+
+        /* The join is keyed by the join predicates of the query graph, independent of the condition passed. */
+        CE.observe({ "B", "A" }, 7);
+        join_model = CE.estimate_join(*G, *scan_model_two, *scan_model_one, condition);
+        CHECK(CE.predict_cardinality(*join_model) == 20);
+
+        CE.observe({ "B", "A" }, 7, { "(A.id = B.aid)" });
+        join_model = CE.estimate_join(*G, *scan_model_two, *scan_model_one, condition);
+        CHECK(CE.predict_cardinality(*join_model) == 7);
+        CHECK(CE.num_observations() == 3);
+    }
+}
+
+TEST_CASE("Feedback estimator learns from execution", "[core][catalog][cardinality]")
+{
+    using Subproblem = SmallBitset;
+    Catalog::Clear();
+    Catalog &Cat = Catalog::Get();
+    auto &db = Cat.add_database(Cat.pool("db"));
+    Cat.set_database_in_use(db);
+
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+
+    /* Create and fill tables.  Every row of B joins with exactly one row of A. */
+    Table &tbl_A = db.add_table(Cat.pool("A"));
+    Table &tbl_B = db.add_table(Cat.pool("B"));
+    tbl_A.push_back(Cat.pool("id"), Type::Get_Integer(Type::TY_Vector, 4));
+    tbl_B.push_back(Cat.pool("id"), Type::Get_Integer(Type::TY_Vector, 4));
+    tbl_B.push_back(Cat.pool("aid"), Type::Get_Integer(Type::TY_Vector, 4));
+    for (auto tbl : { &tbl_A, &tbl_B }) {
+        tbl->layout(Cat.data_layout());
+        tbl->store(Cat.create_store(*tbl));
+    }
+    execute_statement(diag, *statement_from_string(diag, "INSERT INTO A VALUES (0), (1), (2), (3), (4);"));
+    execute_statement(diag, *statement_from_string(diag, "INSERT INTO B VALUES (0, 0), (1, 1), (2, 2), (3, 0), (4, 1), "
+                                                         "(5, 2), (6, 0), (7, 1), (8, 2), (9, 0);"));
+    REQUIRE(diag.num_errors() == 0);
+
+    db.cardinality_estimator(
+        std::make_unique<FeedbackCardinalityEstimator>(Cat.pool("db"), std::make_unique<CartesianProductEstimator>())
+    );
+    auto &CE = as<FeedbackCardinalityEstimator>(db.cardinality_estimator());
+
+    /* Execute a query and feed the observed cardinalities back to the estimator. */
+    {
+        auto stmt = statement_from_string(diag, "SELECT * FROM A AS a, B AS b WHERE a.id = b.aid AND b.id < 4;");
+        REQUIRE(diag.num_errors() == 0);
+        auto logical_plan = logical_plan_from_statement(diag, as<const SelectStmt>(*stmt),
+                                                        std::make_unique<NoOpOperator>(out));
+        Interpreter I;
+        auto physical_plan = physical_plan_from_logical_plan(diag, *logical_plan, I);
+        execute_physical_plan(diag, *physical_plan, I);
+        CE.feedback(*logical_plan);
+    }
+    REQUIRE(CE.num_observations() != 0);
+
+    SECTION("observations carry over to other aliases")
+    {
+        auto stmt = statement_from_string(diag, "SELECT * FROM A AS x, B AS y WHERE x.id = y.aid AND y.id < 4;");
+        REQUIRE(diag.num_errors() == 0);
+        auto G = QueryGraph::Build(*stmt);
+        REQUIRE(G->joins().size() == 1);
+
+        auto scan_A = CE.estimate_scan(*G, Subproblem::Singleton(0));
+        auto scan_B = CE.estimate_scan(*G, Subproblem::Singleton(1));
+        auto filter_B = CE.estimate_filter(*G, *scan_B, G->sources()[1]->filter());
+        auto join = CE.estimate_join(*G, *scan_A, *filter_B, G->joins()[0]->condition());
+        CHECK(CE.predict_cardinality(*scan_A) == 5);
+        CHECK(CE.predict_cardinality(*scan_B) == 10);
+        CHECK(CE.predict_cardinality(*filter_B) == 4);
+        CHECK(CE.predict_cardinality(*join) == 4);
+    }
+
+    SECTION("observations do not carry over to other join predicates")
+    {
+        auto stmt = statement_from_string(diag, "SELECT * FROM A AS x, B AS y WHERE x.id = y.id AND y.id < 4;");
+        REQUIRE(diag.num_errors() == 0);
+        auto G = QueryGraph::Build(*stmt);
+        REQUIRE(G->joins().size() == 1);
+
+        auto scan_A = CE.estimate_scan(*G, Subproblem::Singleton(0));
+        auto scan_B = CE.estimate_scan(*G, Subproblem::Singleton(1));
+        auto filter_B = CE.estimate_filter(*G, *scan_B, G->sources()[1]->filter());
+        auto join = CE.estimate_join(*G, *scan_A, *filter_B, G->joins()[0]->condition());
+        CHECK(CE.predict_cardinality(*filter_B) == 4);
+        /* The estimate of 50 is corrected by the factor by which the estimate of the filter was off, i.e. 4/10. */
+        CHECK(CE.predict_cardinality(*join) == 20);
+    }
+}
+
+TEST_CASE("Feedback estimator corrects join orders", "[core][catalog][cardinality]")
+{
+    using Subproblem = SmallBitset;
+    using PlanTable = PlanTableSmallOrDense;
+    Catalog::Clear();
+    Catalog &Cat = Catalog::Get();
+    auto &db = Cat.add_database(Cat.pool("db"));
+    Cat.set_database_in_use(db);
+
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+
+    /* Create and fill tables.  Every row of B joins with exactly one row of A, but no row of C joins with B. */
+    Table &tbl_A = db.add_table(Cat.pool("A"));
+    Table &tbl_B = db.add_table(Cat.pool("B"));
+    Table &tbl_C = db.add_table(Cat.pool("C"));
+    tbl_A.push_back(Cat.pool("id"), Type::Get_Integer(Type::TY_Vector, 4));
+    tbl_B.push_back(Cat.pool("id"), Type::Get_Integer(Type::TY_Vector, 4));
+    tbl_B.push_back(Cat.pool("aid"), Type::Get_Integer(Type::TY_Vector, 4));
+    tbl_C.push_back(Cat.pool("id"), Type::Get_Integer(Type::TY_Vector, 4));
+    tbl_C.push_back(Cat.pool("bid"), Type::Get_Integer(Type::TY_Vector, 4));
+    for (auto tbl : { &tbl_A, &tbl_B, &tbl_C }) {
+        tbl->layout(Cat.data_layout());
+        tbl->store(Cat.create_store(*tbl));
+    }
+    execute_statement(diag, *statement_from_string(diag, "INSERT INTO A VALUES (0), (1), (2), (3), (4);"));
+    execute_statement(diag, *statement_from_string(diag, "INSERT INTO B VALUES (0, 0), (1, 1), (2, 2), (3, 0), (4, 1), "
+                                                         "(5, 2), (6, 0), (7, 1), (8, 2), (9, 0);"));
+    execute_statement(diag, *statement_from_string(diag, "INSERT INTO C VALUES (0, 100), (1, 100), (2, 100), "
+                                                         "(3, 100), (4, 100), (5, 100), (6, 100), (7, 100);"));
+    REQUIRE(diag.num_errors() == 0);
+
+    db.cardinality_estimator(
+        std::make_unique<FeedbackCardinalityEstimator>(Cat.pool("db"), std::make_unique<CartesianProductEstimator>())
+    );
+    auto &CE = as<FeedbackCardinalityEstimator>(db.cardinality_estimator());
+
+    /* Define query:
+     *
+     * A -- B -- C
+     */
+    auto stmt = statement_from_string(diag, "SELECT * FROM A, B, C WHERE A.id = B.aid AND B.id = C.bid;");
+    REQUIRE(diag.num_errors() == 0);
+    auto G = QueryGraph::Build(*stmt);
+    const Subproblem A(1), B(2), C(4);
+
+    /* Enumerates the join orders of `G` with DPccp, like the optimizer does. */
+    CostFunctionCout C_out;
+    auto &PE = Cat.plan_enumerator(Cat.pool("DPccp"));
+    auto enumerate = [&]() {
+        PlanTable PT(*G);
+        for (auto &ds : G->sources()) {
+            Subproblem s = Subproblem::Singleton(ds->id());
+            PT[s].cost = 0;
+            PT[s].model = CE.estimate_scan(*G, s);
+        }
+        PE(*G, C_out, PT);
+        return PT;
+    };
+
+    /* The Cartesian product estimates |AB| = 50 and |BC| = 80.  Hence, A and B are joined first. */
+    {
+        auto PT = enumerate();
+        CHECK(CE.predict_cardinality(*PT[A|B].model) == 50);
+        CHECK(CE.predict_cardinality(*PT[B|C].model) == 80);
+        CHECK((PT.get_final().left == C or PT.get_final().right == C));
+    }
+
+    /* Execute a query joining B and C and feed the observed cardinalities back to the estimator. */
+    {
+        auto stmt = statement_from_string(diag, "SELECT * FROM B, C WHERE B.id = C.bid;");
+        REQUIRE(diag.num_errors() == 0);
+        auto logical_plan = logical_plan_from_statement(diag, as<const SelectStmt>(*stmt),
+                                                        std::make_unique<NoOpOperator>(out));
+        Interpreter I;
+        auto physical_plan = physical_plan_from_logical_plan(diag, *logical_plan, I);
+        execute_physical_plan(diag, *physical_plan, I);
+        CE.feedback(*logical_plan);
+    }
+
+    /* The enumerator now sees the observed |BC| = 0.  Hence, B and C are joined first. */
+    {
+        auto PT = enumerate();
+        CHECK(CE.predict_cardinality(*PT[A|B].model) == 50);
+        CHECK(CE.predict_cardinality(*PT[B|C].model) == 0);
+        CHECK((PT.get_final().left == A or PT.get_final().right == A));
+    }
+}
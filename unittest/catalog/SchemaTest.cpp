@@ -1,12 +1,16 @@
 #include "catch2/catch.hpp"
 
+#include "backend/Interpreter.hpp"
 #include <cmath>
 #include <cstring>
 #include <mutable/catalog/Catalog.hpp>
+#include <mutable/mutable.hpp>
+#include <mutable/storage/Index.hpp>
 #include <mutable/util/fn.hpp>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 
 using namespace m;
@@ -429,3 +433,49 @@ TEST_CASE("Database/add table error if name already taken", "[core][catalog][dat
     REQUIRE_THROWS_AS(D.add(std::move(R)), std::invalid_argument);
     Catalog::Clear();
 }
+
+TEST_CASE("Database/rows_appended", "[core][catalog][database]")
+{
+    Catalog::Clear();
+    Catalog &C = Catalog::Get();
+    Database &D = C.add_database(C.pool(get_unique_id()));
+    C.set_database_in_use(D);
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+
+    auto tbl_name = C.pool("T");
+    auto attr_name = C.pool("id");
+    Table &T = D.add_table(tbl_name);
+    T.push_back(attr_name, Type::Get_Integer(Type::TY_Vector, 4));
+    T.add_sort_key(attr_name, true);
+    T.layout(C.data_layout());
+    T.store(C.create_store(T));
+    D.add_index(std::make_unique<idx::ArrayIndex<int32_t>>(), tbl_name, attr_name, C.pool("T_id"));
+    REQUIRE(D.has_index(tbl_name, attr_name, idx::IndexMethod::Array));
+
+    SECTION("appending no rows keeps the indexes")
+    {
+        D.rows_appended(T, 0);
+        CHECK(D.has_index(tbl_name, attr_name, idx::IndexMethod::Array));
+    }
+
+    SECTION("INSERT restores the sort order and invalidates the indexes")
+    {
+        execute_statement(diag, *statement_from_string(diag, "INSERT INTO T VALUES (3), (1), (2);"));
+        REQUIRE(diag.num_errors() == 0);
+        CHECK_FALSE(D.has_index(tbl_name, attr_name, idx::IndexMethod::Array));
+
+        const Schema S = T.schema();
+        auto L = Interpreter::compile_load(S, T.store().memory().addr(), T.layout(), S, 0);
+        Tuple tup(S);
+        Tuple *args[] = { &tup };
+        std::vector<int64_t> ids;
+        for (std::size_t i = 0; i != T.store().num_rows(); ++i) {
+            L(args);
+            ids.push_back(tup.get(0).as_i());
+        }
+        CHECK(ids == std::vector<int64_t>{ 1, 2, 3 });
+    }
+
+    Catalog::Clear();
+}
@@ -574,6 +574,8 @@ TEST_CASE("Parser::parse_SelectClause()", "[core][parse][unit]")
         { "SELECT key * val AS mul", "SELECT (key * val) AS mul", TK_EOF },
         { "SELECT (key * val) AS mul", "SELECT (key * val) AS mul", TK_EOF },
         { "SELECT id AS i, (key * val) AS mul", "SELECT id AS i, (key * val) AS mul", TK_EOF },
+        { "SELECT DISTINCT *", "SELECT DISTINCT *", TK_EOF },
+        { "SELECT DISTINCT key, val AS v", "SELECT DISTINCT key, val AS v", TK_EOF },
         { "SELECT * AS star", "SELECT *", TK_As },
         { "SELECT id as i", "SELECT id AS as", TK_IDENTIFIER },
         { "SELECT T.42", "SELECT T", TK_DEC_FLOAT },
@@ -1186,6 +1188,12 @@ TEST_CASE("Parser::parse_CreateTableStmt()", "[core][parse][unit]")
           "CREATE TABLE t\n(\n    a BOOL PRIMARY KEY NOT NULL UNIQUE CHECK ((42 * b)) REFERENCES B(a)\n);", TK_EOF },
         { "CREATE TABLE t ( a BOOL, b DOUBLE )",
           "CREATE TABLE t\n(\n    a BOOL,\n    b DOUBLE\n);", TK_EOF },
+        { "CREATE TABLE t ( a BOOL, b DOUBLE ) ORDER BY b",
+          "CREATE TABLE t\n(\n    a BOOL,\n    b DOUBLE\n)\nORDER BY b ASC;", TK_EOF },
+        { "CREATE TABLE t ( a BOOL, b DOUBLE ) ORDER BY b DESC, a ASC",
+          "CREATE TABLE t\n(\n    a BOOL,\n    b DOUBLE\n)\nORDER BY b DESC, a ASC;", TK_EOF },
+        { "CREATE TABLE t ( a BOOL, b DOUBLE ) ORDER BY ( a, b DESC )",
+          "CREATE TABLE t\n(\n    a BOOL,\n    b DOUBLE\n)\nORDER BY a ASC, b DESC;", TK_EOF },
     };
 
     auto parse = [](ast::Parser &p) { return p.parse_CreateTableStmt(); };
@@ -1235,7 +1243,12 @@ TEST_CASE("Parser::parse_CreateTableStmt() sanity tests", "[core][parse][unit]")
             "CREATE TABLE 0 ( a BOOL )",
             "CREATE TABLE t ( 0 BOOL )",
             "CREATE TABLE t ( BOOL )",
-            "CREATE TABLE t ( a BOOL, )"
+            "CREATE TABLE t ( a BOOL, )",
+            "CREATE TABLE t ( a BOOL ) ORDER a",
+            "CREATE TABLE t ( a BOOL ) ORDER BY",
+            "CREATE TABLE t ( a BOOL ) ORDER BY 0",
+            "CREATE TABLE t ( a BOOL ) ORDER BY a,",
+            "CREATE TABLE t ( a BOOL ) ORDER BY ( a"
         };
 
         for (auto s : statements) {
@@ -1298,6 +1298,34 @@ TEST_CASE("Sema/Clauses/Select", "[core][parse][sema]")
         REQUIRE(diag.num_errors() == 0);
         REQUIRE(not err.str().empty());
     }
+
+    SECTION("SELECT DISTINCT.")
+    {
+        LEXER("SELECT DISTINCT v, w + 1 FROM mytable;");
+        Parser parser(lexer);
+        auto stmt = as<SelectStmt>(parser.parse());
+        REQUIRE(diag.num_errors() == 0);
+        REQUIRE(err.str().empty());
+        Sema sema(diag);
+        sema(*stmt);
+
+        REQUIRE(diag.num_errors() == 0);
+        REQUIRE(err.str().empty());
+    }
+
+    SECTION("SELECT DISTINCT with GROUP BY.")
+    {
+        LEXER("SELECT DISTINCT v FROM mytable GROUP BY v;");
+        Parser parser(lexer);
+        auto stmt = as<SelectStmt>(parser.parse());
+        REQUIRE(diag.num_errors() == 0);
+        REQUIRE(err.str().empty());
+        Sema sema(diag);
+        sema(*stmt);
+
+        REQUIRE(diag.num_errors() == 1);
+        REQUIRE(not err.str().empty());
+    }
 }
 
 TEST_CASE("Sema/Clauses/From", "[core][parse][sema]")
@@ -1797,6 +1825,34 @@ TEST_CASE("Sema/Clauses/OrderBy", "[core][parse][sema]")
         REQUIRE(not err.str().empty());
     }
 
+    SECTION("ORDER BY with DISTINCT is ok.")
+    {
+        LEXER("SELECT DISTINCT v AS x, b FROM mytable ORDER BY x, mytable.b;");
+        Parser parser(lexer);
+        auto stmt = as<SelectStmt>(parser.parse());
+        REQUIRE(diag.num_errors() == 0);
+        REQUIRE(err.str().empty());
+        Sema sema(diag);
+        sema(*stmt);
+
+        REQUIRE(diag.num_errors() == 0);
+        REQUIRE(err.str().empty());
+    }
+
+    SECTION("ORDER BY with DISTINCT is not a result.")
+    {
+        LEXER("SELECT DISTINCT b FROM mytable ORDER BY v;");
+        Parser parser(lexer);
+        auto stmt = as<SelectStmt>(parser.parse());
+        REQUIRE(diag.num_errors() == 0);
+        REQUIRE(err.str().empty());
+        Sema sema(diag);
+        sema(*stmt);
+
+        REQUIRE(diag.num_errors() == 1);
+        REQUIRE(not err.str().empty());
+    }
+
     SECTION("ORDER BY is not scalar and implicit grouping because of HAVING clause.")
     {
         LEXER("SELECT 1 FROM mytable HAVING SUM(v) > 42 ORDER BY b;");
@@ -2093,6 +2149,51 @@ TEST_CASE("Sema/Statements/CreateTable", "[core][parse][sema]")
             REQUIRE(not err.str().empty());
         }
 
+        SECTION("Create table with sort key.")
+        {
+            SECTION("Create table with sort key is ok.")
+            {
+                LEXER("CREATE TABLE my_table (x INT(4), y FLOAT) ORDER BY y DESC, x;");
+                Parser parser(lexer);
+                auto stmt = as<CreateTableStmt>(parser.parse());
+                REQUIRE(diag.num_errors() == 0);
+                REQUIRE(err.str().empty());
+                Sema sema(diag);
+                sema(*stmt);
+
+                REQUIRE(diag.num_errors() == 0);
+                REQUIRE(err.str().empty());
+            }
+
+            SECTION("Create table with sort key of unknown attribute.")
+            {
+                LEXER("CREATE TABLE my_table (x INT(4), y FLOAT) ORDER BY z;");
+                Parser parser(lexer);
+                auto stmt = as<CreateTableStmt>(parser.parse());
+                REQUIRE(diag.num_errors() == 0);
+                REQUIRE(err.str().empty());
+                Sema sema(diag);
+                sema(*stmt);
+
+                REQUIRE(diag.num_errors() == 1);
+                REQUIRE(not err.str().empty());
+            }
+
+            SECTION("Create table with duplicate attribute in sort key.")
+            {
+                LEXER("CREATE TABLE my_table (x INT(4), y FLOAT) ORDER BY (x, y, x DESC);");
+                Parser parser(lexer);
+                auto stmt = as<CreateTableStmt>(parser.parse());
+                REQUIRE(diag.num_errors() == 0);
+                REQUIRE(err.str().empty());
+                Sema sema(diag);
+                sema(*stmt);
+
+                REQUIRE(diag.num_errors() == 1);
+                REQUIRE(not err.str().empty());
+            }
+        }
+
         SECTION("Create table with constraints.")
         {
             SECTION("Create table with constraints is ok.")
@@ -0,0 +1,218 @@
+#include "catch2/catch.hpp"
+
+#include "backend/Interpreter.hpp"
+#include "storage/Clustering.hpp"
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/storage/DataLayoutFactory.hpp>
+#include <mutable/storage/Store.hpp>
+#include <optional>
+#include <vector>
+
+
+using namespace m;
+using namespace m::storage;
+
+
+TEST_CASE("merge_appended_rows", "[core][storage][clustering]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("$test_db"));
+    auto &table = DB.add_table(C.pool("T"));
+    table.push_back(C.pool("k"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.push_back(C.pool("v"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.store(C.create_store(C.pool("RowStore"), table));
+    table.layout(RowLayoutFactory());
+    auto &store = table.store();
+    const Schema S = table.schema();
+
+    /* Appends rows with key `k` and value `v`, where `std::nullopt` denotes a NULL key. */
+    auto append = [&](std::vector<std::pair<std::optional<int64_t>, int64_t>> rows) {
+        auto W = Interpreter::compile_store(S, store.memory().addr(), table.layout(), S, store.num_rows());
+        Tuple tup(S);
+        Tuple *args[] = { &tup };
+        for (auto [k, v] : rows) {
+            store.append();
+            if (k)
+                tup.set(0, *k);
+            else
+                tup.null(0);
+            tup.set(1, v);
+            W(args);
+        }
+    };
+    /* Returns all rows of the store, encoding a NULL key as `std::nullopt`. */
+    auto rows = [&]() {
+        std::vector<std::pair<std::optional<int64_t>, int64_t>> res;
+        auto L = Interpreter::compile_load(S, store.memory().addr(), table.layout(), S, 0);
+        Tuple tup(S);
+        Tuple *args[] = { &tup };
+        for (std::size_t i = 0; i != store.num_rows(); ++i) {
+            L(args);
+            res.emplace_back(tup.is_null(0) ? std::nullopt : std::optional<int64_t>(tup.get(0).as_i()),
+                             tup.get(1).as_i());
+            tup.clear();
+        }
+        return res;
+    };
+    using rows_t = std::vector<std::pair<std::optional<int64_t>, int64_t>>;
+
+    SECTION("table without sort key is not modified")
+    {
+        append({ {3, 0}, {1, 1}, {2, 2} });
+        CHECK(merge_appended_rows(table, 0) == 3);
+        CHECK(rows() == rows_t{ {3, 0}, {1, 1}, {2, 2} });
+    }
+
+    SECTION("ascending sort key")
+    {
+        table.add_sort_key(C.pool("k"), true);
+
+        /* bulk load */
+        append({ {3, 0}, {1, 1}, {2, 2} });
+        CHECK(merge_appended_rows(table, 0) == 0);
+        CHECK(rows() == rows_t{ {1, 1}, {2, 2}, {3, 0} });
+
+        /* appending in order does not write any row back */
+        append({ {3, 3}, {5, 4} });
+        CHECK(merge_appended_rows(table, 3) == 5);
+        CHECK(rows() == rows_t{ {1, 1}, {2, 2}, {3, 0}, {3, 3}, {5, 4} });
+
+        /* unsorted run after the sorted rows */
+        append({ {7, 5}, {6, 6} });
+        CHECK(merge_appended_rows(table, 5) == 5);
+        CHECK(rows() == rows_t{ {1, 1}, {2, 2}, {3, 0}, {3, 3}, {5, 4}, {6, 6}, {7, 5} });
+
+        /* overlapping run is merged, equal keys keep sorted rows first */
+        append({ {3, 7}, {0, 8}, {std::nullopt, 9} });
+        CHECK(merge_appended_rows(table, 7) == 0);
+        CHECK(rows() == rows_t{ {std::nullopt, 9}, {0, 8}, {1, 1}, {2, 2}, {3, 0}, {3, 3}, {3, 7}, {5, 4}, {6, 6},
+                                {7, 5} });
+    }
+
+    SECTION("snapshots are not affected")
+    {
+        table.add_sort_key(C.pool("k"), true);
+        append({ {1, 0}, {3, 1} });
+        REQUIRE(merge_appended_rows(table, 0) == 2);
+
+        auto snapshot = store.snapshot();
+        REQUIRE(snapshot->num_rows() == 2);
+        append({ {2, 2} });
+        REQUIRE(merge_appended_rows(table, 2) == 1);
+        CHECK(rows() == rows_t{ {1, 0}, {2, 2}, {3, 1} });
+
+        /* The snapshot still contains the rows at the time it was taken. */
+        auto L = Interpreter::compile_load(S, snapshot->addr(), table.layout(), S, 0);
+        Tuple tup(S);
+        Tuple *args[] = { &tup };
+        L(args);
+        CHECK(tup.get(0).as_i() == 1);
+        L(args);
+        CHECK(tup.get(0).as_i() == 3);
+    }
+
+    SECTION("descending and compound sort key")
+    {
+        table.add_sort_key(C.pool("k"), false);
+        table.add_sort_key(C.pool("v"), true);
+
+        append({ {1, 2}, {2, 0}, {1, 1} });
+        CHECK(merge_appended_rows(table, 0) == 0);
+        CHECK(rows() == rows_t{ {2, 0}, {1, 1}, {1, 2} });
+
+        append({ {1, 0}, {std::nullopt, 5} });
+        CHECK(merge_appended_rows(table, 3) == 1);
+        CHECK(rows() == rows_t{ {2, 0}, {1, 0}, {1, 1}, {1, 2}, {std::nullopt, 5} });
+    }
+
+    SECTION("unsorted runs are merged at the threshold")
+    {
+        table.add_sort_key(C.pool("k"), true);
+
+        /* bulk load into the empty table is sorted right away */
+        append({ {9, 0}, {1, 1}, {5, 2}, {3, 3}, {7, 4}, {2, 5}, {8, 6}, {4, 7} });
+        CHECK(restore_sort_order(table, 0) == 0);
+        CHECK(store.num_sorted_rows() == 8);
+
+        /* appending in order extends the sorted prefix */
+        append({ {10, 8}, {11, 9} });
+        CHECK(restore_sort_order(table, 8) == 10);
+        CHECK(store.num_sorted_rows() == 10);
+
+        /* an out-of-order row is kept as unsorted run below the threshold */
+        append({ {0, 10} });
+        CHECK(restore_sort_order(table, 10) == 11);
+        CHECK(store.num_sorted_rows() == 10);
+        CHECK(rows() == rows_t{ {1, 1}, {2, 5}, {3, 3}, {4, 7}, {5, 2}, {7, 4}, {8, 6}, {9, 0}, {10, 8}, {11, 9},
+                                {0, 10} });
+
+        /* in-order rows after an unsorted run do not extend the sorted prefix; two unsorted rows reach the threshold */
+        static_assert(2 * MERGE_RATIO >= 10 and MERGE_RATIO < 10);
+        append({ {12, 11} });
+        CHECK(restore_sort_order(table, 11) == 0);
+        CHECK(store.num_sorted_rows() == 12);
+        CHECK(rows() == rows_t{ {0, 10}, {1, 1}, {2, 5}, {3, 3}, {4, 7}, {5, 2}, {7, 4}, {8, 6}, {9, 0}, {10, 8},
+                                {11, 9}, {12, 11} });
+    }
+}
+
+TEST_CASE("merge_appended_rows/PAX", "[core][storage][clustering]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("$test_db"));
+    auto &table = DB.add_table(C.pool("T"));
+    table.push_back(C.pool("k"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.push_back(C.pool("v"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.store(C.create_store(C.pool("PaxStore"), table));
+    table.layout(PAXLayoutFactory(PAXLayoutFactory::NTuples, 4));
+    table.add_sort_key(C.pool("k"), true);
+    auto &store = table.store();
+    const Schema S = table.schema();
+
+    /* Appends rows with the given keys, numbering the values consecutively. */
+    auto append = [&](std::vector<int64_t> keys) {
+        auto W = Interpreter::compile_store(S, store.memory().addr(), table.layout(), S, store.num_rows());
+        Tuple tup(S);
+        Tuple *args[] = { &tup };
+        for (auto k : keys) {
+            tup.set(0, k);
+            tup.set(1, int64_t(store.num_rows()));
+            store.append();
+            W(args);
+        }
+    };
+    /* Returns the keys of all rows of the store. */
+    auto keys = [&]() {
+        std::vector<int64_t> res;
+        auto L = Interpreter::compile_load(S, store.memory().addr(), table.layout(), S, 0);
+        Tuple tup(S);
+        Tuple *args[] = { &tup };
+        for (std::size_t i = 0; i != store.num_rows(); ++i) {
+            L(args);
+            res.push_back(tup.get(0).as_i());
+        }
+        return res;
+    };
+
+    /* Blocks of 4 rows each, such that finding the first row to write back seeks across blocks. */
+    append({ 0, 2, 4, 6, 8, 10, 12, 14, 16, 18 });
+    REQUIRE(merge_appended_rows(table, 0) == 10);
+
+    append({ 9 }); // within the second block
+    CHECK(merge_appended_rows(table, 10) == 5);
+    CHECK(keys() == std::vector<int64_t>{ 0, 2, 4, 6, 8, 9, 10, 12, 14, 16, 18 });
+
+    append({ 1 }); // within the first block
+    CHECK(merge_appended_rows(table, 11) == 1);
+    CHECK(keys() == std::vector<int64_t>{ 0, 1, 2, 4, 6, 8, 9, 10, 12, 14, 16, 18 });
+
+    append({ 11 }); // at the first row of the third block
+    CHECK(merge_appended_rows(table, 12) == 8);
+    CHECK(keys() == std::vector<int64_t>{ 0, 1, 2, 4, 6, 8, 9, 10, 11, 12, 14, 16, 18 });
+
+    append({ 17, 3 }); // unsorted run spanning several blocks
+    CHECK(merge_appended_rows(table, 13) == 3);
+    CHECK(keys() == std::vector<int64_t>{ 0, 1, 2, 3, 4, 6, 8, 9, 10, 11, 12, 14, 16, 17, 18 });
+}
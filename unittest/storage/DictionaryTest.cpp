@@ -0,0 +1,133 @@
+#include "catch2/catch.hpp"
+
+#include "backend/Interpreter.hpp"
+#include "storage/Dictionary.hpp"
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/storage/DataLayoutFactory.hpp>
+#include <mutable/storage/Store.hpp>
+#include <optional>
+#include <vector>
+
+
+using namespace m;
+using namespace m::storage;
+
+
+TEST_CASE("Dictionary", "[core][storage][dictionary]")
+{
+    Dictionary dict({ "pear", "apple", "banana", "apple", "" });
+
+    SECTION("codes are dense and order-preserving")
+    {
+        REQUIRE(dict.size() == 4);
+        CHECK(dict.encode("") == 0U);
+        CHECK(dict.encode("apple") == 1U);
+        CHECK(dict.encode("banana") == 2U);
+        CHECK(dict.encode("pear") == 3U);
+        CHECK(dict.encode("cherry") == std::nullopt);
+        CHECK(dict.encode("appl") == std::nullopt);
+
+        for (Dictionary::code_type code = 0; code != dict.size(); ++code)
+            CHECK(dict.encode(dict.decode(code)) == code);
+    }
+
+    SECTION("bounds")
+    {
+        CHECK(dict.lower_bound("banana") == 2);
+        CHECK(dict.upper_bound("banana") == 3);
+        CHECK(dict.lower_bound("cherry") == 3);
+        CHECK(dict.upper_bound("cherry") == 3);
+        CHECK(dict.lower_bound("zucchini") == 4);
+        CHECK(dict.upper_bound("") == 1);
+    }
+
+    SECTION("extend")
+    {
+        auto shift = dict.extend({ "cherry", "zucchini", "apple", "cherry", "aaa" });
+        REQUIRE(dict.size() == 7);
+        CHECK(shift == std::vector<Dictionary::code_type>{ 0, 1, 1, 2, 3 });
+        CHECK(dict.encode("") == 0U);
+        CHECK(dict.encode("aaa") == 1U);
+        CHECK(dict.encode("apple") == 2U);
+        CHECK(dict.encode("banana") == 3U);
+        CHECK(dict.encode("cherry") == 4U);
+        CHECK(dict.encode("pear") == 5U);
+        CHECK(dict.encode("zucchini") == 6U);
+    }
+
+    SECTION("characters compare as unsigned")
+    {
+        Dictionary D({ "\xe4", "z" });
+        CHECK(D.encode("z") == 0U);
+        CHECK(D.encode("\xe4") == 1U);
+    }
+}
+
+TEST_CASE("Dictionary/maintenance", "[core][storage][dictionary]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("$test_db"));
+    auto &table = DB.add_table(C.pool("T"));
+    table.push_back(C.pool("i"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.push_back(C.pool("s"), Type::Get_Char(Type::TY_Vector, 8));
+    table.store(C.create_store(C.pool("RowStore"), table));
+    table.layout(RowLayoutFactory());
+    auto &store = table.store();
+    auto &attr = table.at(C.pool("s"));
+    const Schema S = table.schema();
+
+    /* Appends rows with value `s`, where `nullptr` denotes NULL. */
+    auto append = [&](std::initializer_list<const char*> values) {
+        auto W = Interpreter::compile_store(S, store.memory().addr(), table.layout(), S, store.num_rows());
+        Tuple tup(S);
+        Tuple *args[] = { &tup };
+        for (auto value : values) {
+            store.append();
+            tup.set(0, int64_t(store.num_rows()));
+            if (value)
+                tup.set(1, value);
+            else
+                tup.null(1);
+            W(args);
+        }
+    };
+
+    append({ "red", "green", nullptr, "red", "blue" });
+    REQUIRE(store.dictionary(attr.id) == nullptr);
+
+    /* Without `--string-dictionaries`, no dictionaries are built. */
+    CHECK_FALSE(maintain_dictionaries(table, 0));
+    CHECK(store.dictionary(attr.id) == nullptr);
+
+    store.dictionary(attr.id, Dictionary::Build(table, attr));
+    const Dictionary *dict = store.dictionary(attr.id);
+    REQUIRE(dict);
+    REQUIRE(dict->size() == 3);
+    CHECK(dict->encode("blue") == 0U);
+    CHECK(dict->encode("green") == 1U);
+    CHECK(dict->encode("red") == 2U);
+
+    SECTION("appending contained values keeps the dictionary")
+    {
+        append({ "green", nullptr });
+        CHECK_FALSE(maintain_dictionaries(table, 5));
+        CHECK(store.dictionary(attr.id) == dict);
+    }
+
+    SECTION("appending a new value extends the dictionary")
+    {
+        append({ "blue", "orange" });
+        CHECK(maintain_dictionaries(table, 5));
+        CHECK(store.dictionary(attr.id) == dict);
+        REQUIRE(dict->size() == 4);
+        CHECK(dict->encode("orange") == 2U);
+        CHECK(dict->encode("red") == 3U);
+    }
+
+    SECTION("remove dictionary")
+    {
+        store.dictionary(attr.id, nullptr);
+        CHECK(store.dictionary(attr.id) == nullptr);
+    }
+}
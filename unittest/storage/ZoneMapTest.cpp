@@ -0,0 +1,239 @@
+#include "catch2/catch.hpp"
+
+#include "backend/Interpreter.hpp"
+#include "storage/ZoneMap.hpp"
+#include <mutable/catalog/Catalog.hpp>
+#include <mutable/mutable.hpp>
+#include <mutable/storage/DataLayoutFactory.hpp>
+#include <mutable/storage/Store.hpp>
+#include <sstream>
+
+
+using namespace m;
+using namespace m::ast;
+using namespace m::storage;
+
+
+namespace {
+
+/** Parses the `SELECT` statement \p query and returns the `CNF` of its `WHERE` clause. */
+cnf::CNF get_filter(Diagnostic &diag, const std::string &query, std::vector<std::unique_ptr<Stmt>> &stmts)
+{
+    auto &stmt = stmts.emplace_back(statement_from_string(diag, query));
+    return cnf::to_CNF(*as<WhereClause>(as<SelectStmt>(*stmt).where.get())->where);
+}
+
+}
+
+TEST_CASE("ZoneMap", "[core][storage][zonemap]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+
+    auto &DB = C.add_database(C.pool("$test_db"));
+    C.set_database_in_use(DB);
+    auto &table = DB.add_table(C.pool("T"));
+    table.push_back(C.pool("x"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.push_back(C.pool("d"), Type::Get_Double(Type::TY_Vector));
+    table.store(C.create_store(C.pool("PaxStore"), table));
+    table.layout(PAXLayoutFactory(PAXLayoutFactory::NTuples, 16));
+    auto &store = table.store();
+    auto &zone_map = store.zone_map();
+    REQUIRE(zone_map.zone_size() == 16);
+
+    /* Insert 64 rows, i.e. 4 zones, with ascending `x` and `d` being NULL in the last zone. */
+    const Schema S = table.schema();
+    auto W = Interpreter::compile_store(S, store.memory().addr(), table.layout(), S, 0);
+    Tuple tup(S);
+    Tuple *args[] = { &tup };
+    auto insert = [&](int64_t x) {
+        store.append();
+        tup.set(0, x);
+        if (x < 48)
+            tup.set(1, double(x) / 2);
+        else
+            tup.null(1);
+        W(args);
+    };
+    for (int64_t x = 0; x != 64; ++x)
+        insert(x);
+
+    std::vector<std::unique_ptr<Stmt>> stmts; // keep the ASTs of the filters alive
+    using ranges = std::vector<ZoneMap::range_type>;
+    auto qualifying = [&](const std::string &query) {
+        return zone_map.qualifying_ranges(get_filter(diag, query, stmts));
+    };
+
+    SECTION("comparison with constant")
+    {
+        CHECK(qualifying("SELECT * FROM T WHERE x < 10;") == ranges{ {0, 16} });
+        CHECK(qualifying("SELECT * FROM T WHERE 10 > x;") == ranges{ {0, 16} });
+        CHECK(qualifying("SELECT * FROM T WHERE x >= 20 AND x < 40;") == ranges{ {16, 48} });
+        CHECK(qualifying("SELECT * FROM T WHERE x = 100;") == ranges{ });
+        CHECK(qualifying("SELECT * FROM T WHERE x > -1;") == ranges{ {0, 64} });
+        CHECK(qualifying("SELECT * FROM T WHERE x != 5;") == ranges{ {0, 64} });
+    }
+
+    SECTION("disjunction and negation")
+    {
+        CHECK(qualifying("SELECT * FROM T WHERE x < 5 OR x > 60;") == ranges{ {0, 16}, {48, 64} });
+        CHECK(qualifying("SELECT * FROM T WHERE NOT (x < 50);") == ranges{ {48, 64} });
+    }
+
+    SECTION("NULL values")
+    {
+        CHECK(qualifying("SELECT * FROM T WHERE d > 10.0;") == ranges{ {16, 48} });
+        CHECK(qualifying("SELECT * FROM T WHERE d < 100;") == ranges{ {0, 48} });
+        CHECK(qualifying("SELECT * FROM T WHERE ISNULL(d);") == ranges{ {48, 64} });
+        CHECK(qualifying("SELECT * FROM T WHERE NOT ISNULL(d);") == ranges{ {0, 48} });
+    }
+
+    SECTION("unsupported predicates are not used to skip")
+    {
+        CHECK(qualifying("SELECT * FROM T WHERE x + 1 < 10;") == ranges{ {0, 64} });
+        CHECK(qualifying("SELECT * FROM T WHERE x < d;") == ranges{ {0, 64} });
+    }
+
+    SECTION("appended rows")
+    {
+        CHECK(qualifying("SELECT * FROM T WHERE x > 62;") == ranges{ {48, 64} });
+        for (int64_t x = 64; x != 72; ++x)
+            insert(x);
+        CHECK(qualifying("SELECT * FROM T WHERE x > 62;") == ranges{ {48, 72} });
+        CHECK(qualifying("SELECT * FROM T WHERE x > 70;") == ranges{ {64, 72} });
+    }
+
+    SECTION("dropped rows")
+    {
+        CHECK(qualifying("SELECT * FROM T WHERE x > 40;") == ranges{ {32, 64} });
+        for (unsigned i = 0; i != 20; ++i)
+            store.drop();
+        CHECK(qualifying("SELECT * FROM T WHERE x > 40;") == ranges{ {32, 44} });
+    }
+
+    SECTION("invalidate")
+    {
+        zone_map.invalidate();
+        CHECK(qualifying("SELECT * FROM T WHERE x < 10;") == ranges{ {0, 16} });
+    }
+}
+
+TEST_CASE("ZoneMap/row layout", "[core][storage][zonemap]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+
+    auto &DB = C.add_database(C.pool("$test_db"));
+    C.set_database_in_use(DB);
+    auto &table = DB.add_table(C.pool("T"));
+    table.push_back(C.pool("x"), Type::Get_Integer(Type::TY_Vector, 4));
+    table.store(C.create_store(C.pool("RowStore"), table));
+    table.layout(RowLayoutFactory());
+    auto &store = table.store();
+    auto &zone_map = store.zone_map();
+    REQUIRE(zone_map.zone_size() == 1024); // default of `--zone-size`
+
+    /* Insert 2500 rows, i.e. 3 zones, with descending `x`. */
+    const Schema S = table.schema();
+    auto W = Interpreter::compile_store(S, store.memory().addr(), table.layout(), S, 0);
+    Tuple tup(S);
+    Tuple *args[] = { &tup };
+    for (int64_t x = 2500; x != 0; --x) {
+        store.append();
+        tup.set(0, x);
+        W(args);
+    }
+    zone_map.rows_appended();
+
+    std::vector<std::unique_ptr<Stmt>> stmts; // keep the ASTs of the filters alive
+    using ranges = std::vector<ZoneMap::range_type>;
+    auto qualifying = [&](const std::string &query) {
+        return zone_map.qualifying_ranges(get_filter(diag, query, stmts));
+    };
+
+    CHECK(qualifying("SELECT * FROM T WHERE x <= 400;") == ranges{ {2048, 2500} });
+    CHECK(qualifying("SELECT * FROM T WHERE x > 1400;") == ranges{ {0, 2048} });
+    CHECK(qualifying("SELECT * FROM T WHERE x = 1477;") == ranges{ {0, 1024} });
+    CHECK(qualifying("SELECT * FROM T WHERE x = 1476;") == ranges{ {1024, 2048} });
+}
+
+TEST_CASE("ZoneMap/strings", "[core][storage][zonemap]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    std::ostringstream out, err;
+    Diagnostic diag(false, out, err);
+
+    auto &DB = C.add_database(C.pool("$test_db"));
+    C.set_database_in_use(DB);
+    auto &table = DB.add_table(C.pool("T"));
+    table.push_back(C.pool("s"), Type::Get_Char(Type::TY_Vector, 4));
+    table.store(C.create_store(C.pool("PaxStore"), table));
+    table.layout(PAXLayoutFactory(PAXLayoutFactory::NTuples, 4));
+    auto &store = table.store();
+    auto &zone_map = store.zone_map();
+
+    /* Appends rows with the given values, where `nullptr` denotes NULL. */
+    const Schema S = table.schema();
+    auto append = [&](std::initializer_list<const char*> values) {
+        auto W = Interpreter::compile_store(S, store.memory().addr(), table.layout(), S, store.num_rows());
+        Tuple tup(S);
+        Tuple *args[] = { &tup };
+        for (const char *value : values) {
+            store.append();
+            if (value)
+                tup.set(0, value);
+            else
+                tup.null(0);
+            W(args);
+        }
+    };
+
+    /* Insert 3 zones of 4 rows each, with values "a" to "d", "c" to "f", and "x" to "z" and NULL. */
+    append({ "a", "b", "c", "d", "c", "d", "e", "f", "x", "y", "z", nullptr });
+
+    std::vector<std::unique_ptr<Stmt>> stmts; // keep the ASTs of the filters alive
+    using ranges = std::vector<ZoneMap::range_type>;
+    auto qualifying = [&](const std::string &query) {
+        return zone_map.qualifying_ranges(get_filter(diag, query, stmts));
+    };
+
+    SECTION("equality")
+    {
+        CHECK(qualifying("SELECT * FROM T WHERE s = \"y\";") == ranges{ {8, 12} });
+        CHECK(qualifying("SELECT * FROM T WHERE s = \"c\";") == ranges{ {0, 8} });
+        CHECK(qualifying("SELECT * FROM T WHERE s = \"e\";") == ranges{ {4, 8} });
+        CHECK(qualifying("SELECT * FROM T WHERE s = \"0\";") == ranges{ });
+        CHECK(qualifying("SELECT * FROM T WHERE s = \"cc\";") == ranges{ {0, 8} });
+        CHECK(qualifying("SELECT * FROM T WHERE s != \"m\";") == ranges{ {0, 12} });
+    }
+
+    SECTION("range")
+    {
+        CHECK(qualifying("SELECT * FROM T WHERE s < \"c\";") == ranges{ {0, 4} });
+        CHECK(qualifying("SELECT * FROM T WHERE s <= \"c\";") == ranges{ {0, 8} });
+        CHECK(qualifying("SELECT * FROM T WHERE s > \"d\";") == ranges{ {4, 12} });
+        CHECK(qualifying("SELECT * FROM T WHERE \"x\" <= s;") == ranges{ {8, 12} });
+        CHECK(qualifying("SELECT * FROM T WHERE s > \"f\";") == ranges{ {8, 12} });
+        CHECK(qualifying("SELECT * FROM T WHERE s >= \"g\" AND s < \"x\";") == ranges{ });
+    }
+
+    SECTION("NULL values")
+    {
+        CHECK(qualifying("SELECT * FROM T WHERE ISNULL(s);") == ranges{ {8, 12} });
+        CHECK(qualifying("SELECT * FROM T WHERE NOT ISNULL(s);") == ranges{ {0, 12} });
+    }
+
+    SECTION("appended rows")
+    {
+        REQUIRE(qualifying("SELECT * FROM T WHERE s = \"m\";") == ranges{ }); // summarize all zones
+        append({ nullptr, "mm", "m" });
+        CHECK(qualifying("SELECT * FROM T WHERE s = \"m\";") == ranges{ {12, 15} });
+        CHECK(qualifying("SELECT * FROM T WHERE s >= \"n\";") == ranges{ {8, 12} });
+        CHECK(qualifying("SELECT * FROM T WHERE s < \"b\";") == ranges{ {0, 4} });
+    }
+}
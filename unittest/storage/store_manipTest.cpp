@@ -422,3 +422,98 @@ TEST_CASE("Store Data Manipulation", "[core][storage][store_manip]")
         }
     }
 }
+
+TEST_CASE("Schema Generation", "[core][storage][store_manip]")
+{
+    Catalog::Clear();
+    auto &C = Catalog::Get();
+    auto &DB = C.add_database(C.pool("$test_db"));
+
+    table_spec region { .name = "region", .num_rows = 5, .num_attrs = 1, .fk_zipf = 2 };
+    table_spec customer { .name = "customer", .num_rows = 100, .num_attrs = 2, .dimensions = { region } };
+    table_spec fact {
+        .name = "fact",
+        .num_rows = 200'003,
+        .num_attrs = 3,
+        .num_distinct_values = NUM_DISTINCT_VALUES,
+        .zipf = 1.5,
+        .correlation = 1,
+        .null_rate = .25,
+        .dimensions = { customer },
+    };
+
+    auto &table = generate_schema(DB, fact, 42, 4);
+    REQUIRE(DB.has_table(C.pool("region")));
+    REQUIRE(DB.has_table(C.pool("customer")));
+    REQUIRE(table.store().num_rows() == fact.num_rows);
+
+    auto &fk = table.at(C.pool("customer_id"));
+    REQUIRE(fk.reference == &DB.get_table(C.pool("customer")).at(C.pool("id")));
+
+    auto column = [&](const Table &T, const char *name) {
+        uint8_t *mem_ptr = reinterpret_cast<uint8_t*>(T.store().memory().addr());
+        return reinterpret_cast<const int32_t*>(
+            mem_ptr + get_column_offset_in_bytes(T.layout(), T.at(C.pool(name)).id)
+        );
+    };
+
+    SECTION("keys")
+    {
+        auto id = column(table, "id");
+        auto fks = column(table, "customer_id");
+        for (std::size_t i = 0; i != fact.num_rows; ++i) {
+            REQUIRE(id[i] == int32_t(i));
+            REQUIRE(fks[i] >= 0);
+            REQUIRE(fks[i] < int32_t(customer.num_rows));
+        }
+
+        /* Foreign keys referencing `region` are skewed. */
+        auto &cust = DB.get_table(C.pool("customer"));
+        auto region_fks = column(cust, "region_id");
+        std::vector<std::size_t> counts(region.num_rows);
+        for (std::size_t i = 0; i != customer.num_rows; ++i)
+            ++counts.at(region_fks[i]);
+        CHECK(counts[0] == *std::max_element(counts.begin(), counts.end()));
+    }
+
+    SECTION("attributes")
+    {
+        const uint8_t *null_bitmap = reinterpret_cast<uint8_t*>(table.store().memory().addr()) +
+                                     get_column_offset_in_bytes(table.layout(), table.num_attrs());
+        auto is_null = [&](std::size_t row, const char *name) {
+            const auto bit = row * table.num_attrs() + table.at(C.pool(name)).id;
+            return bool(null_bitmap[bit / 8] & (1U << (bit % 8)));
+        };
+
+        auto a0 = column(table, "a0");
+        auto a1 = column(table, "a1");
+        std::size_t num_nulls = 0;
+        std::vector<std::size_t> counts(NUM_DISTINCT_VALUES);
+        for (std::size_t i = 0; i != fact.num_rows; ++i) {
+            REQUIRE(not is_null(i, "id"));
+            REQUIRE(not is_null(i, "customer_id"));
+            if (is_null(i, "a0")) {
+                ++num_nulls;
+                continue;
+            }
+            REQUIRE(a0[i] >= 0);
+            REQUIRE(a0[i] < NUM_DISTINCT_VALUES);
+            ++counts[a0[i]];
+            if (not is_null(i, "a1"))
+                REQUIRE(a1[i] == a0[i]); // fully correlated
+        }
+        CHECK(num_nulls > fact.num_rows / 5);
+        CHECK(num_nulls < fact.num_rows * 3 / 10);
+        CHECK(std::is_sorted(counts.rbegin(), counts.rend())); // Zipfian, i.e. 0 is the most frequent value
+        CHECK(counts[0] > 2 * counts[1]);
+    }
+
+    SECTION("deterministic")
+    {
+        auto &DB2 = C.add_database(C.pool("$test_db2"));
+        auto &table2 = generate_schema(DB2, fact, 42, 1);
+        auto a2 = column(table, "a2");
+        auto a2_2 = column(table2, "a2");
+        REQUIRE(std::equal(a2, a2 + fact.num_rows, a2_2));
+    }
+}
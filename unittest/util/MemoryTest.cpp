@@ -115,4 +115,55 @@ TEST_CASE("memory::LinearAllocator", "[core][util][memory]")
             }
         }
     }
+
+    SECTION("map copy-on-write to address space")
+    {
+        auto mem = A.allocate(3 * PAGE_SIZE); // 3 pages
+        auto p_mem = mem.as<unsigned*>();
+        for (std::size_t i = 0; i != 3 * INTS_PER_PAGE; ++i)
+            p_mem[i] = i;
+
+        AddressSpace vm(3 * PAGE_SIZE); // 3 pages
+        mem.map_private(3 * PAGE_SIZE, 0, vm, 0);
+        auto p_vm = vm.as<unsigned*>();
+        REQUIRE(p_vm[0] == 0);
+        REQUIRE(p_vm[INTS_PER_PAGE] == INTS_PER_PAGE);
+        REQUIRE(p_vm[2 * INTS_PER_PAGE] == 2 * INTS_PER_PAGE);
+
+        /* Writes through the mapping are private. */
+        p_vm[0] = 42;
+        CHECK(p_mem[0] == 0);
+
+        /* Pages made private no longer reflect writes to the memory, other pages still do. */
+        make_private(vm.as<uint8_t*>() + PAGE_SIZE, PAGE_SIZE);
+        CHECK(p_vm[INTS_PER_PAGE] == INTS_PER_PAGE);
+        p_mem[1] = 13;
+        p_mem[INTS_PER_PAGE] = 13;
+        p_mem[2 * INTS_PER_PAGE] = 13;
+        CHECK(p_vm[1] == 1); // page 0 was copied by the write above
+        CHECK(p_vm[INTS_PER_PAGE] == INTS_PER_PAGE);
+        CHECK(p_vm[2 * INTS_PER_PAGE] == 13); // page 2 is still shared
+    }
+}
+
+TEST_CASE("memory::resident_bytes", "[core][util][memory]")
+{
+    const std::size_t PAGE_SIZE = get_pagesize();
+
+    LinearAllocator A;
+    auto mem = A.allocate(4 * PAGE_SIZE);
+    CHECK(resident_bytes(mem.addr(), mem.size()) == 0);
+
+    /* Touch the first and the third page. */
+    mem.as<char*>()[0] = 42;
+    mem.as<char*>()[2 * PAGE_SIZE] = 42;
+    CHECK(resident_bytes(mem.addr(), mem.size()) == 2 * PAGE_SIZE);
+    CHECK(resident_bytes(mem.addr(), PAGE_SIZE) == PAGE_SIZE);
+}
+
+TEST_CASE("memory::usage_t", "[core][util][memory]")
+{
+    auto usage = usage_t::Get();
+    CHECK(usage.peak_resident != 0);
+    CHECK(usage.resident <= usage.peak_resident);
 }
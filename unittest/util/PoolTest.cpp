@@ -2,8 +2,10 @@
 
 #include <functional>
 #include <mutable/util/Pool.hpp>
+#include <string>
 #include <string_view>
 #include <thread>
+#include <vector>
 
 
 using namespace m;
@@ -358,3 +360,42 @@ TEST_CASE("Thread-safe concurrent Pool", "[core][util][pool]")
     validate(values_t2, refs_t2);
     validate(values_t3, refs_t3);
 }
+
+TEST_CASE("Thread-safe concurrent StringPool", "[core][util][pool]")
+{
+    ThreadSafeStringPool pool;
+
+    constexpr unsigned NUM_THREADS = 4;
+    constexpr unsigned NUM_STRINGS = 5000;
+    std::vector<std::string> strings;
+    for (unsigned i = 0; i != NUM_STRINGS; ++i)
+        strings.emplace_back("str" + std::to_string(i));
+
+    /* Every thread interns all strings, in a different order, such that the pool grows concurrently. */
+    std::vector<std::vector<const char*>> interned(NUM_THREADS, std::vector<const char*>(NUM_STRINGS));
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t != NUM_THREADS; ++t) {
+        threads.emplace_back([&, t]() {
+            for (unsigned n = 0; n != NUM_STRINGS; ++n) {
+                const unsigned i = (n * 7919 + t * 1237) % NUM_STRINGS;
+                interned[t][i] = *pool(std::string_view(strings[i]));
+            }
+        });
+    }
+    for (auto &t : threads)
+        t.join();
+
+    CHECK(pool.size() == NUM_STRINGS);
+    for (unsigned i = 0; i != NUM_STRINGS; ++i) {
+        CHECK(interned[0][i] == strings[i]);
+        for (unsigned t = 1; t != NUM_THREADS; ++t)
+            CHECK(interned[t][i] == interned[0][i]); // referential equality
+        CHECK(*pool(strings[i].c_str()) == interned[0][i]);
+    }
+    CHECK(pool.size() == NUM_STRINGS);
+
+    std::size_t num_entries = 0;
+    for (auto it = pool.cbegin(); it != pool.cend(); ++it)
+        ++num_entries;
+    CHECK(num_entries == NUM_STRINGS);
+}
@@ -142,6 +142,86 @@ TEST_CASE("spn/learning","[core][util][spn]")
         CHECK(spn.height() == 2);
         CHECK(spn.degree() == 2);
         CHECK(spn.breadth() == 4);
+
+        /* Expect the same SPN when learning in parallel */
+        auto spn_parallel = SpnWrapper::learn_spn_table(C.pool("db"), C.pool("table"), {}, 0, 4);
+        CHECK(spn_parallel.height() == 2);
+        CHECK(spn_parallel.degree() == 2);
+        CHECK(spn_parallel.breadth() == 4);
+    }
+
+    SECTION("sample")
+    {
+        std::ostringstream oss;
+        oss << "CREATE TABLE table ("
+            << "id INT(4) PRIMARY KEY,"
+            << "column_1 INT(4),"
+            << "column_2 INT(4)"
+            << ");";
+        auto stmt = statement_from_string(diag, oss.str());
+        execute_statement(diag, *stmt);
+
+        for (int i = 0; i < 100; i++) {
+            std::ostringstream oss_insert;
+            oss_insert << "INSERT INTO table VALUES (" << i << ", 1, " << i << ");";
+            auto insert_stmt = statement_from_string(diag, oss_insert.str());
+            execute_statement(diag, *insert_stmt);
+        }
+
+        auto spn = SpnWrapper::learn_spn_table(C.pool("db"), C.pool("table"), {}, 10);
+
+        /* Expect the SPN to extrapolate the sample to the entire table */
+        CHECK(spn.num_rows() == 100);
+        Spn::Filter filter;
+        filter.emplace(0, std::make_pair(Spn::EQUAL, 1.f));
+        CHECK(spn.likelihood(filter) >= 0.999f);
+    }
+
+    SECTION("insert rows")
+    {
+        std::ostringstream oss;
+        oss << "CREATE TABLE table ("
+            << "id INT(4) PRIMARY KEY,"
+            << "column_1 INT(4),"
+            << "column_2 INT(4)"
+            << ");";
+        auto stmt = statement_from_string(diag, oss.str());
+        execute_statement(diag, *stmt);
+        auto &table = db.get_table(C.pool("table"));
+
+        auto insert = [&](int id, int column_1, int column_2) {
+            std::ostringstream oss_insert;
+            oss_insert << "INSERT INTO table VALUES (" << id << ", " << column_1 << ", " << column_2 << ");";
+            auto insert_stmt = statement_from_string(diag, oss_insert.str());
+            execute_statement(diag, *insert_stmt);
+        };
+        for (int i = 0; i < 10; i++) {
+            if (i < 5) insert(i, (i + 1) * 100, 0);
+            else       insert(i, (i + 1) * 1000, 1);
+        }
+
+        auto spn = SpnWrapper::learn_spn_table(C.pool("db"), C.pool("table"));
+        Spn::Filter filter;
+        filter.emplace(1, std::make_pair(Spn::EQUAL, 1.f));
+        REQUIRE(spn.likelihood(filter) == Approx(.5f));
+
+        /* rows resembling the second cluster are routed to it */
+        for (int i = 10; i < 20; i++) insert(i, (i + 1) * 1000, 1);
+        spn.insert_rows(table, 10);
+        CHECK(spn.num_rows() == 20);
+        CHECK(spn.likelihood(filter) == Approx(.75f));
+        CHECK_FALSE(spn.has_drifted());
+
+        /* many rows far from both clusters indicate drift */
+        for (int i = 20; i < 60; i++) insert(i, 5000, i % 2);
+        spn.insert_rows(table, 20);
+        CHECK(spn.num_rows() == 60);
+        CHECK(spn.has_drifted());
+
+        spn.relearn_drifted(C.pool("db"), C.pool("table"));
+        CHECK(spn.num_rows() == 60);
+        CHECK_FALSE(spn.has_drifted());
+        CHECK(spn.likelihood(filter) == Approx(35.f / 60).margin(.01f));
     }
 }
 
@@ -239,4 +319,23 @@ TEST_CASE("spn/inference","[core][util][spn]")
         SpnWrapper::AttrFilter filter;
         CHECK(spn_discrete.expectation(C.pool("column_1"), filter) == 1.f);
     }
+
+    SECTION("memoization")
+    {
+        /* repeated filters should yield the memoized likelihoods */
+        std::vector<SpnWrapper::Filter> filters(3);
+        filters[0].emplace(0, std::make_pair(Spn::EQUAL, 1.f));
+        filters[1].emplace(1, std::make_pair(Spn::LESS, 500.f));
+        filters[1].emplace(2, std::make_pair(Spn::GREATER_EQUAL, 20.f));
+        filters[2].emplace(2, std::make_pair(Spn::LESS_EQUAL, 49.f));
+
+        for (auto *spn : { &spn_discrete, &spn_continuous }) {
+            std::vector<float> likelihoods;
+            for (auto &filter : filters)
+                likelihoods.push_back(spn->likelihood(filter));
+            for (std::size_t i = 0; i != filters.size(); ++i)
+                CHECK(spn->likelihood(filters[i]) == likelihoods[i]);
+            CHECK(likelihoods[0] >= 0.999f);
+        }
+    }
 }
@@ -0,0 +1,101 @@
+#include "catch2/catch.hpp"
+
+#include <cstdint>
+#include <mutable/util/HeuristicSearch.hpp>
+#include <string>
+#include <vector>
+
+
+using namespace m;
+using namespace m::ai;
+
+
+namespace {
+
+/** A hash function with many collisions, to exercise probing. */
+struct bad_hash
+{
+    uint64_t operator()(uint64_t key) const { return key % 7; }
+};
+
+}
+
+TEST_CASE("StateMap/empty", "[core][util][heuristic_search]")
+{
+    StateMap<uint64_t, std::string> map;
+    CHECK(map.empty());
+    CHECK(map.size() == 0);
+    CHECK(map.begin() == map.end());
+    CHECK(map.find(42) == map.end());
+}
+
+TEST_CASE("StateMap/insert and find", "[core][util][heuristic_search]")
+{
+    StateMap<uint64_t, std::string> map;
+
+    auto it = map.find(42);
+    REQUIRE(it == map.end());
+    it = map.emplace_hint(it, 42, "fourty-two");
+    CHECK(it->first == 42);
+    CHECK(it->second == "fourty-two");
+    CHECK(map.size() == 1);
+
+    auto [it_dup, inserted_dup] = map.try_emplace(42, "duplicate");
+    CHECK_FALSE(inserted_dup);
+    CHECK(&*it_dup == &*it);
+    CHECK(it_dup->second == "fourty-two");
+
+    auto [it_new, inserted_new] = map.try_emplace(13, "thirteen");
+    CHECK(inserted_new);
+    CHECK(it_new->second == "thirteen");
+    CHECK(map.size() == 2);
+    CHECK(map.find(13)->second == "thirteen");
+    CHECK(map.find(42)->second == "fourty-two");
+}
+
+TEST_CASE("StateMap/entries do not move", "[core][util][heuristic_search]")
+{
+    constexpr uint64_t NUM_ENTRIES = 10000;
+    StateMap<uint64_t, uint64_t, bad_hash> map;
+
+    std::vector<const std::pair<const uint64_t, uint64_t>*> addresses;
+    for (uint64_t i = 0; i != NUM_ENTRIES; ++i) {
+        auto [it, inserted] = map.try_emplace(i, 2 * i);
+        REQUIRE(inserted);
+        addresses.push_back(&*it);
+    }
+    REQUIRE(map.size() == NUM_ENTRIES);
+
+    /* Lookup finds the same entries at their original addresses. */
+    for (uint64_t i = 0; i != NUM_ENTRIES; ++i) {
+        auto it = map.find(i);
+        REQUIRE(it != map.end());
+        CHECK(&*it == addresses[i]);
+        CHECK(it->second == 2 * i);
+    }
+    CHECK(map.find(NUM_ENTRIES) == map.end());
+
+    /* Iteration visits entries in order of insertion. */
+    uint64_t expected = 0;
+    for (auto &e : map) {
+        CHECK(&e == addresses[expected]);
+        ++expected;
+    }
+    CHECK(expected == NUM_ENTRIES);
+}
+
+TEST_CASE("StateMap/clear", "[core][util][heuristic_search]")
+{
+    StateMap<uint64_t, std::string> map;
+    for (uint64_t i = 0; i != 100; ++i)
+        map.try_emplace(i, std::to_string(i));
+    REQUIRE(map.size() == 100);
+
+    map.clear();
+    CHECK(map.empty());
+    CHECK(map.find(42) == map.end());
+
+    map.try_emplace(42, "fourty-two");
+    CHECK(map.size() == 1);
+    CHECK(map.find(42)->second == "fourty-two");
+}
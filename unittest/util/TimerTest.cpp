@@ -84,3 +84,33 @@ TEST_CASE("Timer", "[core][util][timer]")
         REQUIRE_THROWS_AS(T.get("m0"), m::out_of_range);
     }
 }
+
+TEST_CASE("Timer/perf_counters", "[core][util][timer]")
+{
+    Timer T;
+    REQUIRE_FALSE(T.perf_counters());
+
+    {
+        auto TP = T.create_timing("without counters");
+    }
+    REQUIRE_FALSE(T.get("without counters").has_counters());
+
+    T.perf_counters(true);
+    volatile uint64_t sum = 0;
+    {
+        auto TP = T.create_timing("with counters");
+        for (uint64_t i = 0; i != 100000; ++i)
+            sum = sum + i;
+    }
+    auto &M = T.get("with counters");
+    REQUIRE(M.has_counters());
+
+    auto counters = M.counters();
+    const auto &PC = PerfCounters::Get();
+    for (unsigned i = 0; i != PerfCounters::NUM_COUNTERS; ++i) {
+        if (not PC.available(PerfCounters::counter_t(i)))
+            CHECK(counters[i] == PerfCounters::UNAVAILABLE);
+    }
+    if (counters[PerfCounters::INSTRUCTIONS] != PerfCounters::UNAVAILABLE)
+        CHECK(counters[PerfCounters::INSTRUCTIONS] >= 100000);
+}
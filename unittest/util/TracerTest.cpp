@@ -0,0 +1,104 @@
+#include "catch2/catch.hpp"
+
+#include <mutable/util/Timer.hpp>
+#include <mutable/util/Tracer.hpp>
+#include <sstream>
+#include <thread>
+
+
+using namespace m;
+
+
+TEST_CASE("Tracer/disabled", "[core][util][tracer]")
+{
+    auto &T = Tracer::Get();
+    T.clear();
+    T.enabled(false);
+
+    {
+        auto span = T.span("ignored");
+    }
+    T.add("ignored", "test", Tracer::clock::now(), Tracer::clock::now());
+    CHECK(T.events().empty());
+}
+
+TEST_CASE("Tracer/spans", "[core][util][tracer]")
+{
+    auto &T = Tracer::Get();
+    T.clear();
+    T.enabled(true);
+
+    {
+        auto outer = T.span("outer", "test");
+        {
+            auto inner = T.span("inner", "test");
+            inner.end({ { "rows", 42 } });
+            inner.end(); // must not record the span twice
+        }
+    }
+    unsigned other_tid;
+    std::thread([&]() { other_tid = Tracer::thread_id(); auto span = T.span("other thread", "test"); }).join();
+    T.enabled(false);
+
+    auto events = T.events();
+    REQUIRE(events.size() == 3);
+    auto &inner = events[0];
+    auto &outer = events[1];
+    CHECK(inner.name == "inner");
+    CHECK(outer.name == "outer");
+    CHECK(inner.tid == Tracer::thread_id());
+    CHECK(outer.tid == Tracer::thread_id());
+    CHECK(outer.begin <= inner.begin);
+    CHECK(inner.end <= outer.end);
+    REQUIRE(inner.args.size() == 1);
+    CHECK(inner.args[0].first == "rows");
+    CHECK(inner.args[0].second == 42);
+    CHECK(events[2].tid == other_tid);
+    CHECK(other_tid != Tracer::thread_id());
+
+    T.clear();
+}
+
+TEST_CASE("Tracer/Timer", "[core][util][tracer]")
+{
+    auto &T = Tracer::Get();
+    T.clear();
+    T.enabled(true);
+
+    Timer timer;
+    {
+        auto TP = timer.create_timing("Compile");
+        M_TIME_EXPR(0, " ` Compile nested", timer);
+    }
+    T.enabled(false);
+
+    auto events = T.events();
+    REQUIRE(events.size() == 2);
+    CHECK(events[0].name == "Compile nested"); // tree decoration is stripped
+    CHECK(std::string(events[0].category) == "timer");
+    CHECK(events[1].name == "Compile");
+
+    T.clear();
+}
+
+TEST_CASE("Tracer/write_chrome_trace", "[core][util][tracer]")
+{
+    auto &T = Tracer::Get();
+    T.clear();
+    T.enabled(true);
+    T.name_thread("test \"thread\"");
+    const auto begin = Tracer::clock::now();
+    T.add("span", "test", begin, begin + std::chrono::microseconds(1500), { { "n", 7 } });
+    T.enabled(false);
+
+    std::ostringstream oss;
+    T.write_chrome_trace(oss);
+    const auto json = oss.str();
+    CHECK(json.starts_with("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    CHECK(json.find("\"name\":\"thread_name\",\"args\":{\"name\":\"test \\\"thread\\\"\"}") != std::string::npos);
+    CHECK(json.find("\"ph\":\"X\",\"pid\":1,\"tid\":" + std::to_string(Tracer::thread_id()) +
+                    ",\"cat\":\"test\",\"name\":\"span\"") != std::string::npos);
+    CHECK(json.find("\"dur\":1500.000,\"args\":{\"n\":7}}") != std::string::npos);
+
+    T.clear();
+}
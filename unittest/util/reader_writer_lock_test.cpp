@@ -284,3 +284,35 @@ TEST_CASE("reader_writer_mutex/upgrade_lock/4_readers_2_upgrades", "[core][util]
     CHECK(u2 == 1);
     CHECK(shared_value == 3);
 }
+
+TEST_CASE("reader_writer_mutex/contention", "[core][util]")
+{
+    reader_writer_mutex mutex;
+
+    mutex.lock_read();
+    mutex.lock_read();
+    mutex.unlock_read();
+    mutex.unlock_read();
+    {
+        auto C = mutex.contention();
+        CHECK(C.num_acquisitions == 2);
+        CHECK(C.num_contended == 0);
+        CHECK(C.wait_time == lock_contention::clock::duration(0));
+    }
+
+    /* A writer has to wait for the active reader. */
+    mutex.lock_read();
+    std::thread writer([&mutex]() { mutex.lock_write(); mutex.unlock_write(); });
+    std::this_thread::sleep_for(10ms);
+    mutex.unlock_read();
+    writer.join();
+    {
+        auto C = mutex.contention();
+        CHECK(C.num_acquisitions == 4);
+        CHECK(C.num_contended == 1);
+        CHECK(C.wait_time > lock_contention::clock::duration(0));
+    }
+
+    mutex.reset_contention();
+    CHECK(mutex.contention().num_acquisitions == 0);
+}